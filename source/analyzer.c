@@ -0,0 +1,774 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "analyzer.h"
+#include "parser.h"
+#include "processor.h"
+#include "section.h"
+
+#define PORT_NUMBER       8  // number of execution ports
+#define GPR_NUMBER        16 // number of general-purpose registers
+#define REGISTER_SLOTS    17 // number of registers tracked in dependency analysis (general-purpose registers and flags)
+
+typedef enum OperationEffect OperationEffect;
+typedef enum PortSet PortSet;
+typedef enum RegisterMask RegisterMask;
+typedef struct BasicBlock BasicBlock;
+typedef struct InstructionTiming InstructionTiming;
+typedef struct MicroarchitectureInfo MicroarchitectureInfo;
+typedef struct OperationEffectInfo OperationEffectInfo;
+
+// effect of operation on its operands
+enum OperationEffect
+{
+    EF_NONE       = 0x00, // no effect on operands
+    EF_READ_DEST  = 0x01, // the first operand is read
+    EF_WRITE_DEST = 0x02, // the first operand is written
+    EF_LOAD       = 0x04, // memory is loaded implicitly
+    EF_STORE      = 0x08, // memory is stored implicitly
+    EF_MOVE       = 0x10, // no uop is executed except for load and store if an operand is memory
+    EF_ADDRESS    = 0x20, // memory operand is not accessed but only its address is computed
+};
+
+// set of execution ports
+enum PortSet
+{
+    PORTS_NONE = 0x00, // executed without execution ports
+    PORTS_1    = 0x02,
+    PORTS_6    = 0x40,
+    PORTS_06   = 0x41,
+    PORTS_15   = 0x22,
+    PORTS_0156 = 0x63,
+    PORTS_23   = 0x0c,
+    PORTS_237  = 0x8c,
+    PORTS_4    = 0x10,
+};
+
+// set of registers implicitly read or written by operation
+enum RegisterMask
+{
+    REG_MASK_RAX   = 0x00001,
+    REG_MASK_RCX   = 0x00002,
+    REG_MASK_RDX   = 0x00004,
+    REG_MASK_RBX   = 0x00008,
+    REG_MASK_RSP   = 0x00010,
+    REG_MASK_RBP   = 0x00020,
+    REG_MASK_RSI   = 0x00040,
+    REG_MASK_RDI   = 0x00080,
+    REG_MASK_FLAGS = 0x10000,
+};
+
+// structure for basic block under analysis
+struct BasicBlock
+{
+    const char *name;                         // name of the first label of block (NULL if not labeled)
+    size_t index;                             // index of block
+    size_t instruction_number;                // number of instructions
+    size_t uop_number;                        // number of uops in fused domain
+    double port_pressure[PORT_NUMBER];        // cycles for which each port is occupied per iteration
+    unsigned int ready_cycle[REGISTER_SLOTS]; // cycle when value of each register gets ready
+    unsigned int latency;                     // length of critical path
+};
+
+// structure for timing of instruction on a microarchitecture
+struct InstructionTiming
+{
+    MnemonicKind kind;    // kind of mnemonic
+    unsigned int latency; // latency of result excluding load
+    size_t uop_number;    // number of uops excluding load and store
+    PortSet ports;        // set of ports on which the uops are executed
+};
+
+// structure for microarchitecture
+struct MicroarchitectureInfo
+{
+    const char *name;                     // name of microarchitecture
+    size_t issue_width;                   // number of uops issued per cycle
+    unsigned int load_latency;            // latency of load from L1 cache
+    PortSet load_ports;                   // set of ports for load
+    PortSet store_address_ports;          // set of ports for address of store
+    PortSet store_data_ports;             // set of ports for data of store
+    const InstructionTiming *timing_list; // timing of instructions indexed by kind of mnemonic
+};
+
+// structure for effect of operation
+struct OperationEffectInfo
+{
+    MnemonicKind kind;           // kind of mnemonic
+    unsigned int effects;        // set of effects on operands
+    unsigned int implicit_read;  // set of registers read implicitly
+    unsigned int implicit_write; // set of registers written implicitly
+};
+
+static const MicroarchitectureInfo *search_microarchitecture(const char *name);
+static size_t get_register_slot(RegisterKind reg);
+static bool is_register_operand(const Operand *operand);
+static bool is_memory_operand(const Operand *operand);
+static bool is_zero_idiom(const Operation *operation);
+static void add_port_pressure(PortSet ports, double uops, BasicBlock *block);
+static void start_basic_block(const char *name, size_t index, BasicBlock *block);
+static void analyze_operation(const MicroarchitectureInfo *info, const Operation *operation, bool fused, BasicBlock *block);
+static const char *get_label_name(const List(Label) *label_list, ListEntry(Label) **label_cursor, const Statement *statement);
+static void report_basic_block(const MicroarchitectureInfo *info, const BasicBlock *block);
+
+// timing of instructions on Skylake, where operands are registers
+static const InstructionTiming skylake_timing_list[] =
+{
+    {MN_ADD,           1,  1, PORTS_0156},
+    {MN_AND,           1,  1, PORTS_0156},
+    {MN_ANDN,          1,  1, PORTS_15},
+    {MN_BEXTR,         2,  2, PORTS_0156},
+    {MN_BLSI,          1,  1, PORTS_15},
+    {MN_BLSMSK,        1,  1, PORTS_15},
+    {MN_BLSR,          1,  1, PORTS_15},
+    {MN_BSF,           3,  1, PORTS_1},
+    {MN_BSR,           3,  1, PORTS_1},
+    {MN_BT,            1,  1, PORTS_06},
+    {MN_BTC,           1,  1, PORTS_06},
+    {MN_BTR,           1,  1, PORTS_06},
+    {MN_BTS,           1,  1, PORTS_06},
+    {MN_BZHI,          1,  1, PORTS_15},
+    {MN_CALL,          1,  1, PORTS_6},
+    {MN_CDQ,           1,  1, PORTS_06},
+    {MN_CMOVA,         2,  2, PORTS_06},
+    {MN_CMOVAE,        1,  1, PORTS_06},
+    {MN_CMOVB,         1,  1, PORTS_06},
+    {MN_CMOVBE,        2,  2, PORTS_06},
+    {MN_CMOVC,         1,  1, PORTS_06},
+    {MN_CMOVE,         1,  1, PORTS_06},
+    {MN_CMOVG,         1,  1, PORTS_06},
+    {MN_CMOVGE,        1,  1, PORTS_06},
+    {MN_CMOVL,         1,  1, PORTS_06},
+    {MN_CMOVLE,        1,  1, PORTS_06},
+    {MN_CMOVNA,        2,  2, PORTS_06},
+    {MN_CMOVNAE,       1,  1, PORTS_06},
+    {MN_CMOVNB,        1,  1, PORTS_06},
+    {MN_CMOVNBE,       2,  2, PORTS_06},
+    {MN_CMOVNC,        1,  1, PORTS_06},
+    {MN_CMOVNE,        1,  1, PORTS_06},
+    {MN_CMOVNG,        1,  1, PORTS_06},
+    {MN_CMOVNGE,       1,  1, PORTS_06},
+    {MN_CMOVNL,        1,  1, PORTS_06},
+    {MN_CMOVNLE,       1,  1, PORTS_06},
+    {MN_CMOVNO,        1,  1, PORTS_06},
+    {MN_CMOVNP,        1,  1, PORTS_06},
+    {MN_CMOVNS,        1,  1, PORTS_06},
+    {MN_CMOVNZ,        1,  1, PORTS_06},
+    {MN_CMOVO,         1,  1, PORTS_06},
+    {MN_CMOVP,         1,  1, PORTS_06},
+    {MN_CMOVPE,        1,  1, PORTS_06},
+    {MN_CMOVPO,        1,  1, PORTS_06},
+    {MN_CMOVS,         1,  1, PORTS_06},
+    {MN_CMOVZ,         1,  1, PORTS_06},
+    {MN_CMP,           1,  1, PORTS_0156},
+    {MN_CMPSB,         1,  4, PORTS_0156},
+    {MN_CMPXCHG,       2,  5, PORTS_0156},
+    {MN_CMPXCHG16B,   26, 19, PORTS_0156},
+    {MN_CQO,           1,  1, PORTS_06},
+    {MN_CWD,           1,  2, PORTS_0156},
+    {MN_IDIV,         26, 10, PORTS_0156},
+    {MN_IMUL,          3,  1, PORTS_1},
+    {MN_JA,            1,  1, PORTS_06},
+    {MN_JAE,           1,  1, PORTS_06},
+    {MN_JB,            1,  1, PORTS_06},
+    {MN_JBE,           1,  1, PORTS_06},
+    {MN_JC,            1,  1, PORTS_06},
+    {MN_JE,            1,  1, PORTS_06},
+    {MN_JECXZ,         1,  2, PORTS_06},
+    {MN_JG,            1,  1, PORTS_06},
+    {MN_JGE,           1,  1, PORTS_06},
+    {MN_JL,            1,  1, PORTS_06},
+    {MN_JLE,           1,  1, PORTS_06},
+    {MN_JMP,           1,  1, PORTS_6},
+    {MN_JNA,           1,  1, PORTS_06},
+    {MN_JNAE,          1,  1, PORTS_06},
+    {MN_JNB,           1,  1, PORTS_06},
+    {MN_JNBE,          1,  1, PORTS_06},
+    {MN_JNC,           1,  1, PORTS_06},
+    {MN_JNE,           1,  1, PORTS_06},
+    {MN_JNG,           1,  1, PORTS_06},
+    {MN_JNGE,          1,  1, PORTS_06},
+    {MN_JNL,           1,  1, PORTS_06},
+    {MN_JNLE,          1,  1, PORTS_06},
+    {MN_JNO,           1,  1, PORTS_06},
+    {MN_JNP,           1,  1, PORTS_06},
+    {MN_JNS,           1,  1, PORTS_06},
+    {MN_JNZ,           1,  1, PORTS_06},
+    {MN_JO,            1,  1, PORTS_06},
+    {MN_JP,            1,  1, PORTS_06},
+    {MN_JPE,           1,  1, PORTS_06},
+    {MN_JPO,           1,  1, PORTS_06},
+    {MN_JRCXZ,         1,  2, PORTS_06},
+    {MN_JS,            1,  1, PORTS_06},
+    {MN_JZ,            1,  1, PORTS_06},
+    {MN_LEA,           1,  1, PORTS_15},
+    {MN_LEAVE,         1,  2, PORTS_0156},
+    {MN_LFENCE,        0,  2, PORTS_NONE},
+    {MN_LODSB,         1,  2, PORTS_0156},
+    {MN_LZCNT,         3,  1, PORTS_1},
+    {MN_MFENCE,        0,  3, PORTS_0156},
+    {MN_MOV,           1,  1, PORTS_0156},
+    {MN_MOVSB,         1,  2, PORTS_0156},
+    {MN_MOVSD,         1,  2, PORTS_0156},
+    {MN_MOVSQ,         1,  2, PORTS_0156},
+    {MN_MOVSW,         1,  2, PORTS_0156},
+    {MN_MOVSX,         1,  1, PORTS_0156},
+    {MN_MOVSXD,        1,  1, PORTS_0156},
+    {MN_MOVZX,         1,  1, PORTS_0156},
+    {MN_MULX,          4,  2, PORTS_15},
+    {MN_NEG,           1,  1, PORTS_0156},
+    {MN_NOP,           0,  1, PORTS_NONE},
+    {MN_NOT,           1,  1, PORTS_0156},
+    {MN_OR,            1,  1, PORTS_0156},
+    {MN_PAUSE,       140,  4, PORTS_0156},
+    {MN_PDEP,          3,  1, PORTS_1},
+    {MN_PEXT,          3,  1, PORTS_1},
+    {MN_POP,           0,  0, PORTS_NONE},
+    {MN_POPCNT,        3,  1, PORTS_1},
+    {MN_PUSH,          0,  0, PORTS_NONE},
+    {MN_PUSHFQ,        1,  3, PORTS_0156},
+    {MN_RET,           1,  1, PORTS_6},
+    {MN_RORX,          1,  1, PORTS_06},
+    {MN_SAL,           1,  1, PORTS_06},
+    {MN_SAR,           1,  1, PORTS_06},
+    {MN_SARX,          1,  1, PORTS_06},
+    {MN_SCASB,         1,  2, PORTS_0156},
+    {MN_SETA,          2,  2, PORTS_06},
+    {MN_SETAE,         1,  1, PORTS_06},
+    {MN_SETB,          1,  1, PORTS_06},
+    {MN_SETBE,         2,  2, PORTS_06},
+    {MN_SETC,          1,  1, PORTS_06},
+    {MN_SETE,          1,  1, PORTS_06},
+    {MN_SETG,          1,  1, PORTS_06},
+    {MN_SETGE,         1,  1, PORTS_06},
+    {MN_SETL,          1,  1, PORTS_06},
+    {MN_SETLE,         1,  1, PORTS_06},
+    {MN_SETNA,         2,  2, PORTS_06},
+    {MN_SETNAE,        1,  1, PORTS_06},
+    {MN_SETNB,         1,  1, PORTS_06},
+    {MN_SETNBE,        2,  2, PORTS_06},
+    {MN_SETNC,         1,  1, PORTS_06},
+    {MN_SETNE,         1,  1, PORTS_06},
+    {MN_SETNG,         1,  1, PORTS_06},
+    {MN_SETNGE,        1,  1, PORTS_06},
+    {MN_SETNL,         1,  1, PORTS_06},
+    {MN_SETNLE,        1,  1, PORTS_06},
+    {MN_SETNO,         1,  1, PORTS_06},
+    {MN_SETNP,         1,  1, PORTS_06},
+    {MN_SETNS,         1,  1, PORTS_06},
+    {MN_SETNZ,         1,  1, PORTS_06},
+    {MN_SETO,          1,  1, PORTS_06},
+    {MN_SETP,          1,  1, PORTS_06},
+    {MN_SETPE,         1,  1, PORTS_06},
+    {MN_SETPO,         1,  1, PORTS_06},
+    {MN_SETS,          1,  1, PORTS_06},
+    {MN_SETZ,          1,  1, PORTS_06},
+    {MN_SFENCE,        0,  2, PORTS_NONE},
+    {MN_SHL,           1,  1, PORTS_06},
+    {MN_SHLX,          1,  1, PORTS_06},
+    {MN_SHR,           1,  1, PORTS_06},
+    {MN_SHRX,          1,  1, PORTS_06},
+    {MN_STOSB,         1,  1, PORTS_0156},
+    {MN_STOSD,         1,  1, PORTS_0156},
+    {MN_STOSQ,         1,  1, PORTS_0156},
+    {MN_STOSW,         1,  1, PORTS_0156},
+    {MN_SUB,           1,  1, PORTS_0156},
+    {MN_TZCNT,         3,  1, PORTS_1},
+    {MN_XADD,          2,  3, PORTS_0156},
+    {MN_XCHG,          2,  3, PORTS_0156},
+    {MN_XOR,           1,  1, PORTS_0156},
+};
+
+static const MicroarchitectureInfo microarchitecture_info_list[] =
+{
+    {"skylake", 4, 5, PORTS_23, PORTS_237, PORTS_4, skylake_timing_list},
+};
+static const size_t MICROARCHITECTURE_INFO_LIST_SIZE = sizeof(microarchitecture_info_list) / sizeof(microarchitecture_info_list[0]);
+
+// effects of operations, which are common to microarchitectures
+// where stack pointer updated by push, pop, call and ret is not written since the stack engine resolves it without latency
+static const OperationEffectInfo operation_effect_list[] =
+{
+    {MN_ADD,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_AND,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_ANDN,        EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BEXTR,       EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BLSI,        EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BLSMSK,      EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BLSR,        EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BSF,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BSR,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BT,          EF_READ_DEST, 0, REG_MASK_FLAGS},
+    {MN_BTC,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BTR,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BTS,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_BZHI,        EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_CALL,        EF_STORE, REG_MASK_RSP, 0},
+    {MN_CDQ,         EF_NONE, REG_MASK_RAX, REG_MASK_RDX},
+    {MN_CMOVA,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVAE,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVB,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVBE,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVC,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVE,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVG,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVGE,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVL,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVLE,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNA,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNAE,     EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNB,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNBE,     EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNC,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNE,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNG,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNGE,     EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNL,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNLE,     EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNO,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNP,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNS,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVNZ,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVO,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVP,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVPE,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVPO,      EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVS,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMOVZ,       EF_READ_DEST | EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_CMP,         EF_READ_DEST, 0, REG_MASK_FLAGS},
+    {MN_CMPSB,       EF_LOAD, REG_MASK_RSI | REG_MASK_RDI, REG_MASK_RSI | REG_MASK_RDI | REG_MASK_FLAGS},
+    {MN_CMPXCHG,     EF_READ_DEST | EF_WRITE_DEST, REG_MASK_RAX, REG_MASK_RAX | REG_MASK_FLAGS},
+    {MN_CMPXCHG16B,  EF_READ_DEST | EF_WRITE_DEST, REG_MASK_RAX | REG_MASK_RBX | REG_MASK_RCX | REG_MASK_RDX, REG_MASK_RAX | REG_MASK_RDX | REG_MASK_FLAGS},
+    {MN_CQO,         EF_NONE, REG_MASK_RAX, REG_MASK_RDX},
+    {MN_CWD,         EF_NONE, REG_MASK_RAX, REG_MASK_RDX},
+    {MN_IDIV,        EF_NONE, REG_MASK_RAX | REG_MASK_RDX, REG_MASK_RAX | REG_MASK_RDX | REG_MASK_FLAGS},
+    {MN_IMUL,        EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_JA,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JAE,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JB,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JBE,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JC,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JE,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JECXZ,       EF_NONE, REG_MASK_RCX, 0},
+    {MN_JG,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JGE,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JL,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JLE,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JMP,         EF_NONE, 0, 0},
+    {MN_JNA,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNAE,        EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNB,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNBE,        EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNC,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNE,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNG,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNGE,        EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNL,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNLE,        EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNO,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNP,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNS,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JNZ,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JO,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JP,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JPE,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JPO,         EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JRCXZ,       EF_NONE, REG_MASK_RCX, 0},
+    {MN_JS,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_JZ,          EF_NONE, REG_MASK_FLAGS, 0},
+    {MN_LEA,         EF_WRITE_DEST | EF_ADDRESS, 0, 0},
+    {MN_LEAVE,       EF_LOAD, REG_MASK_RBP, REG_MASK_RSP | REG_MASK_RBP},
+    {MN_LFENCE,      EF_NONE, 0, 0},
+    {MN_LODSB,       EF_LOAD, REG_MASK_RSI, REG_MASK_RAX | REG_MASK_RSI},
+    {MN_LZCNT,       EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_MFENCE,      EF_NONE, 0, 0},
+    {MN_MOV,         EF_WRITE_DEST | EF_MOVE, 0, 0},
+    {MN_MOVSB,       EF_LOAD | EF_STORE, REG_MASK_RSI | REG_MASK_RDI, REG_MASK_RSI | REG_MASK_RDI},
+    {MN_MOVSD,       EF_LOAD | EF_STORE, REG_MASK_RSI | REG_MASK_RDI, REG_MASK_RSI | REG_MASK_RDI},
+    {MN_MOVSQ,       EF_LOAD | EF_STORE, REG_MASK_RSI | REG_MASK_RDI, REG_MASK_RSI | REG_MASK_RDI},
+    {MN_MOVSW,       EF_LOAD | EF_STORE, REG_MASK_RSI | REG_MASK_RDI, REG_MASK_RSI | REG_MASK_RDI},
+    {MN_MOVSX,       EF_WRITE_DEST | EF_MOVE, 0, 0},
+    {MN_MOVSXD,      EF_WRITE_DEST | EF_MOVE, 0, 0},
+    {MN_MOVZX,       EF_WRITE_DEST | EF_MOVE, 0, 0},
+    {MN_MULX,        EF_WRITE_DEST, REG_MASK_RDX, 0},
+    {MN_NEG,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_NOP,         EF_NONE, 0, 0},
+    {MN_NOT,         EF_READ_DEST | EF_WRITE_DEST, 0, 0},
+    {MN_OR,          EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_PAUSE,       EF_NONE, 0, 0},
+    {MN_PDEP,        EF_WRITE_DEST, 0, 0},
+    {MN_PEXT,        EF_WRITE_DEST, 0, 0},
+    {MN_POP,         EF_WRITE_DEST | EF_LOAD, REG_MASK_RSP, 0},
+    {MN_POPCNT,      EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_PUSH,        EF_STORE, REG_MASK_RSP, 0},
+    {MN_PUSHFQ,      EF_STORE, REG_MASK_RSP | REG_MASK_FLAGS, 0},
+    {MN_RET,         EF_LOAD, REG_MASK_RSP, 0},
+    {MN_RORX,        EF_WRITE_DEST, 0, 0},
+    {MN_SAL,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_SAR,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_SARX,        EF_WRITE_DEST, 0, 0},
+    {MN_SCASB,       EF_LOAD, REG_MASK_RAX | REG_MASK_RDI, REG_MASK_RDI | REG_MASK_FLAGS},
+    {MN_SETA,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETAE,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETB,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETBE,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETC,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETE,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETG,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETGE,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETL,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETLE,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNA,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNAE,      EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNB,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNBE,      EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNC,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNE,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNG,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNGE,      EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNL,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNLE,      EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNO,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNP,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNS,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETNZ,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETO,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETP,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETPE,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETPO,       EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETS,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SETZ,        EF_WRITE_DEST, REG_MASK_FLAGS, 0},
+    {MN_SFENCE,      EF_NONE, 0, 0},
+    {MN_SHL,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_SHLX,        EF_WRITE_DEST, 0, 0},
+    {MN_SHR,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_SHRX,        EF_WRITE_DEST, 0, 0},
+    {MN_STOSB,       EF_STORE, REG_MASK_RAX | REG_MASK_RDI, REG_MASK_RDI},
+    {MN_STOSD,       EF_STORE, REG_MASK_RAX | REG_MASK_RDI, REG_MASK_RDI},
+    {MN_STOSQ,       EF_STORE, REG_MASK_RAX | REG_MASK_RDI, REG_MASK_RDI},
+    {MN_STOSW,       EF_STORE, REG_MASK_RAX | REG_MASK_RDI, REG_MASK_RDI},
+    {MN_SUB,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_TZCNT,       EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_XADD,        EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+    {MN_XCHG,        EF_READ_DEST | EF_WRITE_DEST, 0, 0},
+    {MN_XOR,         EF_READ_DEST | EF_WRITE_DEST, 0, REG_MASK_FLAGS},
+};
+
+
+/*
+search microarchitecture by name
+*/
+static const MicroarchitectureInfo *search_microarchitecture(const char *name)
+{
+    for(size_t i = 0; i < MICROARCHITECTURE_INFO_LIST_SIZE; i++)
+    {
+        if(strcmp(microarchitecture_info_list[i].name, name) == 0)
+        {
+            return &microarchitecture_info_list[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+/*
+get slot of general-purpose register in dependency analysis
+*/
+static size_t get_register_slot(RegisterKind reg)
+{
+    // registers are ordered by their numbers for each size
+    return reg % GPR_NUMBER;
+}
+
+
+/*
+check if operand is register
+*/
+static bool is_register_operand(const Operand *operand)
+{
+    return (OP_R8 <= operand->kind) && (operand->kind <= OP_R64);
+}
+
+
+/*
+check if operand is memory
+*/
+static bool is_memory_operand(const Operand *operand)
+{
+    return (OP_M8 <= operand->kind) && (operand->kind <= OP_M128);
+}
+
+
+/*
+check if operation is a zero idiom, which is independent of the previous value of its operand
+*/
+static bool is_zero_idiom(const Operation *operation)
+{
+    if(((operation->kind != MN_XOR) && (operation->kind != MN_SUB)) || (get_length(Operand)(operation->operands) != 2))
+    {
+        return false;
+    }
+
+    const Operand *operand1 = get_first_element(Operand)(operation->operands);
+    const Operand *operand2 = get_element(Operand)(next_entry(Operand, get_first_entry(Operand)(operation->operands)));
+    return is_register_operand(operand1) && is_register_operand(operand2) && (operand1->reg == operand2->reg);
+}
+
+
+/*
+add pressure of uops to ports on which they can be executed, assuming that they are evenly distributed
+*/
+static void add_port_pressure(PortSet ports, double uops, BasicBlock *block)
+{
+    size_t port_count = 0;
+    for(size_t i = 0; i < PORT_NUMBER; i++)
+    {
+        port_count += (ports >> i) & 1;
+    }
+
+    for(size_t i = 0; i < PORT_NUMBER; i++)
+    {
+        if((ports >> i) & 1)
+        {
+            block->port_pressure[i] += uops / port_count;
+        }
+    }
+}
+
+
+/*
+start analysis of a new basic block
+*/
+static void start_basic_block(const char *name, size_t index, BasicBlock *block)
+{
+    memset(block, 0, sizeof(BasicBlock));
+    block->name = name;
+    block->index = index;
+}
+
+
+/*
+analyze an operation and accumulate its uops and latency to a basic block
+*/
+static void analyze_operation(const MicroarchitectureInfo *info, const Operation *operation, bool fused, BasicBlock *block)
+{
+    const InstructionTiming *timing = &info->timing_list[operation->kind];
+    const OperationEffectInfo *effect = &operation_effect_list[operation->kind];
+    assert((timing->kind == operation->kind) && (effect->kind == operation->kind));
+
+    // collect registers and memory accessed by the operation
+    unsigned int read_registers = effect->implicit_read;
+    unsigned int write_registers = effect->implicit_write;
+    bool has_memory = false;
+    bool load = (effect->effects & EF_LOAD) != 0;
+    bool store = (effect->effects & EF_STORE) != 0;
+    bool zero_idiom = is_zero_idiom(operation);
+    if(operation->operands != NULL)
+    {
+        bool first = true;
+        for_each_entry(Operand, cursor, operation->operands)
+        {
+            const Operand *operand = get_element(Operand)(cursor);
+            bool is_destination = first && ((effect->effects & EF_WRITE_DEST) != 0);
+            bool is_source = !first || ((effect->effects & EF_READ_DEST) != 0) || ((effect->effects & EF_WRITE_DEST) == 0);
+            if(is_memory_operand(operand))
+            {
+                has_memory = true;
+                if((operand->reg != REG_RIP) && (operand->reg != REG_NONE))
+                {
+                    read_registers |= 1u << get_register_slot(operand->reg);
+                }
+                if((effect->effects & EF_ADDRESS) == 0)
+                {
+                    load = load || is_source;
+                    store = store || is_destination;
+                }
+            }
+            else if(is_register_operand(operand))
+            {
+                read_registers |= (is_source && !zero_idiom) ? (1u << get_register_slot(operand->reg)) : 0;
+                write_registers |= is_destination ? (1u << get_register_slot(operand->reg)) : 0;
+            }
+            first = false;
+        }
+    }
+
+    // a conditional jump fused with the preceding operation consumes no additional uop
+    size_t uop_number = timing->uop_number;
+    if(fused || (((effect->effects & EF_MOVE) != 0) && has_memory))
+    {
+        uop_number = 0;
+    }
+    if(fused)
+    {
+        load = false;
+        store = false;
+    }
+
+    // load is micro-fused with the other uops, while store takes another uop in fused domain
+    block->instruction_number++;
+    block->uop_number += ((uop_number > 0) ? uop_number : (load ? 1 : 0)) + (store ? 1 : 0);
+    add_port_pressure(zero_idiom ? PORTS_NONE : timing->ports, uop_number, block);
+    if(load)
+    {
+        add_port_pressure(info->load_ports, 1, block);
+    }
+    if(store)
+    {
+        add_port_pressure(info->store_address_ports, 1, block);
+        add_port_pressure(info->store_data_ports, 1, block);
+    }
+
+    // latency along dependency of registers
+    unsigned int latency = (((uop_number > 0) && !zero_idiom) ? timing->latency : 0) + (load ? info->load_latency : 0);
+    unsigned int start = 0;
+    for(size_t i = 0; i < REGISTER_SLOTS; i++)
+    {
+        if(((read_registers >> i) & 1) && (block->ready_cycle[i] > start))
+        {
+            start = block->ready_cycle[i];
+        }
+    }
+    for(size_t i = 0; i < REGISTER_SLOTS; i++)
+    {
+        if((write_registers >> i) & 1)
+        {
+            block->ready_cycle[i] = start + latency;
+        }
+    }
+    if(start + latency > block->latency)
+    {
+        block->latency = start + latency;
+    }
+}
+
+
+/*
+get name of the first label marking a statement, advancing cursor over labels in order of appearance
+*/
+static const char *get_label_name(const List(Label) *label_list, ListEntry(Label) **label_cursor, const Statement *statement)
+{
+    const char *name = NULL;
+    while(!end_iteration(Label)(label_list, *label_cursor))
+    {
+        const Label *label = get_element(Label)(*label_cursor);
+        if((label->statement != NULL) && (label->statement != statement))
+        {
+            break;
+        }
+
+        if((label->statement != NULL) && (name == NULL))
+        {
+            name = label->symbol->body;
+        }
+        *label_cursor = next_entry(Label, *label_cursor);
+    }
+
+    return name;
+}
+
+
+/*
+report summary of a basic block
+*/
+static void report_basic_block(const MicroarchitectureInfo *info, const BasicBlock *block)
+{
+    if(block->instruction_number == 0)
+    {
+        return;
+    }
+
+    // reciprocal throughput is bounded by issue width and the most loaded port
+    double throughput = (double)block->uop_number / info->issue_width;
+    const char *bottleneck = "issue width";
+    char port_name[sizeof("port 0")];
+    for(size_t i = 0; i < PORT_NUMBER; i++)
+    {
+        if(block->port_pressure[i] > throughput)
+        {
+            throughput = block->port_pressure[i];
+            sprintf(port_name, "port %zu", i);
+            bottleneck = port_name;
+        }
+    }
+
+    if(block->name != NULL)
+    {
+        printf("block %zu <%s>:\n", block->index, block->name);
+    }
+    else
+    {
+        printf("block %zu:\n", block->index);
+    }
+    printf("    instructions:          %zu\n", block->instruction_number);
+    printf("    uops:                  %zu\n", block->uop_number);
+    printf("    reciprocal throughput: %.2f cycles (bound by %s)\n", throughput, bottleneck);
+    printf("    critical path latency: %u cycles\n", block->latency);
+    printf("    port pressure:        ");
+    for(size_t i = 0; i < PORT_NUMBER; i++)
+    {
+        printf(" %zu:%.2f", i, block->port_pressure[i]);
+    }
+    printf("\n");
+}
+
+
+/*
+analyze throughput, latency and port pressure of each basic block in executable sections
+*/
+void analyze(const char *microarchitecture, const Program *program)
+{
+    const MicroarchitectureInfo *info = search_microarchitecture(microarchitecture);
+    if(info == NULL)
+    {
+        fprintf(stderr, "unknown microarchitecture '%s'\n", microarchitecture);
+        exit(EXIT_FAILURE);
+    }
+    printf("microarchitecture: %s (issue width: %zu, load latency: %u)\n", info->name, info->issue_width, info->load_latency);
+
+    // basic blocks start at labels and end at branches
+    ListEntry(Label) *label_cursor = get_first_entry(Label)(program->label_list);
+    BasicBlock block;
+    size_t block_index = 0;
+    const Operation *previous = NULL;
+    start_basic_block(NULL, block_index, &block);
+    for_each_entry(Statement, cursor, program->statement_list)
+    {
+        const Statement *statement = get_element(Statement)(cursor);
+        const char *name = get_label_name(program->label_list, &label_cursor, statement);
+        if((statement->kind != ST_INSTRUCTION) || ((get_section(statement->section)->flags & SHF_EXECINSTR) == 0))
+        {
+            continue;
+        }
+
+        if(name != NULL)
+        {
+            if(block.instruction_number > 0)
+            {
+                report_basic_block(info, &block);
+                block_index++;
+            }
+            start_basic_block(name, block_index, &block);
+            previous = NULL;
+        }
+
+        const Operation *operation = statement->operation;
+        bool fused = (previous != NULL) && is_fused_operation_pair(previous, operation);
+        analyze_operation(info, operation, fused, &block);
+        previous = operation;
+
+        if(get_branch_kind(operation) != BR_NONE)
+        {
+            report_basic_block(info, &block);
+            block_index++;
+            start_basic_block(NULL, block_index, &block);
+            previous = NULL;
+        }
+    }
+    report_basic_block(info, &block);
+}
@@ -0,0 +1,8 @@
+#ifndef ANALYZER_H
+#define ANALYZER_H
+
+#include "parser.h"
+
+void analyze(const char *microarchitecture, const Program *program);
+
+#endif /* !ANALYZER_H */
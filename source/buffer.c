@@ -1,3 +1,4 @@
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -46,3 +47,74 @@ ByteBufferType *fill_bytes(char byte, size_t size, ByteBufferType *buffer)
 
     return buffer;
 }
+
+
+/*
+append an unsigned integer in little endian
+*/
+ByteBufferType *append_uint(uintmax_t value, size_t size, ByteBufferType *buffer)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        char byte = (value >> (8 * i)) & 0xff;
+        append_bytes(&byte, sizeof(byte), buffer);
+    }
+
+    return buffer;
+}
+
+
+/*
+append an unsigned integer in LEB128
+*/
+ByteBufferType *append_uleb128(uintmax_t value, ByteBufferType *buffer)
+{
+    do
+    {
+        char byte = value & 0x7f;
+        value >>= 7;
+        if(value != 0)
+        {
+            byte |= 0x80;
+        }
+        append_bytes(&byte, sizeof(byte), buffer);
+    } while(value != 0);
+
+    return buffer;
+}
+
+
+/*
+append a signed integer in LEB128
+*/
+ByteBufferType *append_sleb128(intmax_t value, ByteBufferType *buffer)
+{
+    bool more = true;
+    while(more)
+    {
+        char byte = value & 0x7f;
+        value >>= 7;
+        more = !(((value == 0) && ((byte & 0x40) == 0)) || ((value == -1) && ((byte & 0x40) != 0)));
+        if(more)
+        {
+            byte |= 0x80;
+        }
+        append_bytes(&byte, sizeof(byte), buffer);
+    }
+
+    return buffer;
+}
+
+
+/*
+overwrite an unsigned integer in little endian which has been appended
+*/
+ByteBufferType *patch_uint(size_t offset, uintmax_t value, size_t size, ByteBufferType *buffer)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        buffer->body[offset + i] = (value >> (8 * i)) & 0xff;
+    }
+
+    return buffer;
+}
@@ -2,6 +2,7 @@
 #define BUFFER_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 typedef struct
 {
@@ -13,5 +14,9 @@ typedef struct
 size_t align_to(size_t n, size_t alignment);
 ByteBufferType *append_bytes(const char *bytes, size_t size, ByteBufferType *buffer);
 ByteBufferType *fill_bytes(char byte, size_t size, ByteBufferType *buffer);
+ByteBufferType *append_uint(uintmax_t value, size_t size, ByteBufferType *buffer);
+ByteBufferType *append_uleb128(uintmax_t value, ByteBufferType *buffer);
+ByteBufferType *append_sleb128(intmax_t value, ByteBufferType *buffer);
+ByteBufferType *patch_uint(size_t offset, uintmax_t value, size_t size, ByteBufferType *buffer);
 
 #endif /* !BUFFER_H */
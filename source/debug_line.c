@@ -0,0 +1,359 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug_line.h"
+#include "elf_class.h"
+
+static void append_string(const char *string, ByteBufferType *buffer);
+static size_t get_directory_index(const char *directory);
+static void append_line_header(ByteBufferType *buffer);
+static void append_line_advance(Elf_Addr address_advance, intmax_t line_advance, ByteBufferType *buffer);
+static void append_line_sequence(const LineRow *rows, size_t size, Section *debug_line);
+static int compare_line_rows(const void *row1, const void *row2);
+
+// standard opcodes, extended opcodes and content descriptions of line number program
+enum
+{
+    DW_LNS_copy               = 0x01,
+    DW_LNS_advance_pc         = 0x02,
+    DW_LNS_advance_line       = 0x03,
+    DW_LNS_set_file           = 0x04,
+    DW_LNS_set_column         = 0x05,
+    DW_LNS_negate_stmt        = 0x06,
+    DW_LNS_set_prologue_end   = 0x0a,
+    DW_LNS_set_epilogue_begin = 0x0b,
+    DW_LNE_end_sequence       = 0x01,
+    DW_LNE_set_address        = 0x02,
+    DW_LNE_set_discriminator  = 0x04,
+    DW_LNCT_path              = 0x01,
+    DW_LNCT_directory_index   = 0x02,
+    DW_FORM_string            = 0x08,
+    DW_FORM_udata             = 0x0f,
+};
+
+static const uint16_t DWARF_VERSION = 5;
+static const uint8_t MINIMUM_INSTRUCTION_LENGTH = 1;
+static const uint8_t MAXIMUM_OPERATIONS_PER_INSTRUCTION = 1;
+static const int LINE_BASE = -5;
+static const int LINE_RANGE = 14;
+static const uint8_t OPCODE_BASE = 13;
+static const uint8_t standard_opcode_lengths[] = {0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1};
+static const char DEFAULT_COMPILATION_DIRECTORY[] = ".";
+
+static SectionKind debug_line_section = SC_UND; // .debug_line section (SC_UND if no file is given)
+static LineFile *file_list = NULL;              // files indexed by their numbers
+static size_t file_list_size = 0;               // number of slots of files
+static const char **directory_list = NULL;      // directories of files, whose first entry is that of compilation
+static size_t directory_list_size = 0;          // number of directories
+static LineRow *row_list = NULL;                // rows in order of addition
+static size_t row_list_size = 0;                // number of rows
+static size_t row_list_capacity = 0;            // capacity of rows
+
+
+/*
+append a null-terminated string
+*/
+static void append_string(const char *string, ByteBufferType *buffer)
+{
+    append_bytes(string, strlen(string) + 1, buffer);
+}
+
+
+/*
+set a file of the number given by .file directive
+* The file numbered 0 is the primary source file, and the others are referred by .loc directive.
+*/
+void set_line_file(Elf_Word number, const char *directory, const char *name)
+{
+    if(number >= file_list_size)
+    {
+        size_t size = number + 1;
+        file_list = realloc(file_list, size * sizeof(LineFile));
+        memset(&file_list[file_list_size], 0, (size - file_list_size) * sizeof(LineFile));
+        file_list_size = size;
+    }
+    file_list[number].directory = directory;
+    file_list[number].name = name;
+
+    if(debug_line_section == SC_UND)
+    {
+        debug_line_section = make_section(".debug_line", SHT_PROGBITS, 0, 0)->kind;
+    }
+}
+
+
+/*
+check if a file of the number is given
+*/
+bool has_line_file(Elf_Word number)
+{
+    return (number < file_list_size) && (file_list[number].name != NULL);
+}
+
+
+/*
+add a row of line number table for a statement after it is laid out
+*/
+void add_line_row(SectionKind section, Elf_Addr address, const SourceLocation *location)
+{
+    if(row_list_size == row_list_capacity)
+    {
+        row_list_capacity = (row_list_capacity == 0) ? 64 : (row_list_capacity * 2);
+        row_list = realloc(row_list, row_list_capacity * sizeof(LineRow));
+    }
+
+    LineRow *row = &row_list[row_list_size];
+    row->section = section;
+    row->address = address;
+    row->location = *location;
+    row->order = row_list_size;
+    row_list_size++;
+}
+
+
+/*
+get index of directory in the directory table, adding the directory unless it has been added
+*/
+static size_t get_directory_index(const char *directory)
+{
+    if(directory == NULL)
+    {
+        return 0;
+    }
+
+    for(size_t i = 0; i < directory_list_size; i++)
+    {
+        if(strcmp(directory_list[i], directory) == 0)
+        {
+            return i;
+        }
+    }
+
+    directory_list = realloc(directory_list, (directory_list_size + 1) * sizeof(const char *));
+    directory_list[directory_list_size] = directory;
+    directory_list_size++;
+    return directory_list_size - 1;
+}
+
+
+/*
+append header of line number program following the unit length
+* Directories and file names are given in strings in place, so that no other section is needed.
+*/
+static void append_line_header(ByteBufferType *buffer)
+{
+    append_uint(DWARF_VERSION, sizeof(uint16_t), buffer);
+    append_uint(get_address_size(), sizeof(uint8_t), buffer);
+    append_uint(0, sizeof(uint8_t), buffer); // segment_selector_size
+    size_t header_length_offset = buffer->size;
+    append_uint(0, sizeof(uint32_t), buffer);
+    size_t header_start = buffer->size;
+
+    append_uint(MINIMUM_INSTRUCTION_LENGTH, sizeof(uint8_t), buffer);
+    append_uint(MAXIMUM_OPERATIONS_PER_INSTRUCTION, sizeof(uint8_t), buffer);
+    append_uint(1, sizeof(uint8_t), buffer); // default_is_stmt
+    append_uint((uint8_t)LINE_BASE, sizeof(uint8_t), buffer);
+    append_uint(LINE_RANGE, sizeof(uint8_t), buffer);
+    append_uint(OPCODE_BASE, sizeof(uint8_t), buffer);
+    append_bytes((const char *)standard_opcode_lengths, sizeof(standard_opcode_lengths), buffer);
+
+    // the primary source file is the first file unless it is given
+    if(!has_line_file(0))
+    {
+        LineFile primary = has_line_file(1) ? file_list[1] : (LineFile){NULL, ""};
+        set_line_file(0, NULL, primary.name);
+        file_list[0].directory = primary.directory;
+    }
+
+    // directory of compilation is given by the primary source file, or the current directory
+    const char *compilation_directory = file_list[0].directory;
+    if(compilation_directory == NULL)
+    {
+        compilation_directory = getenv("PWD");
+    }
+    directory_list_size = 0;
+    get_directory_index((compilation_directory != NULL) ? compilation_directory : DEFAULT_COMPILATION_DIRECTORY);
+    size_t *directory_indices = calloc(file_list_size, sizeof(size_t));
+    for(size_t i = 1; i < file_list_size; i++)
+    {
+        directory_indices[i] = get_directory_index(file_list[i].directory);
+    }
+
+    // directory table
+    append_uint(1, sizeof(uint8_t), buffer); // directory_entry_format_count
+    append_uleb128(DW_LNCT_path, buffer);
+    append_uleb128(DW_FORM_string, buffer);
+    append_uleb128(directory_list_size, buffer);
+    for(size_t i = 0; i < directory_list_size; i++)
+    {
+        append_string(directory_list[i], buffer);
+    }
+
+    // file name table, where files not given are substituted by the primary source file
+    append_uint(2, sizeof(uint8_t), buffer); // file_name_entry_format_count
+    append_uleb128(DW_LNCT_path, buffer);
+    append_uleb128(DW_FORM_string, buffer);
+    append_uleb128(DW_LNCT_directory_index, buffer);
+    append_uleb128(DW_FORM_udata, buffer);
+    append_uleb128(file_list_size, buffer);
+    for(size_t i = 0; i < file_list_size; i++)
+    {
+        size_t number = has_line_file(i) ? i : 0;
+        append_string(file_list[number].name, buffer);
+        append_uleb128(directory_indices[number], buffer);
+    }
+    free(directory_indices);
+
+    patch_uint(header_length_offset, buffer->size - header_start, sizeof(uint32_t), buffer);
+}
+
+
+/*
+append opcodes to advance address and line, and append a row
+*/
+static void append_line_advance(Elf_Addr address_advance, intmax_t line_advance, ByteBufferType *buffer)
+{
+    if((line_advance < LINE_BASE) || (line_advance >= LINE_BASE + LINE_RANGE))
+    {
+        append_uint(DW_LNS_advance_line, sizeof(uint8_t), buffer);
+        append_sleb128(line_advance, buffer);
+        line_advance = 0;
+    }
+
+    // a special opcode advances both address and line, and appends a row
+    uintmax_t opcode = (line_advance - LINE_BASE) + (LINE_RANGE * address_advance) + OPCODE_BASE;
+    if(opcode > UINT8_MAX)
+    {
+        append_uint(DW_LNS_advance_pc, sizeof(uint8_t), buffer);
+        append_uleb128(address_advance, buffer);
+        opcode = (line_advance - LINE_BASE) + OPCODE_BASE;
+    }
+    append_uint(opcode, sizeof(uint8_t), buffer);
+}
+
+
+/*
+append a sequence of rows in a section, which ends at the end of the section
+*/
+static void append_line_sequence(const LineRow *rows, size_t size, Section *debug_line)
+{
+    ByteBufferType *buffer = debug_line->body;
+    const Section *section = get_section(rows[0].section);
+
+    // the sequence starts at the top of the section, which is relocated by the section symbol
+    append_uint(0, sizeof(uint8_t), buffer);
+    append_uleb128(1 + get_address_size(), buffer);
+    append_uint(DW_LNE_set_address, sizeof(uint8_t), buffer);
+    Elf_Xword type = is_elf_class32() ? R_X86_64_32 : R_X86_64_64;
+    Elf_Rela rela = {buffer->size, ELF_R_INFO(section->symtab_index, type), 0};
+    append_relocation_entry(&rela, debug_line->rela_body);
+    append_uint(0, get_address_size(), buffer);
+
+    Elf_Addr address = 0;
+    Elf_Word file = 1;
+    Elf_Word line = 1;
+    Elf_Word column = 0;
+    bool is_stmt = true;
+    for(size_t i = 0; i < size; i++)
+    {
+        const SourceLocation *location = &rows[i].location;
+        if(location->file != file)
+        {
+            append_uint(DW_LNS_set_file, sizeof(uint8_t), buffer);
+            append_uleb128(location->file, buffer);
+            file = location->file;
+        }
+        if(location->column != column)
+        {
+            append_uint(DW_LNS_set_column, sizeof(uint8_t), buffer);
+            append_uleb128(location->column, buffer);
+            column = location->column;
+        }
+        if(((location->flags & LF_IS_STMT) != 0) != is_stmt)
+        {
+            append_uint(DW_LNS_negate_stmt, sizeof(uint8_t), buffer);
+            is_stmt = !is_stmt;
+        }
+        if(location->flags & LF_PROLOGUE_END)
+        {
+            append_uint(DW_LNS_set_prologue_end, sizeof(uint8_t), buffer);
+        }
+        if(location->flags & LF_EPILOGUE_BEGIN)
+        {
+            append_uint(DW_LNS_set_epilogue_begin, sizeof(uint8_t), buffer);
+        }
+        if(location->discriminator != 0)
+        {
+            ByteBufferType operand = {NULL, 0, 0};
+            append_uleb128(location->discriminator, &operand);
+            append_uint(0, sizeof(uint8_t), buffer);
+            append_uleb128(1 + operand.size, buffer);
+            append_uint(DW_LNE_set_discriminator, sizeof(uint8_t), buffer);
+            append_bytes(operand.body, operand.size, buffer);
+            free(operand.body);
+        }
+
+        append_line_advance(rows[i].address - address, (intmax_t)location->line - (intmax_t)line, buffer);
+        address = rows[i].address;
+        line = location->line;
+    }
+
+    if(section->size > address)
+    {
+        append_uint(DW_LNS_advance_pc, sizeof(uint8_t), buffer);
+        append_uleb128(section->size - address, buffer);
+    }
+    append_uint(0, sizeof(uint8_t), buffer);
+    append_uleb128(1, buffer);
+    append_uint(DW_LNE_end_sequence, sizeof(uint8_t), buffer);
+}
+
+
+/*
+compare rows by section, and then by order of addition
+*/
+static int compare_line_rows(const void *row1, const void *row2)
+{
+    const LineRow *line_row1 = row1;
+    const LineRow *line_row2 = row2;
+    if(line_row1->section != line_row2->section)
+    {
+        return (line_row1->section < line_row2->section) ? -1 : 1;
+    }
+
+    return (line_row1->order < line_row2->order) ? -1 : ((line_row1->order > line_row2->order) ? 1 : 0);
+}
+
+
+/*
+make contents of .debug_line section and its relocations in DWARF 5 after symbol table indices of sections are set
+* Rows of each section make a sequence, since sections are placed independently by the linker.
+*/
+void make_debug_line(void)
+{
+    if(debug_line_section == SC_UND)
+    {
+        return;
+    }
+
+    Section *debug_line = get_section(debug_line_section);
+    ByteBufferType *buffer = debug_line->body;
+    size_t unit_start = buffer->size;
+    append_uint(0, sizeof(uint32_t), buffer); // unit_length
+    append_line_header(buffer);
+
+    qsort(row_list, row_list_size, sizeof(LineRow), compare_line_rows);
+    size_t start = 0;
+    for(size_t i = 1; i <= row_list_size; i++)
+    {
+        if((i == row_list_size) || (row_list[i].section != row_list[start].section))
+        {
+            append_line_sequence(&row_list[start], i - start, debug_line);
+            start = i;
+        }
+    }
+
+    patch_uint(unit_start, buffer->size - unit_start - sizeof(uint32_t), sizeof(uint32_t), buffer);
+    debug_line->size = buffer->size;
+}
@@ -0,0 +1,56 @@
+#ifndef DEBUG_LINE_H
+#define DEBUG_LINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "buffer.h"
+#include "elf_wrap.h"
+#include "section.h"
+
+typedef enum LocationFlag LocationFlag;
+typedef struct LineFile LineFile;
+typedef struct LineRow LineRow;
+typedef struct SourceLocation SourceLocation;
+
+// flag of row in line number table
+enum LocationFlag
+{
+    LF_NONE           = 0x00, // no flag
+    LF_IS_STMT        = 0x01, // the row is a recommended breakpoint location
+    LF_PROLOGUE_END   = 0x02, // the row is where a function's prologue ends
+    LF_EPILOGUE_BEGIN = 0x04, // the row is where a function's epilogue begins
+};
+
+// structure for source location given by .loc directive
+struct SourceLocation
+{
+    Elf_Word file;          // number of file
+    Elf_Word line;          // line number (beginning with 1)
+    Elf_Word column;        // column number (0 if unknown)
+    unsigned int flags;     // set of flags
+    Elf_Word discriminator; // discriminator of block to which the location belongs
+};
+
+// structure for file given by .file directive
+struct LineFile
+{
+    const char *directory; // directory of file (NULL if it is that of compilation)
+    const char *name;      // name of file
+};
+
+// structure for row in line number table
+struct LineRow
+{
+    SectionKind section;     // section of statement
+    Elf_Addr address;        // address of statement
+    SourceLocation location; // source location of statement
+    size_t order;            // order in which the row is added
+};
+
+void set_line_file(Elf_Word number, const char *directory, const char *name);
+bool has_line_file(Elf_Word number);
+void add_line_row(SectionKind section, Elf_Addr address, const SourceLocation *location);
+void make_debug_line(void);
+
+#endif /* !DEBUG_LINE_H */
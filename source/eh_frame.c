@@ -0,0 +1,465 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffer.h"
+#include "eh_frame.h"
+#include "elf_class.h"
+
+typedef struct CommonInformation CommonInformation;
+typedef struct FrameEntry FrameEntry;
+typedef struct FrameState FrameState;
+
+// structure for CIE shared by procedures
+struct CommonInformation
+{
+    ByteBufferType instructions; // initial instructions
+    size_t offset;               // offset of CIE in .eh_frame section
+};
+
+// structure for directive laid out in a section
+struct FrameEntry
+{
+    SectionKind section;      // section of directive
+    Elf_Addr address;         // address of directive
+    FrameDirective directive; // contents of directive
+};
+
+// structure for rule of CFA
+struct FrameState
+{
+    Elf_Word reg;      // DWARF number of CFA register
+    Elf_Sxword offset; // offset of CFA from the register
+};
+
+static size_t get_cie_offset(ByteBufferType *instructions, ByteBufferType *buffer);
+static void append_cie(const ByteBufferType *instructions, ByteBufferType *buffer);
+static bool is_initial_instruction(const FrameEntry *entry, const FrameEntry *start);
+static void append_fde(const FrameEntry *entries, size_t size, Section *eh_frame);
+static void finish_entry(size_t start, ByteBufferType *buffer);
+static void append_advance_location(Elf_Addr delta, ByteBufferType *buffer);
+static void append_register_offset(Elf_Word reg, Elf_Sxword offset, ByteBufferType *buffer);
+static void append_cfa_offset(Elf_Sxword offset, ByteBufferType *buffer);
+static void append_frame_instruction(const FrameDirective *directive, FrameState *state, ByteBufferType *buffer);
+
+// call frame instructions and pointer encodings
+enum
+{
+    DW_CFA_nop                = 0x00,
+    DW_CFA_advance_loc1       = 0x02,
+    DW_CFA_advance_loc2       = 0x03,
+    DW_CFA_advance_loc4       = 0x04,
+    DW_CFA_offset_extended    = 0x05,
+    DW_CFA_restore_extended   = 0x06,
+    DW_CFA_undefined          = 0x07,
+    DW_CFA_same_value         = 0x08,
+    DW_CFA_remember_state     = 0x0a,
+    DW_CFA_restore_state      = 0x0b,
+    DW_CFA_def_cfa            = 0x0c,
+    DW_CFA_def_cfa_register   = 0x0d,
+    DW_CFA_def_cfa_offset     = 0x0e,
+    DW_CFA_offset_extended_sf = 0x11,
+    DW_CFA_advance_loc        = 0x40, // operand is embedded in the lower 6 bits
+    DW_CFA_offset             = 0x80, // register is embedded in the lower 6 bits
+    DW_CFA_restore            = 0xc0, // register is embedded in the lower 6 bits
+    DW_EH_PE_sdata4           = 0x0b,
+    DW_EH_PE_pcrel            = 0x10,
+};
+
+static const uint8_t CIE_VERSION = 1;
+static const char CIE_AUGMENTATION[] = "zR";
+static const Elf_Xword CODE_ALIGNMENT_FACTOR = 1;
+static const Elf_Sxword DATA_ALIGNMENT_FACTOR = -8;
+static const Elf_Word RETURN_ADDRESS_REGISTER = 16; // rip
+static const Elf_Word STACK_POINTER_REGISTER = 7;   // rsp
+static const Elf_Xword SECTION_ALIGNMENT = 8;
+static const Elf_Xword ENTRY_ALIGNMENT = 4;
+static const uint8_t EMBEDDED_OPERAND_LIMIT = 0x40;
+// DWARF numbers of registers from rax to rip
+static const Elf_Word dwarf_register_list[] = {0, 2, 1, 3, 7, 6, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+static SectionKind eh_frame_section = SC_UND;            // .eh_frame section (SC_UND if no directive is given)
+static CommonInformation *cie_list = NULL;               // CIEs in order of appearance
+static size_t cie_list_size = 0;                         // number of CIEs
+static FrameEntry *entry_list = NULL;                    // directives in order of addition
+static size_t entry_list_size = 0;                       // number of directives
+static size_t entry_list_capacity = 0;                   // capacity of directives
+static FrameState *remembered_state_list = NULL;         // stack of rules of CFA saved by .cfi_remember_state
+static size_t remembered_state_size = 0;                 // number of rules on the stack
+
+
+/*
+get DWARF number of a 64-bit general-purpose register or rip
+*/
+bool get_frame_register(RegisterKind reg, Elf_Word *number)
+{
+    if((reg < REG_RAX) || (reg > REG_RIP))
+    {
+        return false;
+    }
+
+    *number = dwarf_register_list[reg - REG_RAX];
+    return true;
+}
+
+
+/*
+make .eh_frame section when the first procedure is parsed
+* The section is made while parsing so that sections are ordered in the same way in one-pass mode.
+*/
+void prepare_eh_frame(void)
+{
+    if(eh_frame_section == SC_UND)
+    {
+        Section *eh_frame = make_section(".eh_frame", SHT_X86_64_UNWIND, SHF_ALLOC, 0);
+        eh_frame->alignment = SECTION_ALIGNMENT;
+        eh_frame_section = eh_frame->kind;
+    }
+}
+
+
+/*
+add a directive for call frame information after it is laid out
+*/
+void add_frame_directive(SectionKind section, Elf_Addr address, const FrameDirective *directive)
+{
+    if(entry_list_size == entry_list_capacity)
+    {
+        entry_list_capacity = (entry_list_capacity == 0) ? 64 : (entry_list_capacity * 2);
+        entry_list = realloc(entry_list, entry_list_capacity * sizeof(FrameEntry));
+    }
+
+    FrameEntry *entry = &entry_list[entry_list_size];
+    entry->section = section;
+    entry->address = address;
+    entry->directive = *directive;
+    entry_list_size++;
+}
+
+
+/*
+get offset of CIE with initial instructions, appending the CIE if it has not been made
+* Procedures with the same initial instructions share a CIE, and the instructions are deleted.
+*/
+static size_t get_cie_offset(ByteBufferType *instructions, ByteBufferType *buffer)
+{
+    for(size_t i = 0; i < cie_list_size; i++)
+    {
+        const ByteBufferType *cie_instructions = &cie_list[i].instructions;
+        if((cie_instructions->size == instructions->size) && (memcmp(cie_instructions->body, instructions->body, instructions->size) == 0))
+        {
+            free(instructions->body);
+            return cie_list[i].offset;
+        }
+    }
+
+    size_t offset = buffer->size;
+    cie_list = realloc(cie_list, (cie_list_size + 1) * sizeof(CommonInformation));
+    cie_list[cie_list_size].instructions = *instructions;
+    cie_list[cie_list_size].offset = offset;
+    cie_list_size++;
+    append_cie(instructions, buffer);
+
+    return offset;
+}
+
+
+/*
+append a CIE with initial instructions
+*/
+static void append_cie(const ByteBufferType *instructions, ByteBufferType *buffer)
+{
+    size_t start = buffer->size;
+    append_uint(0, sizeof(uint32_t), buffer); // length
+    append_uint(0, sizeof(uint32_t), buffer); // CIE_id
+    append_uint(CIE_VERSION, sizeof(uint8_t), buffer);
+    append_bytes(CIE_AUGMENTATION, sizeof(CIE_AUGMENTATION), buffer);
+    append_uleb128(CODE_ALIGNMENT_FACTOR, buffer);
+    append_sleb128(DATA_ALIGNMENT_FACTOR, buffer);
+    append_uleb128(RETURN_ADDRESS_REGISTER, buffer);
+    append_uleb128(sizeof(uint8_t), buffer); // augmentation data length
+    append_uint(DW_EH_PE_pcrel | DW_EH_PE_sdata4, sizeof(uint8_t), buffer);
+    append_bytes(instructions->body, instructions->size, buffer);
+    finish_entry(start, buffer);
+}
+
+
+/*
+check if a directive is placed at the top of a procedure and can be moved to the initial instructions of CIE
+*/
+static bool is_initial_instruction(const FrameEntry *entry, const FrameEntry *start)
+{
+    FrameDirectiveKind kind = entry->directive.kind;
+    return (entry->address == start->address) && (kind != FD_END_PROCEDURE) && (kind != FD_REMEMBER_STATE) && (kind != FD_RESTORE_STATE);
+}
+
+
+/*
+append an FDE for directives from .cfi_startproc to .cfi_endproc
+*/
+static void append_fde(const FrameEntry *entries, size_t size, Section *eh_frame)
+{
+    ByteBufferType *buffer = eh_frame->body;
+    const FrameEntry *start = &entries[0];
+    const FrameEntry *end = &entries[size - 1];
+
+    // initial instructions describe the frame at the entry of a procedure unless it is simple
+    ByteBufferType instructions = {NULL, 0, 0};
+    FrameState state = {STACK_POINTER_REGISTER, 0};
+    remembered_state_size = 0;
+    if(!start->directive.simple)
+    {
+        // CFA is just above the return address pushed by call instruction
+        FrameDirective directives[] = {
+            {FD_DEF_CFA, STACK_POINTER_REGISTER, -DATA_ALIGNMENT_FACTOR, false},
+            {FD_OFFSET, RETURN_ADDRESS_REGISTER, DATA_ALIGNMENT_FACTOR, false},
+        };
+        for(size_t i = 0; i < sizeof(directives) / sizeof(directives[0]); i++)
+        {
+            append_frame_instruction(&directives[i], &state, &instructions);
+        }
+    }
+    size_t index = 1;
+    while(is_initial_instruction(&entries[index], start))
+    {
+        append_frame_instruction(&entries[index].directive, &state, &instructions);
+        index++;
+    }
+    size_t cie_offset = get_cie_offset(&instructions, buffer);
+
+    size_t fde_start = buffer->size;
+    append_uint(0, sizeof(uint32_t), buffer); // length
+    append_uint(buffer->size - cie_offset, sizeof(uint32_t), buffer); // CIE_pointer
+
+    // the procedure is relocated by the section symbol relative to the address of the field
+    Elf_Rela rela = {buffer->size, ELF_R_INFO(get_section(start->section)->symtab_index, R_X86_64_PC32), start->address};
+    append_relocation_entry(&rela, eh_frame->rela_body);
+    append_uint(0, sizeof(uint32_t), buffer); // pc_begin
+    append_uint(end->address - start->address, sizeof(uint32_t), buffer); // pc_range
+    append_uleb128(0, buffer); // augmentation data length
+
+    Elf_Addr location = start->address;
+    for(size_t i = index; i < size - 1; i++)
+    {
+        if(entries[i].address != location)
+        {
+            append_advance_location(entries[i].address - location, buffer);
+            location = entries[i].address;
+        }
+        append_frame_instruction(&entries[i].directive, &state, buffer);
+    }
+
+    finish_entry(fde_start, buffer);
+}
+
+
+/*
+pad a CIE or FDE to the alignment and set its length
+*/
+static void finish_entry(size_t start, ByteBufferType *buffer)
+{
+    fill_bytes(DW_CFA_nop, align_to(buffer->size - start, ENTRY_ALIGNMENT) - (buffer->size - start), buffer);
+    patch_uint(start, buffer->size - start - sizeof(uint32_t), sizeof(uint32_t), buffer);
+}
+
+
+/*
+append an instruction advancing location by the smallest operand
+*/
+static void append_advance_location(Elf_Addr delta, ByteBufferType *buffer)
+{
+    if(delta < EMBEDDED_OPERAND_LIMIT)
+    {
+        append_uint(DW_CFA_advance_loc | delta, sizeof(uint8_t), buffer);
+    }
+    else if(delta <= UINT8_MAX)
+    {
+        append_uint(DW_CFA_advance_loc1, sizeof(uint8_t), buffer);
+        append_uint(delta, sizeof(uint8_t), buffer);
+    }
+    else if(delta <= UINT16_MAX)
+    {
+        append_uint(DW_CFA_advance_loc2, sizeof(uint8_t), buffer);
+        append_uint(delta, sizeof(uint16_t), buffer);
+    }
+    else
+    {
+        append_uint(DW_CFA_advance_loc4, sizeof(uint8_t), buffer);
+        append_uint(delta, sizeof(uint32_t), buffer);
+    }
+}
+
+
+/*
+append an instruction to save a register at an offset from CFA
+*/
+static void append_register_offset(Elf_Word reg, Elf_Sxword offset, ByteBufferType *buffer)
+{
+    if(offset % DATA_ALIGNMENT_FACTOR != 0)
+    {
+        fprintf(stderr, "offset %jd of register %u from CFA is not a multiple of %jd\n", (intmax_t)offset, reg, (intmax_t)-DATA_ALIGNMENT_FACTOR);
+        exit(EXIT_FAILURE);
+    }
+
+    Elf_Sxword factored_offset = offset / DATA_ALIGNMENT_FACTOR;
+    if(factored_offset < 0)
+    {
+        append_uint(DW_CFA_offset_extended_sf, sizeof(uint8_t), buffer);
+        append_uleb128(reg, buffer);
+        append_sleb128(factored_offset, buffer);
+    }
+    else if(reg < EMBEDDED_OPERAND_LIMIT)
+    {
+        append_uint(DW_CFA_offset | reg, sizeof(uint8_t), buffer);
+        append_uleb128(factored_offset, buffer);
+    }
+    else
+    {
+        append_uint(DW_CFA_offset_extended, sizeof(uint8_t), buffer);
+        append_uleb128(reg, buffer);
+        append_uleb128(factored_offset, buffer);
+    }
+}
+
+
+/*
+append an instruction to change offset of CFA
+*/
+static void append_cfa_offset(Elf_Sxword offset, ByteBufferType *buffer)
+{
+    if(offset < 0)
+    {
+        fprintf(stderr, "offset of CFA becomes negative (%jd)\n", (intmax_t)offset);
+        exit(EXIT_FAILURE);
+    }
+
+    append_uint(DW_CFA_def_cfa_offset, sizeof(uint8_t), buffer);
+    append_uleb128(offset, buffer);
+}
+
+
+/*
+append an instruction for a directive, tracking the rule of CFA
+*/
+static void append_frame_instruction(const FrameDirective *directive, FrameState *state, ByteBufferType *buffer)
+{
+    switch(directive->kind)
+    {
+    case FD_ADJUST_CFA_OFFSET:
+        state->offset += directive->offset;
+        append_cfa_offset(state->offset, buffer);
+        break;
+
+    case FD_DEF_CFA:
+        if(directive->offset < 0)
+        {
+            fprintf(stderr, "offset of CFA is negative (%jd)\n", (intmax_t)directive->offset);
+            exit(EXIT_FAILURE);
+        }
+        state->reg = directive->reg;
+        state->offset = directive->offset;
+        append_uint(DW_CFA_def_cfa, sizeof(uint8_t), buffer);
+        append_uleb128(state->reg, buffer);
+        append_uleb128(state->offset, buffer);
+        break;
+
+    case FD_DEF_CFA_OFFSET:
+        state->offset = directive->offset;
+        append_cfa_offset(state->offset, buffer);
+        break;
+
+    case FD_DEF_CFA_REGISTER:
+        state->reg = directive->reg;
+        append_uint(DW_CFA_def_cfa_register, sizeof(uint8_t), buffer);
+        append_uleb128(state->reg, buffer);
+        break;
+
+    case FD_OFFSET:
+        append_register_offset(directive->reg, directive->offset, buffer);
+        break;
+
+    case FD_REL_OFFSET:
+        // offset from CFA register is converted to that from CFA
+        append_register_offset(directive->reg, directive->offset - state->offset, buffer);
+        break;
+
+    case FD_REMEMBER_STATE:
+        remembered_state_list = realloc(remembered_state_list, (remembered_state_size + 1) * sizeof(FrameState));
+        remembered_state_list[remembered_state_size] = *state;
+        remembered_state_size++;
+        append_uint(DW_CFA_remember_state, sizeof(uint8_t), buffer);
+        break;
+
+    case FD_RESTORE:
+        if(directive->reg < EMBEDDED_OPERAND_LIMIT)
+        {
+            append_uint(DW_CFA_restore | directive->reg, sizeof(uint8_t), buffer);
+        }
+        else
+        {
+            append_uint(DW_CFA_restore_extended, sizeof(uint8_t), buffer);
+            append_uleb128(directive->reg, buffer);
+        }
+        break;
+
+    case FD_RESTORE_STATE:
+        if(remembered_state_size == 0)
+        {
+            fprintf(stderr, ".cfi_restore_state is not preceded by .cfi_remember_state\n");
+            exit(EXIT_FAILURE);
+        }
+        remembered_state_size--;
+        *state = remembered_state_list[remembered_state_size];
+        append_uint(DW_CFA_restore_state, sizeof(uint8_t), buffer);
+        break;
+
+    case FD_SAME_VALUE:
+        append_uint(DW_CFA_same_value, sizeof(uint8_t), buffer);
+        append_uleb128(directive->reg, buffer);
+        break;
+
+    case FD_UNDEFINED:
+        append_uint(DW_CFA_undefined, sizeof(uint8_t), buffer);
+        append_uleb128(directive->reg, buffer);
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+/*
+make contents of .eh_frame section and its relocations after symbol table indices of sections are set
+* Each procedure has its FDE, and procedures with the same initial instructions share a CIE.
+*/
+void make_eh_frame(void)
+{
+    if(eh_frame_section == SC_UND)
+    {
+        return;
+    }
+
+    if(entry_list[entry_list_size - 1].directive.kind != FD_END_PROCEDURE)
+    {
+        fprintf(stderr, "procedure is not terminated by .cfi_endproc\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Section *eh_frame = get_section(eh_frame_section);
+    size_t start = 0;
+    for(size_t i = 0; i < entry_list_size; i++)
+    {
+        if(entry_list[i].directive.kind == FD_START_PROCEDURE)
+        {
+            start = i;
+        }
+        else if(entry_list[i].directive.kind == FD_END_PROCEDURE)
+        {
+            append_fde(&entry_list[start], i - start + 1, eh_frame);
+        }
+    }
+
+    eh_frame->size = eh_frame->body->size;
+}
@@ -0,0 +1,45 @@
+#ifndef EH_FRAME_H
+#define EH_FRAME_H
+
+#include <stdbool.h>
+
+#include "elf_wrap.h"
+#include "processor.h"
+#include "section.h"
+
+typedef enum FrameDirectiveKind FrameDirectiveKind;
+typedef struct FrameDirective FrameDirective;
+
+// kind of directive for call frame information
+enum FrameDirectiveKind
+{
+    FD_ADJUST_CFA_OFFSET,  // .cfi_adjust_cfa_offset directive
+    FD_DEF_CFA,            // .cfi_def_cfa directive
+    FD_DEF_CFA_OFFSET,     // .cfi_def_cfa_offset directive
+    FD_DEF_CFA_REGISTER,   // .cfi_def_cfa_register directive
+    FD_END_PROCEDURE,      // .cfi_endproc directive
+    FD_OFFSET,             // .cfi_offset directive
+    FD_REL_OFFSET,         // .cfi_rel_offset directive
+    FD_REMEMBER_STATE,     // .cfi_remember_state directive
+    FD_RESTORE,            // .cfi_restore directive
+    FD_RESTORE_STATE,      // .cfi_restore_state directive
+    FD_SAME_VALUE,         // .cfi_same_value directive
+    FD_START_PROCEDURE,    // .cfi_startproc directive
+    FD_UNDEFINED,          // .cfi_undefined directive
+};
+
+// structure for directive for call frame information
+struct FrameDirective
+{
+    FrameDirectiveKind kind; // kind of directive
+    Elf_Word reg;            // DWARF number of register
+    Elf_Sxword offset;       // offset from CFA or CFA register, or adjustment of CFA offset
+    bool simple;             // flag indicating that the procedure starts without the initial instructions (only for .cfi_startproc)
+};
+
+bool get_frame_register(RegisterKind reg, Elf_Word *number);
+void prepare_eh_frame(void);
+void add_frame_directive(SectionKind section, Elf_Addr address, const FrameDirective *directive);
+void make_eh_frame(void);
+
+#endif /* !EH_FRAME_H */
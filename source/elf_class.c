@@ -0,0 +1,181 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "elf_class.h"
+#include "option.h"
+#include "output.h"
+
+
+/*
+check if an object of ELFCLASS32 is generated for the x32 ABI
+* ELF structures are made in their 64-bit forms, and converted into the 32-bit forms when they are written.
+*/
+bool is_elf_class32(void)
+{
+    return get_option()->x32;
+}
+
+
+/*
+get class of object file
+*/
+unsigned char get_elf_class(void)
+{
+    return is_elf_class32() ? ELFCLASS32 : ELFCLASS64;
+}
+
+
+/*
+get size of address, which is also the alignment of symbol and relocation tables
+*/
+size_t get_address_size(void)
+{
+    return is_elf_class32() ? sizeof(Elf32_Addr) : sizeof(Elf64_Addr);
+}
+
+
+/*
+get size of ELF header
+*/
+size_t get_ehdr_size(void)
+{
+    return is_elf_class32() ? sizeof(Elf32_Ehdr) : sizeof(Elf64_Ehdr);
+}
+
+
+/*
+get size of section header table entry
+*/
+size_t get_shdr_size(void)
+{
+    return is_elf_class32() ? sizeof(Elf32_Shdr) : sizeof(Elf64_Shdr);
+}
+
+
+/*
+get size of symbol table entry
+*/
+size_t get_sym_size(void)
+{
+    return is_elf_class32() ? sizeof(Elf32_Sym) : sizeof(Elf64_Sym);
+}
+
+
+/*
+get size of relocation table entry
+*/
+size_t get_rela_size(void)
+{
+    return is_elf_class32() ? sizeof(Elf32_Rela) : sizeof(Elf64_Rela);
+}
+
+
+/*
+append a symbol table entry
+*/
+void append_symbol_entry(const Elf_Sym *sym, ByteBufferType *buffer)
+{
+    if(!is_elf_class32())
+    {
+        append_bytes((const char *)sym, sizeof(Elf64_Sym), buffer);
+        return;
+    }
+
+    if((sym->st_value > UINT32_MAX) || (sym->st_size > UINT32_MAX))
+    {
+        fprintf(stderr, "value or size of symbol is out of range of ELFCLASS32\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Elf32_Sym sym32;
+    sym32.st_name = sym->st_name;
+    sym32.st_value = sym->st_value;
+    sym32.st_size = sym->st_size;
+    sym32.st_info = sym->st_info;
+    sym32.st_other = sym->st_other;
+    sym32.st_shndx = sym->st_shndx;
+    append_bytes((const char *)&sym32, sizeof(sym32), buffer);
+}
+
+
+/*
+append a relocation table entry, whose information is made by ELF_R_INFO
+*/
+void append_relocation_entry(const Elf_Rela *rela, ByteBufferType *buffer)
+{
+    if(!is_elf_class32())
+    {
+        append_bytes((const char *)rela, sizeof(Elf64_Rela), buffer);
+        return;
+    }
+
+    Elf_Xword sym = ELF_R_SYM(rela->r_info);
+    if((rela->r_offset > UINT32_MAX) || (sym > (UINT32_MAX >> 8)) || (rela->r_addend < INT32_MIN) || (rela->r_addend > INT32_MAX))
+    {
+        fprintf(stderr, "relocation is out of range of ELFCLASS32\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Elf32_Rela rela32;
+    rela32.r_offset = rela->r_offset;
+    rela32.r_info = ELF32_R_INFO(sym, ELF_R_TYPE(rela->r_info));
+    rela32.r_addend = rela->r_addend;
+    append_bytes((const char *)&rela32, sizeof(rela32), buffer);
+}
+
+
+/*
+output ELF header
+*/
+void output_elf_header(const Elf_Ehdr *ehdr, FILE *fp)
+{
+    if(!is_elf_class32())
+    {
+        output_buffer(ehdr, sizeof(Elf64_Ehdr), fp);
+        return;
+    }
+
+    Elf32_Ehdr ehdr32;
+    memcpy(ehdr32.e_ident, ehdr->e_ident, EI_NIDENT);
+    ehdr32.e_type = ehdr->e_type;
+    ehdr32.e_machine = ehdr->e_machine;
+    ehdr32.e_version = ehdr->e_version;
+    ehdr32.e_entry = ehdr->e_entry;
+    ehdr32.e_phoff = ehdr->e_phoff;
+    ehdr32.e_shoff = ehdr->e_shoff;
+    ehdr32.e_flags = ehdr->e_flags;
+    ehdr32.e_ehsize = ehdr->e_ehsize;
+    ehdr32.e_phentsize = ehdr->e_phentsize;
+    ehdr32.e_phnum = ehdr->e_phnum;
+    ehdr32.e_shentsize = ehdr->e_shentsize;
+    ehdr32.e_shnum = ehdr->e_shnum;
+    ehdr32.e_shstrndx = ehdr->e_shstrndx;
+    output_buffer(&ehdr32, sizeof(ehdr32), fp);
+}
+
+
+/*
+output a section header table entry
+*/
+void output_section_header(const Elf_Shdr *shdr, FILE *fp)
+{
+    if(!is_elf_class32())
+    {
+        output_buffer(shdr, sizeof(Elf64_Shdr), fp);
+        return;
+    }
+
+    Elf32_Shdr shdr32;
+    shdr32.sh_name = shdr->sh_name;
+    shdr32.sh_type = shdr->sh_type;
+    shdr32.sh_flags = shdr->sh_flags;
+    shdr32.sh_addr = shdr->sh_addr;
+    shdr32.sh_offset = shdr->sh_offset;
+    shdr32.sh_size = shdr->sh_size;
+    shdr32.sh_link = shdr->sh_link;
+    shdr32.sh_info = shdr->sh_info;
+    shdr32.sh_addralign = shdr->sh_addralign;
+    shdr32.sh_entsize = shdr->sh_entsize;
+    output_buffer(&shdr32, sizeof(shdr32), fp);
+}
@@ -0,0 +1,23 @@
+#ifndef ELF_CLASS_H
+#define ELF_CLASS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "buffer.h"
+#include "elf_wrap.h"
+
+bool is_elf_class32(void);
+unsigned char get_elf_class(void);
+size_t get_address_size(void);
+size_t get_ehdr_size(void);
+size_t get_shdr_size(void);
+size_t get_sym_size(void);
+size_t get_rela_size(void);
+void append_symbol_entry(const Elf_Sym *sym, ByteBufferType *buffer);
+void append_relocation_entry(const Elf_Rela *rela, ByteBufferType *buffer);
+void output_elf_header(const Elf_Ehdr *ehdr, FILE *fp);
+void output_section_header(const Elf_Shdr *shdr, FILE *fp);
+
+#endif /* !ELF_CLASS_H */
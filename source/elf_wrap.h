@@ -3,7 +3,6 @@
 
 #include <elf.h>
 
-#define ELF_CLASS          ELFCLASS64
 #define ELF_DATA           ELFDATA2LSB
 #define ELF_R_INFO         ELF64_R_INFO
 #define ELF_R_SYM          ELF64_R_SYM
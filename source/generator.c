@@ -4,17 +4,47 @@
 #include <string.h>
 
 #include "buffer.h"
+#include "debug_line.h"
+#include "eh_frame.h"
+#include "elf_class.h"
 #include "elf_wrap.h"
 #include "generator.h"
+#include "map.h"
+#include "note_property.h"
+#include "option.h"
 #include "output.h"
 #include "parser.h"
 #include "processor.h"
 #include "section.h"
+#include "string_table.h"
 #include "symbol.h"
 
+typedef struct SymbolBinding SymbolBinding;
+
+// structure for binding of a name to its label and symbols
+struct SymbolBinding
+{
+    const Label *label;        // label of the name (NULL if not labeled)
+    Elf_Addr address;          // address of the statement marked by the label
+    SectionKind section;       // section of the statement marked by the label
+    const Symbol *declaration; // the first declaration of the name (NULL if not declared)
+    const Symbol *classified;  // symbol registered to the symbol table by the name (NULL if not registered yet)
+    List(Symbol) *fixups;      // references waiting for the label to be defined in one-pass mode (NULL if none)
+    const Symbol *reference;   // the first reference which waited for the label in one-pass mode (NULL if none)
+    bool resolved;             // flag indicating that a reference is resolved to relative address of the label
+    unsigned char type;        // type of symbol given by .type directive
+    bool tls;                  // flag indicating that the symbol is referred as a variable in TLS
+    unsigned char visibility;  // visibility of symbol given by .hidden, .internal or .protected directive
+    Elf_Xword size;            // size of symbol given by .size directive
+};
+
+define_map(SymbolBinding)
+define_map_operations(SymbolBinding)
+
 static void set_reloc_info(SectionKind located, Elf_Sxword addend, Symbol *symbol);
 static void set_elf_header
 (
+    unsigned char ei_osabi,
     Elf_Off e_shoff,
     Elf_Half e_shnum,
     Elf_Half e_shstrndx,
@@ -25,7 +55,7 @@ static void set_symbol_table
     Elf_Word st_name,
     unsigned char st_info,
     unsigned char st_other,
-    Elf_Section st_shndx,
+    Elf_Word st_shndx,
     Elf_Addr st_value,
     Elf_Xword st_size
 );
@@ -37,26 +67,63 @@ static void set_relocation_table
     ByteBufferType *rela_body
 );
 static void set_symbol_table_entries(void);
+static void set_symtab_indices(void);
 static Elf_Xword get_symtab_index(const Symbol *symbol);
+static bool is_executable_section(SectionKind kind);
+static bool is_mergeable_section(SectionKind kind);
+static unsigned char get_symbol_type(const Symbol *symbol, const SymbolBinding *binding);
+static bool is_symbol_reference(const Symbol *symbol);
+static bool is_tls_reference(const Symbol *symbol);
+static bool is_relocated_by_section(const Symbol *symbol);
+static Elf_Xword get_relocation_type(const Symbol *symbol);
 static void set_relocation_table_entries(void);
+static int compare_reloc_symbols(const void *symbol1, const void *symbol2);
+static void sort_reloc_symbol_list(void);
+static void set_appeared_section(const Statement *statement);
+static bool is_crossing_boundary(Elf_Addr start, Elf_Addr end, Elf_Xword boundary);
+static Statement *get_aligned_branch_head(Statement *previous, Statement *statement);
+static void align_branch(Statement *head, Statement *tail, Section *section);
+static void generate_statement(Statement *previous, Statement *statement);
 static void generate_statement_list(const List(Statement) *statement_list);
+static void delete_statement(Statement *statement);
+static SymbolBinding *get_symbol_binding(const char *name);
+static void define_label(const Label *label);
+static void declare_symbol(const Symbol *symbol);
+static void make_symbol_binding_map(const List(Symbol) *symbol_list, const List(Label) *label_list);
+static void set_symbol_attributes(const List(Statement) *statement_list);
+static void add_debug_information(const List(Statement) *statement_list);
 static void update_symbol_list(Symbol *symbol);
-static void classify_symbol_list(const List(Symbol) *symbol_list, const List(Label) *label_list);
-static void resolve_symbols(const List(Symbol) *symbol_list, const List(Label) *label_list);
-static void generate_sections(const Program *program);
+static void classify_symbol_list(const List(Symbol) *symbol_list);
+static void classify_group_signatures(void);
+static void resolve_relative_address(Elf_Addr label_address, const Symbol *symbol);
+static bool resolve_symbol(Symbol *symbol, SymbolBinding *binding);
+static void resolve_symbols(const List(Symbol) *symbol_list);
+static void resolve_reference(Symbol *symbol);
+static void resolve_undefined_references(void);
+static void retire_fragment(Program *fragment);
+static void consume_fragment(Program *fragment);
+static void generate_sections(const List(Symbol) *symbol_list);
 static void generate_elf_header(Elf_Ehdr *ehdr);
-
-static const size_t RESERVED_SYMTAB_ENTRIES = 4; // number of reserved symbol table entries (undefined, .text, .data, .bss)
-static const Elf_Xword SYMTAB_INDEX_DATA = 2;    // index of symbol table entry for .data section
-static const Elf_Xword SYMTAB_INDEX_BSS = 3;     // index of symbol table entry for .bss section
+static void initialize_generator(void);
+static void output_object_file(const char *output_file);
 
 static List(Symbol) *local_symbol_list;  // list of local symbols
 static List(Symbol) *global_symbol_list; // list of global symbols
 static List(Symbol) *reloc_symbol_list;  // list of relocatable symbols
+static Map(SymbolBinding) *symbol_binding_map; // map from name to its label and symbols
+static List(Symbol) *retained_symbol_list; // list of labels, declarations, references and names given visibility to be classified in one-pass mode
 
-static ByteBufferType symtab_body = {NULL, 0, 0};    // buffer for section ".symtab"
-static ByteBufferType strtab_body = {NULL, 0, 0};    // buffer for string containing names of symbols
-static ByteBufferType shstrtab_body = {NULL, 0, 0};  // buffer for string containing names of sections
+static Program held_fragment = {NULL, NULL, NULL}; // fragment retired after the next statement is generated in one-pass mode
+static Statement *previous_statement = NULL;       // statement generated last in one-pass mode
+
+static ByteBufferType symtab_body = {NULL, 0, 0};       // buffer for section ".symtab"
+static ByteBufferType symtab_shndx_body = {NULL, 0, 0}; // buffer for section ".symtab_shndx"
+static ByteBufferType strtab_body = {NULL, 0, 0};       // buffer for string containing names of symbols
+static ByteBufferType shstrtab_body = {NULL, 0, 0};     // buffer for string containing names of sections
+
+static size_t padded_branch_count = 0;  // number of branches padded not to cross the boundary
+static size_t local_symtab_entries = 0; // number of local symbol table entries including the undefined symbol and sections
+static bool has_gnu_ifunc = false;      // flag indicating that the symbol table has an indirect function, which is specific to GNU ABI
 
 
 /*
@@ -75,6 +142,7 @@ set members of an ELF header
 */
 static void set_elf_header
 (
+    unsigned char ei_osabi,
     Elf_Off e_shoff,
     Elf_Half e_shnum,
     Elf_Half e_shstrndx,
@@ -85,10 +153,10 @@ static void set_elf_header
     ehdr->e_ident[EI_MAG1] = ELFMAG1;
     ehdr->e_ident[EI_MAG2] = ELFMAG2;
     ehdr->e_ident[EI_MAG3] = ELFMAG3;
-    ehdr->e_ident[EI_CLASS] = ELF_CLASS;
+    ehdr->e_ident[EI_CLASS] = get_elf_class();
     ehdr->e_ident[EI_DATA] = ELF_DATA;
     ehdr->e_ident[EI_VERSION] = EV_CURRENT;
-    ehdr->e_ident[EI_OSABI] = ELFOSABI_NONE;
+    ehdr->e_ident[EI_OSABI] = ei_osabi;
     ehdr->e_ident[EI_ABIVERSION] = 0;
 
     ehdr->e_type = ET_REL;
@@ -99,10 +167,10 @@ static void set_elf_header
     ehdr->e_phoff = 0;
     ehdr->e_shoff = e_shoff;
     ehdr->e_flags = 0;
-    ehdr->e_ehsize = sizeof(Elf_Ehdr);
+    ehdr->e_ehsize = get_ehdr_size();
     ehdr->e_phentsize = 0;
     ehdr->e_phnum = 0;
-    ehdr->e_shentsize = sizeof(Elf_Shdr);
+    ehdr->e_shentsize = get_shdr_size();
     ehdr->e_shnum = e_shnum;
     ehdr->e_shstrndx = e_shstrndx;
 }
@@ -116,7 +184,7 @@ static void set_symbol_table
     Elf_Word st_name,
     unsigned char st_info,
     unsigned char st_other,
-    Elf_Section st_shndx,
+    Elf_Word st_shndx,
     Elf_Addr st_value,
     Elf_Xword st_size
 )
@@ -127,12 +195,19 @@ static void set_symbol_table
     sym.st_name = st_name;
     sym.st_info = st_info;
     sym.st_other = st_other;
-    sym.st_shndx = st_shndx;
+    sym.st_shndx = (st_shndx < SHN_LORESERVE) ? st_shndx : SHN_XINDEX;
     sym.st_value = st_value;
     sym.st_size = st_size;
 
     // update buffer
-    append_bytes((char *)&sym, sizeof(sym), &symtab_body);
+    append_symbol_entry(&sym, &symtab_body);
+
+    // section header indices out of the range of st_shndx are held in .symtab_shndx section
+    if(get_section(SC_SYMTAB_SHNDX) != NULL)
+    {
+        Elf_Word shndx = (st_shndx < SHN_LORESERVE) ? SHN_UNDEF : st_shndx;
+        append_bytes((char *)&shndx, sizeof(shndx), &symtab_shndx_body);
+    }
 }
 
 
@@ -155,7 +230,7 @@ static void set_relocation_table
     rela.r_addend = r_addend;
 
     // update buffer
-    append_bytes((char *)&rela, sizeof(rela), rela_body);
+    append_relocation_entry(&rela, rela_body);
 }
 
 
@@ -174,91 +249,251 @@ static void set_symbol_table_entries(void)
         0
     );
 
-    // .text section
-    set_symbol_table(
-        0,
-        ELF_ST_INFO(STB_LOCAL, STT_SECTION),
-        0,
-        get_section(SC_TEXT)->index,
-        0,
-        0
-    );
-
-    // .data section
-    set_symbol_table(
-        0,
-        ELF_ST_INFO(STB_LOCAL, STT_SECTION),
-        0,
-        get_section(SC_DATA)->index,
-        0,
-        0
-    );
-
-    // .bss section
-    set_symbol_table(
-        0,
-        ELF_ST_INFO(STB_LOCAL, STT_SECTION),
-        0,
-        get_section(SC_BSS)->index,
-        0,
-        0
-    );
-
-    // put '\0' for invalid symbols at first
-    append_bytes("\x00", 1, &strtab_body);
-    Elf_Word st_name = 1;
+    // sections
+    for_each_entry(Section, cursor, get_section_list())
+    {
+        const Section *section = get_element(Section)(cursor);
+        if(section->symtab_index != 0)
+        {
+            set_symbol_table(
+                0,
+                ELF_ST_INFO(STB_LOCAL, STT_SECTION),
+                0,
+                section->index,
+                0,
+                0
+            );
+        }
+    }
 
+    // names of symbols are deduplicated and merged into the others ending with them
     const List(Symbol) *symbol_lists[] = {local_symbol_list, global_symbol_list};
     const size_t size = sizeof(symbol_lists) / sizeof(symbol_lists[0]);
+    StringTable *strtab = new_string_table();
+    for(size_t i = 0; i < size; i++)
+    {
+        for_each_entry(Symbol, cursor, symbol_lists[i])
+        {
+            add_string(strtab, get_element(Symbol)(cursor)->body);
+        }
+    }
+    build_string_table(strtab, &strtab_body);
+
     for(size_t i = 0; i < size; i++)
     {
         const List(Symbol) *symbol_list = symbol_lists[i];
         for_each_entry(Symbol, cursor, symbol_list)
         {
             const Symbol *symbol = get_element(Symbol)(cursor);
-            const char *body = symbol->body;
+            const SymbolBinding *binding = get_symbol_binding(symbol->body);
+            unsigned char type = get_symbol_type(symbol, binding);
+            has_gnu_ifunc |= (type == STT_GNU_IFUNC);
             set_symbol_table(
-                st_name,
-                ELF_ST_INFO(symbol->bind, STT_NOTYPE),
-                0,
+                get_string_offset(strtab, symbol->body),
+                ELF_ST_INFO(symbol->bind, type),
+                binding->visibility,
                 get_section(symbol->located)->index,
                 symbol->value,
-                0
+                binding->size
             );
-            append_bytes(body, strlen(body) + 1, &strtab_body);
-            st_name += strlen(body) + 1;
         }
     }
 }
 
 
+/*
+set index of symbol table entry to each section and symbol registered to the symbol table
+* Sections are followed by local symbols and global symbols after the undefined symbol.
+*/
+static void set_symtab_indices(void)
+{
+    Elf_Xword sym_index = 1;
+    for_each_entry(Section, cursor, get_section_list())
+    {
+        Section *section = get_element(Section)(cursor);
+        if((section->kind != SC_UND) && (section->type != SHT_GROUP))
+        {
+            section->symtab_index = sym_index;
+            sym_index++;
+        }
+    }
+
+    for_each_entry(Symbol, cursor, local_symbol_list)
+    {
+        get_element(Symbol)(cursor)->symtab_index = sym_index;
+        sym_index++;
+    }
+    local_symtab_entries = sym_index;
+
+    for_each_entry(Symbol, cursor, global_symbol_list)
+    {
+        get_element(Symbol)(cursor)->symtab_index = sym_index;
+        sym_index++;
+    }
+
+    // sh_info of group section holds symbol table index of its signature
+    for_each_entry(Group, cursor, get_group_list())
+    {
+        Group *group = get_element(Group)(cursor);
+        group->section->info = get_symbol_binding(group->signature)->classified->symtab_index;
+    }
+}
+
+
 /*
 get index of symbol table entry for relocatable symbol
 */
 static Elf_Xword get_symtab_index(const Symbol *symbol)
 {
-    if(symbol->located == SC_DATA)
+    if(is_relocated_by_section(symbol))
     {
-        return SYMTAB_INDEX_DATA;
+        return get_section(symbol->located)->symtab_index;
     }
-    else if(symbol->located == SC_BSS)
+    else
     {
-        return SYMTAB_INDEX_BSS;
+        return get_symbol_binding(symbol->body)->classified->symtab_index;
     }
-    else
+}
+
+
+/*
+check if a section is executable
+*/
+static bool is_executable_section(SectionKind kind)
+{
+    return (get_section(kind)->flags & SHF_EXECINSTR) != 0;
+}
+
+
+/*
+check if a section is mergeable
+* The linker merges entries of such sections individually, so that offsets in the sections are not preserved.
+*/
+static bool is_mergeable_section(SectionKind kind)
+{
+    return (get_section(kind)->flags & (SHF_MERGE | SHF_STRINGS)) != 0;
+}
+
+
+/*
+get type of symbol registered to the symbol table
+* Objects in TLS sections and undefined symbols referred as variables in TLS are typed as TLS, since the linker rejects TLS references to the other types.
+*/
+static unsigned char get_symbol_type(const Symbol *symbol, const SymbolBinding *binding)
+{
+    bool in_tls_section = (symbol->located != SC_UND) && ((get_section(symbol->located)->flags & SHF_TLS) != 0);
+    if((in_tls_section && (binding->type == STT_OBJECT)) || ((in_tls_section || binding->tls) && (binding->type == STT_NOTYPE)))
+    {
+        return STT_TLS;
+    }
+
+    return binding->type;
+}
+
+
+/*
+check if a symbol refers to its GOT entry or its offset in TLS, which are made for the symbol itself
+*/
+static bool is_symbol_reference(const Symbol *symbol)
+{
+    switch(symbol->suffix)
+    {
+    case RS_GOTPCREL:
+    case RS_GOTPCRELX:
+    case RS_REX_GOTPCRELX:
+        return true;
+
+    default:
+        return is_tls_reference(symbol);
+    }
+}
+
+
+/*
+check if a symbol refers to its offset in TLS
+*/
+static bool is_tls_reference(const Symbol *symbol)
+{
+    switch(symbol->suffix)
+    {
+    case RS_DTPOFF:
+    case RS_GOTTPOFF:
+    case RS_TPOFF:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+/*
+check if a relocatable symbol is relocated by the section where it is located
+* GOT entries and offsets in TLS are made for symbols themselves, since their addends apply to the entries and the offsets.
+* Labels in mergeable sections are also relocated by themselves, since the linker cannot map offsets in the sections to merged entries.
+*/
+static bool is_relocated_by_section(const Symbol *symbol)
+{
+    return (symbol->located != SC_UND) && !is_executable_section(symbol->located) && !is_mergeable_section(symbol->located) && !is_symbol_reference(symbol);
+}
+
+
+/*
+get type of relocation for relocatable symbol
+* Branches to sections are relocated without PLT as GNU assembler does.
+*/
+static Elf_Xword get_relocation_type(const Symbol *symbol)
+{
+    switch(symbol->suffix)
     {
-        Elf_Xword sym_index = RESERVED_SYMTAB_ENTRIES + get_length(Symbol)(local_symbol_list);
-        for_each_entry(Symbol, cursor, global_symbol_list)
+    case RS_GOTPCREL:
+        return R_X86_64_GOTPCREL;
+
+    case RS_GOTPCRELX:
+        return R_X86_64_GOTPCRELX;
+
+    case RS_REX_GOTPCRELX:
+        return R_X86_64_REX_GOTPCRELX;
+
+    case RS_DTPOFF:
+        return R_X86_64_DTPOFF32;
+
+    case RS_GOTTPOFF:
+        return R_X86_64_GOTTPOFF;
+
+    case RS_TPOFF:
+        return R_X86_64_TPOFF32;
+
+    case RS_PLT:
+        if(!is_relocated_by_section(symbol))
         {
-            Symbol *global_symbol = get_element(Symbol)(cursor);
-            if(strcmp(symbol->body, global_symbol->body) == 0)
-            {
-                break;
-            }
-            sym_index++;
+            return R_X86_64_PLT32;
         }
+        break;
+
+    default:
+        break;
+    }
+
+    if(symbol->relative)
+    {
+        return (symbol->reloc_size == SIZEOF_8BIT) ? R_X86_64_PC8 : R_X86_64_PC32;
+    }
+
+    // absolute addresses are given by data, whose sizes select the relocations (e.g. pointers in .long for x32)
+    switch(symbol->reloc_size)
+    {
+    case SIZEOF_8BIT:
+        return R_X86_64_8;
+
+    case SIZEOF_16BIT:
+        return R_X86_64_16;
+
+    case SIZEOF_32BIT:
+        return R_X86_64_32;
 
-        return sym_index;
+    default:
+        return R_X86_64_64;
     }
 }
 
@@ -272,7 +507,7 @@ static void set_relocation_table_entries(void)
     {
         Symbol *symbol = get_element(Symbol)(cursor);
         Elf_Xword sym = get_symtab_index(symbol);
-        Elf_Xword type = (symbol->appeared == SC_TEXT) ? R_X86_64_PC32 : R_X86_64_64;
+        Elf_Xword type = get_relocation_type(symbol);
         set_relocation_table(
             symbol->address,
             ELF_R_INFO(sym, type),
@@ -283,6 +518,85 @@ static void set_relocation_table_entries(void)
 }
 
 
+/*
+compare relocatable symbols by section and address where they appeared
+*/
+static int compare_reloc_symbols(const void *symbol1, const void *symbol2)
+{
+    const Symbol *reloc1 = *(Symbol * const *)symbol1;
+    const Symbol *reloc2 = *(Symbol * const *)symbol2;
+    if(reloc1->appeared != reloc2->appeared)
+    {
+        return (reloc1->appeared < reloc2->appeared) ? -1 : 1;
+    }
+    if(reloc1->address != reloc2->address)
+    {
+        return (reloc1->address < reloc2->address) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+
+/*
+sort list of relocatable symbols by address, since relocations are not made in order of appearance in one-pass mode
+*/
+static void sort_reloc_symbol_list(void)
+{
+    size_t size = get_length(Symbol)(reloc_symbol_list);
+    Symbol **symbols = calloc(size, sizeof(Symbol *));
+    size_t i = 0;
+    for_each_entry(Symbol, cursor, reloc_symbol_list)
+    {
+        symbols[i] = get_element(Symbol)(cursor);
+        i++;
+    }
+    qsort(symbols, size, sizeof(Symbol *), compare_reloc_symbols);
+
+    delete_list(Symbol)(reloc_symbol_list);
+    reloc_symbol_list = new_list(Symbol)();
+    for(i = 0; i < size; i++)
+    {
+        add_list_entry_tail(Symbol)(reloc_symbol_list, symbols[i]);
+    }
+    free(symbols);
+}
+
+
+/*
+set section where symbols referred by a statement appeared
+*/
+static void set_appeared_section(const Statement *statement)
+{
+    switch(statement->kind)
+    {
+    case ST_INSTRUCTION:
+        if(statement->operation->operands != NULL)
+        {
+            for_each_entry(Operand, cursor, statement->operation->operands)
+            {
+                Symbol *symbol = get_element(Operand)(cursor)->symbol;
+                if(symbol != NULL)
+                {
+                    symbol->appeared = statement->section;
+                }
+            }
+        }
+        break;
+
+    case ST_VALUE:
+        if(statement->data->kind == DT_SYMBOL)
+        {
+            statement->data->symbol->appeared = statement->section;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+
 /*
 update section
 */
@@ -318,156 +632,642 @@ static void update_section(Statement *statement, Section *section)
         section_size = section->size + statement->bss->size;
         break;
 
+    case ST_ATTRIBUTE:
+    case ST_FRAME:
+        section_size = section->size;
+        break;
+
     default:
         assert(0);
         break;
     }
 
     section->size = section_size;
+    set_appeared_section(statement);
 }
 
 
 /*
-generate statement list
+check if a range of addresses crosses or ends on a boundary
 */
-static void generate_statement_list(const List(Statement) *statement_list)
+static bool is_crossing_boundary(Elf_Addr start, Elf_Addr end, Elf_Xword boundary)
 {
-    for_each_entry(Statement, cursor, statement_list)
-    {
-        Statement *statement = get_element(Statement)(cursor);
-        Section *section = get_section(statement->section);
-        update_section(statement, section);
-    }
+    return (start / boundary) != (end / boundary);
 }
 
 
 /*
-update list of symbols
+get the first statement of a branch to be aligned, or NULL if the statement is not such a branch
 */
-static void update_symbol_list(Symbol *symbol)
+static Statement *get_aligned_branch_head(Statement *previous, Statement *statement)
 {
-    add_list_entry_tail(Symbol)((symbol->bind == STB_LOCAL) ? local_symbol_list : global_symbol_list, symbol);
+    const Option *option = get_option();
+    if((option->align_branch_boundary == 0) || (statement->kind != ST_INSTRUCTION))
+    {
+        return NULL;
+    }
+
+    BranchKind kind = get_branch_kind(statement->operation);
+    if((option->align_branch_kinds & BR_FUSED) && (kind == BR_JCC) && (statement->alignment == 1) && (previous != NULL))
+    {
+        // a fused pair is aligned as a whole
+        if((previous->kind == ST_INSTRUCTION) && (previous->section == statement->section) && is_fused_operation_pair(previous->operation, statement->operation))
+        {
+            return previous;
+        }
+    }
+
+    return (option->align_branch_kinds & kind) ? statement : NULL;
 }
 
 
 /*
-classify list of symbols
+insert NOPs before a branch so that the branch neither crosses nor ends on the boundary
 */
-static void classify_symbol_list(const List(Symbol) *symbol_list, const List(Label) *label_list)
+static void align_branch(Statement *head, Statement *tail, Section *section)
 {
-    for_each_entry(Symbol, cursor, symbol_list)
+    Elf_Xword boundary = get_option()->align_branch_boundary;
+    Elf_Addr start = head->address;
+    if(section->alignment < boundary)
     {
-        Symbol *symbol = get_element(Symbol)(cursor);
-        const char *body = symbol->body;
-        if((search_symbol(local_symbol_list, body) != NULL) || (search_symbol(global_symbol_list, body) != NULL))
-        {
-            continue;
-        }
-
-        if(!(symbol->labeled || symbol->declared))
-        {
-            if(search_label(label_list, symbol) == NULL)
-            {
-                symbol->bind = STB_GLOBAL;
-                update_symbol_list(symbol);
-            }
-        }
-        else
-        {
-            unsigned char bind = STB_GLOBAL;
-            if(symbol->labeled)
-            {
-                const Symbol *declaration = search_symbol_declaration(symbol_list, body);
-                bind = (declaration == NULL) ? STB_LOCAL : declaration->bind;
-            }
-            else
-            {
-                bind = symbol->bind;
-            }
+        // section is aligned to the boundary so that branches keep their positions relative to it after linking
+        section->alignment = boundary;
+    }
+    if(!is_crossing_boundary(start, section->size, boundary))
+    {
+        return;
+    }
 
-            Label *label = search_label(label_list, symbol);
-            symbol->value = label->statement->address;
-            symbol->located = label->statement->section;
-            symbol->bind = bind;
-            update_symbol_list(symbol);
-        }
+    // discard the branch and generate it again after padding
+    // since branches have fixed sizes, statements already laid out are never moved
+    ByteBufferType *body = section->body;
+    body->size = start;
+    generate_nop_padding(align_to(start, boundary) - start, body);
+    section->size = body->size;
+    update_section(head, section);
+    if(tail != head)
+    {
+        update_section(tail, section);
     }
+    padded_branch_count++;
 }
 
 
 /*
-resolve symbols
+generate a statement following the previous one (NULL if it is the first statement)
 */
-static void resolve_symbols(const List(Symbol) *symbol_list, const List(Label) *label_list)
+static void generate_statement(Statement *previous, Statement *statement)
 {
-    for_each_entry(Symbol, symbol_cursor, symbol_list)
+    Section *section = get_section(statement->section);
+    update_section(statement, section);
+
+    Statement *head = get_aligned_branch_head(previous, statement);
+    if(head != NULL)
     {
-        Symbol *symbol = get_element(Symbol)(symbol_cursor);
-        if(symbol->labeled || symbol->declared)
-        {
-            continue;
-        }
+        align_branch(head, statement, section);
+    }
+}
 
-        const char *body = symbol->body;
-        bool resolved = false;
-        for_each_entry(Label, label_cursor, label_list)
-        {
-            Label *label = get_element(Label)(label_cursor);
-            if(strcmp(label->symbol->body, body) == 0)
-            {
-                Elf_Addr label_address = label->statement->address;
-                SectionKind label_section = label->statement->section;
-                switch(label_section)
-                {
-                case SC_TEXT:
-                    if(search_symbol(global_symbol_list, body) != NULL)
-                    {
-                        set_reloc_info(label_section, -sizeof(uint32_t), symbol);
-                    }
-                    else
-                    {
-                        uint32_t *reloc_target = (uint32_t *)&get_section(SC_TEXT)->body->body[symbol->address];
-                        *reloc_target = label_address - (symbol->address + sizeof(uint32_t));
-                    }
-                    break;
-
-                case SC_DATA:
-                case SC_BSS:
-                    set_reloc_info(label_section, symbol->addend + label_address, symbol);
-                    break;
-
-                default:
-                    assert(0);
-                    break;
-                }
 
-                resolved = true;
-                break;
+/*
+generate statement list
+*/
+static void generate_statement_list(const List(Statement) *statement_list)
+{
+    Statement *previous = NULL;
+    for_each_entry(Statement, cursor, statement_list)
+    {
+        Statement *statement = get_element(Statement)(cursor);
+        generate_statement(previous, statement);
+        previous = statement;
+    }
+}
+
+
+/*
+delete a statement which has been generated
+*/
+static void delete_statement(Statement *statement)
+{
+    switch(statement->kind)
+    {
+    case ST_INSTRUCTION:
+        {
+        Operation *operation = statement->operation;
+        if(operation->operands != NULL)
+        {
+            List(Operand) *operands = (List(Operand) *)operation->operands;
+            for_each_entry(Operand, cursor, operands)
+            {
+                free(get_element(Operand)(cursor));
             }
+            delete_list(Operand)(operands);
         }
+        free(operation);
+        }
+        break;
+
+    case ST_VALUE:
+        free(statement->data);
+        break;
+
+    case ST_ZERO:
+        free(statement->bss);
+        break;
+
+    case ST_ATTRIBUTE:
+        // name is kept since it may be the key of the binding made by the attribute
+        free((char *)statement->attribute->origin);
+        free(statement->attribute);
+        break;
+
+    case ST_FRAME:
+        free(statement->frame);
+        break;
+
+    default:
+        assert(0);
+        break;
+    }
+
+    free(statement->location);
+    free(statement);
+}
+
+
+/*
+get binding of a name, making a new one if it does not exist
+*/
+static SymbolBinding *get_symbol_binding(const char *name)
+{
+    SymbolBinding *binding = search_map(SymbolBinding)(symbol_binding_map, name);
+    if(binding == NULL)
+    {
+        binding = insert_map(SymbolBinding)(symbol_binding_map, name, calloc(1, sizeof(SymbolBinding)));
+    }
+
+    return binding;
+}
+
+
+/*
+define a label at the address of the statement marked by it, and resolve references waiting for it
+*/
+static void define_label(const Label *label)
+{
+    SymbolBinding *binding = get_symbol_binding(label->symbol->body);
+    if(binding->label != NULL)
+    {
+        return;
+    }
+
+    if(label->statement == NULL)
+    {
+        fprintf(stderr, "label '%s' does not mark any statement\n", label->symbol->body);
+        exit(EXIT_FAILURE);
+    }
+    binding->label = label;
+    binding->address = label->statement->address;
+    binding->section = label->statement->section;
 
-        if(!resolved)
+    if(binding->fixups != NULL)
+    {
+        List(Symbol) *fixups = binding->fixups;
+        binding->fixups = NULL;
+        for_each_entry(Symbol, cursor, fixups)
         {
-            set_reloc_info(SC_UND, symbol->addend, symbol);
+            resolve_reference(get_element(Symbol)(cursor));
         }
+        delete_list(Symbol)(fixups);
     }
 }
 
 
 /*
-generate section bodies
+declare a symbol
 */
-static void generate_sections(const Program *program)
+static void declare_symbol(const Symbol *symbol)
 {
-    generate_statement_list(program->statement_list);
-    classify_symbol_list(program->symbol_list, program->label_list);
-    resolve_symbols(program->symbol_list, program->label_list);
+    SymbolBinding *binding = get_symbol_binding(symbol->body);
+    if(binding->resolved)
+    {
+        fprintf(stderr, "'%s' is declared after references to it are resolved in one-pass mode\n", symbol->body);
+        exit(EXIT_FAILURE);
+    }
+
+    if(binding->declaration == NULL)
+    {
+        binding->declaration = symbol;
+    }
+}
+
+
+/*
+make map from names to their labels and declarations
+*/
+static void make_symbol_binding_map(const List(Symbol) *symbol_list, const List(Label) *label_list)
+{
+    for_each_entry(Label, cursor, label_list)
+    {
+        define_label(get_element(Label)(cursor));
+    }
+
+    for_each_entry(Symbol, cursor, symbol_list)
+    {
+        const Symbol *symbol = get_element(Symbol)(cursor);
+        if(symbol->declared)
+        {
+            declare_symbol(symbol);
+        }
+    }
+}
+
+
+/*
+set attributes of symbols given by directives after the directives are laid out
+*/
+static void set_symbol_attributes(const List(Statement) *statement_list)
+{
+    for_each_entry(Statement, cursor, statement_list)
+    {
+        const Statement *statement = get_element(Statement)(cursor);
+        if(statement->kind != ST_ATTRIBUTE)
+        {
+            continue;
+        }
+
+        const SymbolAttribute *attribute = statement->attribute;
+        SymbolBinding *binding = get_symbol_binding(attribute->name);
+        if(attribute->kind == AT_TYPE)
+        {
+            if((attribute->type == STT_GNU_IFUNC) && binding->resolved)
+            {
+                fprintf(stderr, "'%s' is typed as an indirect function after references to it are resolved in one-pass mode\n", attribute->name);
+                exit(EXIT_FAILURE);
+            }
+            binding->type = attribute->type;
+        }
+        else if(attribute->kind == AT_VISIBILITY)
+        {
+            binding->visibility = attribute->visibility;
+        }
+        else if(attribute->origin == NULL)
+        {
+            binding->size = attribute->size;
+        }
+        else
+        {
+            // size is measured from the origin to the location of the directive
+            const SymbolBinding *origin = get_symbol_binding(attribute->origin);
+            if((origin->label == NULL) || (origin->section != statement->section) || (origin->address > statement->address))
+            {
+                fprintf(stderr, "size of '%s' is not measured from a preceding label '%s' in the same section\n", attribute->name, attribute->origin);
+                exit(EXIT_FAILURE);
+            }
+            binding->size = statement->address - origin->address;
+        }
+    }
+}
+
+
+/*
+add rows of line number table and directives for call frame information after statements are laid out
+*/
+static void add_debug_information(const List(Statement) *statement_list)
+{
+    for_each_entry(Statement, cursor, statement_list)
+    {
+        const Statement *statement = get_element(Statement)(cursor);
+        if(statement->location != NULL)
+        {
+            add_line_row(statement->section, statement->address, statement->location);
+        }
+        if(statement->kind == ST_FRAME)
+        {
+            add_frame_directive(statement->section, statement->address, statement->frame);
+        }
+    }
+}
+
+
+/*
+update list of symbols
+*/
+static void update_symbol_list(Symbol *symbol)
+{
+    add_list_entry_tail(Symbol)((symbol->bind == STB_LOCAL) ? local_symbol_list : global_symbol_list, symbol);
+    get_symbol_binding(symbol->body)->classified = symbol;
+}
+
+
+/*
+classify list of symbols
+* A name which is only referred or given visibility is an undefined global symbol unless it is labeled.
+*/
+static void classify_symbol_list(const List(Symbol) *symbol_list)
+{
+    for_each_entry(Symbol, cursor, symbol_list)
+    {
+        Symbol *symbol = get_element(Symbol)(cursor);
+        const SymbolBinding *binding = get_symbol_binding(symbol->body);
+        if(binding->classified != NULL)
+        {
+            continue;
+        }
+
+        if(!(symbol->labeled || symbol->declared))
+        {
+            if(binding->label == NULL)
+            {
+                symbol->bind = STB_GLOBAL;
+                update_symbol_list(symbol);
+            }
+        }
+        else
+        {
+            unsigned char bind = STB_GLOBAL;
+            if(symbol->labeled)
+            {
+                const Symbol *declaration = binding->declaration;
+                bind = (declaration == NULL) ? STB_LOCAL : declaration->bind;
+            }
+            else
+            {
+                bind = symbol->bind;
+            }
+
+            symbol->value = binding->address;
+            symbol->located = binding->section;
+            symbol->bind = bind;
+            update_symbol_list(symbol);
+        }
+    }
+}
+
+
+/*
+classify signatures of section groups
+* A signature which is not a symbol is registered as a local symbol defined in its group section.
+*/
+static void classify_group_signatures(void)
+{
+    for_each_entry(Group, cursor, get_group_list())
+    {
+        const Group *group = get_element(Group)(cursor);
+        if(get_symbol_binding(group->signature)->classified == NULL)
+        {
+            Symbol *symbol = calloc(1, sizeof(Symbol));
+            symbol->body = group->signature;
+            symbol->bind = STB_LOCAL;
+            symbol->located = group->section->kind;
+            update_symbol_list(symbol);
+        }
+    }
+}
+
+
+/*
+resolve relative address to a label in .text section
+*/
+static void resolve_relative_address(Elf_Addr label_address, const Symbol *symbol)
+{
+    char *reloc_target = &get_section(symbol->appeared)->body->body[symbol->address];
+    Elf_Sxword displacement = label_address + symbol->addend - symbol->address;
+    switch(symbol->reloc_size)
+    {
+    case SIZEOF_8BIT:
+        if((displacement < INT8_MIN) || (displacement > INT8_MAX))
+        {
+            fprintf(stderr, "displacement to '%s' is out of range of 8-bit\n", symbol->body);
+            exit(EXIT_FAILURE);
+        }
+        *(int8_t *)reloc_target = displacement;
+        break;
+
+    case SIZEOF_32BIT:
+    default:
+        *(int32_t *)reloc_target = displacement;
+        break;
+    }
+}
+
+
+/*
+resolve a reference to a symbol, and return true if it is resolved without relocation
+* Labels in executable or mergeable sections and labels referred through GOT or in TLS are relocated by themselves, and the others are relocated by their sections.
+* Labels in executable sections are global if and only if they are declared, and only relative references to local labels in the same section are resolved to relative addresses.
+* References to indirect functions are always relocated, since the linker binds them to the functions selected by their resolvers.
+*/
+static bool resolve_symbol(Symbol *symbol, SymbolBinding *binding)
+{
+    if(is_tls_reference(symbol))
+    {
+        binding->tls = true;
+    }
+
+    if(binding->label == NULL)
+    {
+        set_reloc_info(SC_UND, symbol->addend, symbol);
+        return false;
+    }
+
+    if(is_symbol_reference(symbol) || is_mergeable_section(binding->section))
+    {
+        set_reloc_info(binding->section, symbol->addend, symbol);
+        return false;
+    }
+
+    if(!is_executable_section(binding->section))
+    {
+        set_reloc_info(binding->section, symbol->addend + binding->address, symbol);
+        return false;
+    }
+
+    if((binding->declaration != NULL) || (binding->type == STT_GNU_IFUNC) || !symbol->relative || (symbol->appeared != binding->section))
+    {
+        set_reloc_info(binding->section, symbol->addend, symbol);
+        return false;
+    }
+
+    resolve_relative_address(binding->address, symbol);
+    binding->resolved = true;
+    return true;
+}
+
+
+/*
+resolve symbols
+*/
+static void resolve_symbols(const List(Symbol) *symbol_list)
+{
+    for_each_entry(Symbol, cursor, symbol_list)
+    {
+        Symbol *symbol = get_element(Symbol)(cursor);
+        if(!(symbol->labeled || symbol->declared || symbol->attributed))
+        {
+            resolve_symbol(symbol, get_symbol_binding(symbol->body));
+        }
+    }
+}
+
+
+/*
+resolve a reference to a symbol in one-pass mode, or add it to fixups of the label if the label is not defined yet
+*/
+static void resolve_reference(Symbol *symbol)
+{
+    SymbolBinding *binding = get_symbol_binding(symbol->body);
+    if(binding->label == NULL)
+    {
+        if(binding->fixups == NULL)
+        {
+            binding->fixups = new_list(Symbol)();
+        }
+        add_list_entry_tail(Symbol)(binding->fixups, symbol);
+
+        // the first reference is classified as an undefined symbol unless the label is defined
+        if(binding->reference == NULL)
+        {
+            binding->reference = symbol;
+            add_list_entry_tail(Symbol)(retained_symbol_list, symbol);
+        }
+    }
+    else if(resolve_symbol(symbol, binding) && (symbol != binding->reference))
+    {
+        delete_symbol(symbol);
+    }
+}
+
+
+/*
+resolve references to labels which are not defined until the end of program in one-pass mode
+*/
+static void resolve_undefined_references(void)
+{
+    for_each_entry(Symbol, cursor, retained_symbol_list)
+    {
+        const Symbol *symbol = get_element(Symbol)(cursor);
+        SymbolBinding *binding = get_symbol_binding(symbol->body);
+        if(binding->fixups == NULL)
+        {
+            continue;
+        }
+
+        for_each_entry(Symbol, fixup, binding->fixups)
+        {
+            resolve_symbol(get_element(Symbol)(fixup), binding);
+        }
+        delete_list(Symbol)(binding->fixups);
+        binding->fixups = NULL;
+    }
+}
+
+
+/*
+retire a fragment of program whose statements are never generated again, and delete its statements
+*/
+static void retire_fragment(Program *fragment)
+{
+    for_each_entry(Label, cursor, fragment->label_list)
+    {
+        define_label(get_element(Label)(cursor));
+    }
+    set_symbol_attributes(fragment->statement_list);
+    add_debug_information(fragment->statement_list);
+
+    for_each_entry(Symbol, cursor, fragment->symbol_list)
+    {
+        Symbol *symbol = get_element(Symbol)(cursor);
+        if(symbol->labeled || symbol->declared || symbol->attributed)
+        {
+            add_list_entry_tail(Symbol)(retained_symbol_list, symbol);
+        }
+        else
+        {
+            resolve_reference(symbol);
+        }
+    }
+
+    for_each_entry(Statement, cursor, fragment->statement_list)
+    {
+        delete_statement(get_element(Statement)(cursor));
+    }
+    delete_list(Statement)(fragment->statement_list);
+    delete_list(Label)(fragment->label_list);
+    delete_list(Symbol)(fragment->symbol_list);
+}
+
+
+/*
+consume a fragment of program made from a statement in one-pass mode
+* The fragment is held until the next statement is generated, since its last statement may be generated again as the head of a fused pair.
+*/
+static void consume_fragment(Program *fragment)
+{
+    for_each_entry(Symbol, cursor, fragment->symbol_list)
+    {
+        const Symbol *symbol = get_element(Symbol)(cursor);
+        if(symbol->declared)
+        {
+            declare_symbol(symbol);
+        }
+    }
+
+    if(end_iteration(Statement)(fragment->statement_list, get_first_entry(Statement)(fragment->statement_list)))
+    {
+        if(held_fragment.statement_list == NULL)
+        {
+            retire_fragment(fragment);
+            return;
+        }
+
+        // labels and symbols without statements are retired together with the held fragment
+        for_each_entry(Label, cursor, fragment->label_list)
+        {
+            add_list_entry_tail(Label)(held_fragment.label_list, get_element(Label)(cursor));
+        }
+        for_each_entry(Symbol, cursor, fragment->symbol_list)
+        {
+            add_list_entry_tail(Symbol)(held_fragment.symbol_list, get_element(Symbol)(cursor));
+        }
+        delete_list(Statement)(fragment->statement_list);
+        delete_list(Label)(fragment->label_list);
+        delete_list(Symbol)(fragment->symbol_list);
+        return;
+    }
+
+    for_each_entry(Statement, cursor, fragment->statement_list)
+    {
+        Statement *statement = get_element(Statement)(cursor);
+        generate_statement(previous_statement, statement);
+        previous_statement = statement;
+    }
+
+    if(held_fragment.statement_list != NULL)
+    {
+        retire_fragment(&held_fragment);
+    }
+    held_fragment = *fragment;
+}
+
+
+/*
+generate symbol table, relocation tables and metadata sections after symbols are resolved
+*/
+static void generate_sections(const List(Symbol) *symbol_list)
+{
+    classify_symbol_list(symbol_list);
+    classify_group_signatures();
+    make_note_gnu_property();
+    set_symtab_indices();
+    make_debug_line();
+    make_eh_frame();
     set_relocation_table_entries();
     make_shstrtab(&shstrtab_body);
-    make_metadata_sections(&symtab_body, &strtab_body, &shstrtab_body);
+    make_metadata_sections(&symtab_body, &symtab_shndx_body, &strtab_body, &shstrtab_body);
     set_symbol_table_entries();
     set_offset_of_sections();
-    generate_section_header_table_entries(RESERVED_SYMTAB_ENTRIES + get_length(Symbol)(local_symbol_list));
+    generate_section_header_table_entries(local_symtab_entries);
 }
 
 
@@ -477,11 +1277,15 @@ generate ELF header
 static void generate_elf_header(Elf_Ehdr *ehdr)
 {
     Section *section_shstrtab = get_section(SC_SHSTRTAB);
-    Elf_Off e_shoff = align_to(section_shstrtab->offset + section_shstrtab->body->size, sizeof(Elf_Xword));
-    Elf_Half e_shnum = section_shstrtab->index + 1;
-    Elf_Half e_shstrndx = section_shstrtab->index;
+    Elf_Off e_shoff = align_to(section_shstrtab->offset + section_shstrtab->body->size, get_address_size());
+    Elf_Word shnum = section_shstrtab->index + 1;
+
+    // the number of entries and index of .shstrtab section are held in the initial entry if they are out of range
+    Elf_Half e_shnum = (shnum < SHN_LORESERVE) ? shnum : 0;
+    Elf_Half e_shstrndx = (section_shstrtab->index < SHN_LORESERVE) ? section_shstrtab->index : SHN_XINDEX;
 
     set_elf_header(
+        has_gnu_ifunc ? ELFOSABI_GNU : ELFOSABI_NONE,
         e_shoff,
         e_shnum,
         e_shstrndx,
@@ -491,28 +1295,36 @@ static void generate_elf_header(Elf_Ehdr *ehdr)
 
 
 /*
-generate an object file
+initialize generator
 */
-void generate(const char *output_file, const Program *program)
+static void initialize_generator(void)
 {
-    // initialize lists
     local_symbol_list = new_list(Symbol)();
     global_symbol_list = new_list(Symbol)();
     reloc_symbol_list = new_list(Symbol)();
+    symbol_binding_map = new_map(SymbolBinding)();
+}
 
-    // generate contents
-    generate_sections(program);
 
-    // output an object file
+/*
+output an object file
+*/
+static void output_object_file(const char *output_file)
+{
+    if(get_option()->align_branch_boundary != 0)
+    {
+        printf("number of branches padded not to cross %zu-byte boundaries: %zu\n", get_option()->align_branch_boundary, padded_branch_count);
+    }
+
     FILE *fp = fopen(output_file, "wb");
 
     // output ELF header
-    Elf_Ehdr elf_header;
+    Elf_Ehdr elf_header = {{0}};
     generate_elf_header(&elf_header);
-    fwrite(&elf_header, sizeof(Elf_Ehdr), 1, fp);
+    output_elf_header(&elf_header, fp);
 
     // output section bodies
-    size_t end_pos = output_section_bodies(sizeof(Elf_Ehdr), fp);
+    size_t end_pos = output_section_bodies(get_ehdr_size(), fp);
 
     // output section header table entries
     fill_paddings(elf_header.e_shoff - end_pos, fp);
@@ -520,3 +1332,45 @@ void generate(const char *output_file, const Program *program)
 
     fclose(fp);
 }
+
+
+/*
+generate an object file
+*/
+void generate(const char *output_file, const Program *program)
+{
+    initialize_generator();
+
+    // generate contents
+    generate_statement_list(program->statement_list);
+    make_symbol_binding_map(program->symbol_list, program->label_list);
+    set_symbol_attributes(program->statement_list);
+    add_debug_information(program->statement_list);
+    resolve_symbols(program->symbol_list);
+    generate_sections(program->symbol_list);
+
+    output_object_file(output_file);
+}
+
+
+/*
+generate an object file in one pass, encoding each statement as soon as it is parsed
+* References to labels not defined yet are patched when the labels are defined, and statements are deleted after they are retired.
+*/
+void generate_in_one_pass(const char *output_file)
+{
+    initialize_generator();
+    retained_symbol_list = new_list(Symbol)();
+
+    // generate contents
+    construct_in_one_pass(consume_fragment);
+    if(held_fragment.statement_list != NULL)
+    {
+        retire_fragment(&held_fragment);
+    }
+    resolve_undefined_references();
+    sort_reloc_symbol_list();
+    generate_sections(retained_symbol_list);
+
+    output_object_file(output_file);
+}
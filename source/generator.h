@@ -4,5 +4,6 @@
 #include "parser.h"
 
 void generate(const char *output_file, const Program *program);
+void generate_in_one_pass(const char *output_file);
 
 #endif /* !GENERATOR_H */
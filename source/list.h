@@ -9,6 +9,7 @@
 #define ListEntry(type) type##ListEntry // type-name of entry of list
 #define new_list(type) new_##type##List // function name to make a new list
 #define new_list_entry(type) new_##type##ListEntry // function name to make a new entry of list
+#define delete_list(type) delete_##type##List // function name to delete list without its elements
 #define get_length(type) get_length_##type // function name to get the length of list
 #define get_element(type) get_element_##type // function name to get the element of an entry of list
 #define get_first_entry(type) get_first_entry_##type // function name to get the first entry of list
@@ -40,6 +41,7 @@ struct ListEntry(type) {\
 /* function prototypes */\
 List(type) *new_list(type)(void);\
 ListEntry(type) *new_list_entry(type)(type *element);\
+void delete_list(type)(List(type) *list);\
 size_t get_length(type)(const List(type) *list);\
 type *get_element(type)(const ListEntry(type) *entry);\
 ListEntry(type) *get_first_entry(type)(const List(type) *list);\
@@ -77,6 +79,21 @@ ListEntry(type) *new_list_entry(type)(type *element)\
 }\
 \
 \
+/* delete list without its elements */\
+void delete_list(type)(List(type) *list)\
+{\
+    ListEntry(type) *entry = get_first_entry(type)(list);\
+    while(!end_iteration(type)(list, entry))\
+    {\
+        ListEntry(type) *next = next_entry(type, entry);\
+        free(entry);\
+        entry = next;\
+    }\
+    free(list->head);\
+    free(list);\
+}\
+\
+\
 /* get the length of list */\
 size_t get_length(type)(const List(type) *list)\
 {\
@@ -1,7 +1,9 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "analyzer.h"
 #include "generator.h"
+#include "option.h"
 #include "parser.h"
 #include "tokenizer.h"
 
@@ -11,18 +13,33 @@ main function of assembler
 int main(int argc, char *argv[])
 {
     // parse arguments
-    char *user_input = read_file(argv[1]);
-    const char *output_file = argv[4];
+    parse_options(argc, argv);
+    const Option *option = get_option();
+
+    // generate an object file without keeping the whole input nor the whole syntax tree
+    if(option->one_pass && (option->analysis_target == NULL))
+    {
+        tokenize_stream(option->input_file);
+        generate_in_one_pass(option->output_file);
+        return 0;
+    }
 
     // tokenize input
-    tokenize(user_input);
+    tokenize(read_file(option->input_file));
 
     // construct syntax tree
     Program program;
     construct(&program);
 
+    // analyze basic blocks instead of generating an object file
+    if(option->analysis_target != NULL)
+    {
+        analyze(option->analysis_target, &program);
+        return 0;
+    }
+
     // generate an object file
-    generate(output_file, &program);
+    generate(option->output_file, &program);
 
     return 0;
 }
@@ -0,0 +1,22 @@
+#include <stdint.h>
+
+#include "map.h"
+
+static const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+static const uint64_t FNV_PRIME = 0x00000100000001b3;
+
+
+/*
+get hash value of string by FNV-1a
+*/
+uint64_t hash_string(const char *key)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for(const unsigned char *cursor = (const unsigned char *)key; *cursor != '\0'; cursor++)
+    {
+        hash ^= *cursor;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
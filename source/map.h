@@ -0,0 +1,136 @@
+#ifndef MAP_H
+#define MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// macro
+#define Map(type) type##Map // type-name of map from string to element
+#define MapEntry(type) type##MapEntry // type-name of entry of map
+#define new_map(type) new_##type##Map // function name to make a new map
+#define get_map_size(type) get_map_size_##type // function name to get the number of elements in map
+#define search_map(type) search_map_##type // function name to search an element by key
+#define insert_map(type) insert_map_##type // function name to insert an element unless the key already exists
+#define resize_map(type) resize_map_##type // function name to resize map
+#define MAP_CAPACITY_INITIAL 16 // initial number of slots of map, which should be a power of 2
+
+#define define_map(type) \
+/* definition of structure */\
+typedef struct Map(type) Map(type);\
+typedef struct MapEntry(type) MapEntry(type);\
+struct Map(type) {\
+    MapEntry(type) *entries; /* slots of map */\
+    size_t capacity;         /* number of slots, which is a power of 2 */\
+    size_t size;             /* number of elements */\
+};\
+struct MapEntry(type) {\
+    const char *key; /* key of element (NULL if the slot is empty) */\
+    uint64_t hash;   /* hash value of key */\
+    type *element;   /* element of entry */\
+};\
+/* function prototypes */\
+Map(type) *new_map(type)(void);\
+size_t get_map_size(type)(const Map(type) *map);\
+type *search_map(type)(const Map(type) *map, const char *key);\
+type *insert_map(type)(Map(type) *map, const char *key, type *element);\
+void resize_map(type)(Map(type) *map, size_t capacity);\
+
+#define define_map_operations(type) \
+/* make a new map */\
+Map(type) *new_map(type)(void)\
+{\
+    Map(type) *map = calloc(1, sizeof(Map(type)));\
+    map->entries = calloc(MAP_CAPACITY_INITIAL, sizeof(MapEntry(type)));\
+    map->capacity = MAP_CAPACITY_INITIAL;\
+    map->size = 0;\
+\
+    return map;\
+}\
+\
+\
+/* get the number of elements in map */\
+size_t get_map_size(type)(const Map(type) *map)\
+{\
+    return map->size;\
+}\
+\
+\
+/* search an element by key, probing slots linearly from the one of its hash value */\
+type *search_map(type)(const Map(type) *map, const char *key)\
+{\
+    uint64_t hash = hash_string(key);\
+    size_t mask = map->capacity - 1;\
+    for(size_t index = hash & mask; map->entries[index].key != NULL; index = (index + 1) & mask)\
+    {\
+        const MapEntry(type) *entry = &map->entries[index];\
+        if((entry->hash == hash) && (strcmp(entry->key, key) == 0))\
+        {\
+            return entry->element;\
+        }\
+    }\
+\
+    return NULL;\
+}\
+\
+\
+/* insert an element unless the key already exists, and return the element associated with the key */\
+type *insert_map(type)(Map(type) *map, const char *key, type *element)\
+{\
+    /* keep load factor not more than 1/2 */\
+    if((map->size + 1) * 2 > map->capacity)\
+    {\
+        resize_map(type)(map, map->capacity * 2);\
+    }\
+\
+    uint64_t hash = hash_string(key);\
+    size_t mask = map->capacity - 1;\
+    size_t index = hash & mask;\
+    for(; map->entries[index].key != NULL; index = (index + 1) & mask)\
+    {\
+        const MapEntry(type) *entry = &map->entries[index];\
+        if((entry->hash == hash) && (strcmp(entry->key, key) == 0))\
+        {\
+            return entry->element;\
+        }\
+    }\
+\
+    map->entries[index].key = key;\
+    map->entries[index].hash = hash;\
+    map->entries[index].element = element;\
+    map->size++;\
+\
+    return element;\
+}\
+\
+\
+/* resize map, rehashing all elements */\
+void resize_map(type)(Map(type) *map, size_t capacity)\
+{\
+    MapEntry(type) *old_entries = map->entries;\
+    size_t old_capacity = map->capacity;\
+    map->entries = calloc(capacity, sizeof(MapEntry(type)));\
+    map->capacity = capacity;\
+\
+    size_t mask = capacity - 1;\
+    for(size_t i = 0; i < old_capacity; i++)\
+    {\
+        if(old_entries[i].key != NULL)\
+        {\
+            size_t index = old_entries[i].hash & mask;\
+            while(map->entries[index].key != NULL)\
+            {\
+                index = (index + 1) & mask;\
+            }\
+            map->entries[index] = old_entries[i];\
+        }\
+    }\
+\
+    free(old_entries);\
+}\
+
+uint64_t hash_string(const char *key);
+
+#endif /* !MAP_H */
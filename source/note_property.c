@@ -0,0 +1,162 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "buffer.h"
+#include "elf_class.h"
+#include "elf_wrap.h"
+#include "note_property.h"
+#include "option.h"
+#include "processor.h"
+#include "section.h"
+
+static Elf_Word get_isa_levels(IsaLevel level);
+static IsaLevel get_lowest_isa_level(uint8_t extensions);
+static Elf_Word get_used_isa_levels(void);
+static void append_property(Elf_Word type, Elf_Word data, Elf_Xword alignment, ByteBufferType *buffer);
+
+static const char NOTE_NAME[] = ELF_NOTE_GNU;
+static const Elf_Word PROPERTY_DATA_SIZE = sizeof(uint32_t);
+static const uint8_t EXTENSIONS_V2 = EX_CX16 | EX_POPCNT;
+static const uint8_t EXTENSIONS_V3 = EX_BMI | EX_BMI2 | EX_LZCNT;
+
+static bool has_operation = false;          // flag indicating that any instruction is generated
+static uint8_t needed_extensions = EX_NONE; // set of instruction set extensions required by instructions needed by the object
+static uint8_t used_extensions = EX_NONE;   // set of instruction set extensions required by generated instructions
+
+
+/*
+add instruction set extensions required by a generated instruction
+* Extensions of an instruction which is not needed (e.g. a variant selected at runtime) are only recorded as used.
+*/
+void add_used_extensions(uint8_t extensions, bool needed)
+{
+    has_operation = true;
+    used_extensions |= extensions;
+    if(needed)
+    {
+        needed_extensions |= extensions;
+    }
+}
+
+
+/*
+get a set of ISA levels up to a level, which are all needed by an object of the level
+*/
+static Elf_Word get_isa_levels(IsaLevel level)
+{
+    switch(level)
+    {
+    case IL_BASELINE:
+        return GNU_PROPERTY_X86_ISA_1_BASELINE;
+
+    case IL_V2:
+        return GNU_PROPERTY_X86_ISA_1_BASELINE | GNU_PROPERTY_X86_ISA_1_V2;
+
+    case IL_V3:
+        return GNU_PROPERTY_X86_ISA_1_BASELINE | GNU_PROPERTY_X86_ISA_1_V2 | GNU_PROPERTY_X86_ISA_1_V3;
+
+    case IL_V4:
+        return GNU_PROPERTY_X86_ISA_1_BASELINE | GNU_PROPERTY_X86_ISA_1_V2 | GNU_PROPERTY_X86_ISA_1_V3 | GNU_PROPERTY_X86_ISA_1_V4;
+
+    case IL_AUTO:
+    case IL_NONE:
+    default:
+        return 0;
+    }
+}
+
+
+/*
+get the lowest ISA level which includes generated instructions and given extensions
+*/
+static IsaLevel get_lowest_isa_level(uint8_t extensions)
+{
+    if(!has_operation)
+    {
+        return IL_NONE;
+    }
+    else if((extensions & EXTENSIONS_V3) != 0)
+    {
+        return IL_V3;
+    }
+    else if((extensions & EXTENSIONS_V2) != 0)
+    {
+        return IL_V2;
+    }
+    else
+    {
+        return IL_BASELINE;
+    }
+}
+
+
+/*
+get a set of ISA levels which generated instructions belong to
+*/
+static Elf_Word get_used_isa_levels(void)
+{
+    Elf_Word isa_levels = has_operation ? GNU_PROPERTY_X86_ISA_1_BASELINE : 0;
+    if((used_extensions & EXTENSIONS_V2) != 0)
+    {
+        isa_levels |= GNU_PROPERTY_X86_ISA_1_V2;
+    }
+    if((used_extensions & EXTENSIONS_V3) != 0)
+    {
+        isa_levels |= GNU_PROPERTY_X86_ISA_1_V3;
+    }
+
+    return isa_levels;
+}
+
+
+/*
+append a property with 32-bit data, which is padded to the size of address
+*/
+static void append_property(Elf_Word type, Elf_Word data, Elf_Xword alignment, ByteBufferType *buffer)
+{
+    append_uint(type, sizeof(uint32_t), buffer);
+    append_uint(PROPERTY_DATA_SIZE, sizeof(uint32_t), buffer);
+    append_uint(data, PROPERTY_DATA_SIZE, buffer);
+    fill_bytes(0, align_to(PROPERTY_DATA_SIZE, alignment) - PROPERTY_DATA_SIZE, buffer);
+}
+
+
+/*
+make .note.gnu.property section marking ISA levels needed and used by the object, after all instructions are generated
+* The needed level is derived from instructions out of regions given by .arch directive unless it is given by the option, and the section is not made for an object without instructions.
+* The section given in the source is kept as it is, since a second note would duplicate its properties.
+* Properties are sorted by type, and their data are aligned to the size of address, which is 4 bytes for ELFCLASS32.
+*/
+void make_note_gnu_property(void)
+{
+    IsaLevel level = get_option()->isa_level_needed;
+    Elf_Word needed_isa_levels = get_isa_levels((level == IL_AUTO) ? get_lowest_isa_level(needed_extensions) : level);
+    if((needed_isa_levels == 0) || (get_section_by_name(".note.gnu.property") != NULL))
+    {
+        return;
+    }
+    Elf_Word used_isa_levels = get_used_isa_levels();
+
+    Elf_Xword alignment = get_address_size();
+    Section *section = make_section(".note.gnu.property", SHT_NOTE, SHF_ALLOC, 0);
+    section->alignment = alignment;
+
+    // header and name of note
+    ByteBufferType *buffer = section->body;
+    size_t property_size = sizeof(uint32_t) * 2 + align_to(PROPERTY_DATA_SIZE, alignment);
+    Elf_Word descriptor_size = property_size * ((used_isa_levels != 0) ? 2 : 1);
+    append_uint(sizeof(NOTE_NAME), sizeof(uint32_t), buffer);
+    append_uint(descriptor_size, sizeof(uint32_t), buffer);
+    append_uint(NT_GNU_PROPERTY_TYPE_0, sizeof(uint32_t), buffer);
+    append_bytes(NOTE_NAME, sizeof(NOTE_NAME), buffer);
+    fill_bytes(0, align_to(buffer->size, sizeof(uint32_t)) - buffer->size, buffer);
+
+    // properties of ISA levels
+    append_property(GNU_PROPERTY_X86_ISA_1_NEEDED, needed_isa_levels, alignment, buffer);
+    if(used_isa_levels != 0)
+    {
+        append_property(GNU_PROPERTY_X86_ISA_1_USED, used_isa_levels, alignment, buffer);
+    }
+
+    section->size = buffer->size;
+}
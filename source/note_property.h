@@ -0,0 +1,10 @@
+#ifndef NOTE_PROPERTY_H
+#define NOTE_PROPERTY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void add_used_extensions(uint8_t extensions, bool needed);
+void make_note_gnu_property(void);
+
+#endif /* !NOTE_PROPERTY_H */
@@ -0,0 +1,225 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "option.h"
+#include "processor.h"
+
+typedef struct BranchKindInfo BranchKindInfo;
+
+// structure for mapping from string to kind of branch
+struct BranchKindInfo
+{
+    BranchKind kind;  // kind of branch
+    const char *name; // name of branch
+};
+
+static bool has_prefix(const char *arg, const char *prefix);
+static size_t parse_align_branch_boundary(const char *value);
+static unsigned int parse_align_branch_kinds(const char *value);
+static IsaLevel parse_isa_level(const char *value);
+
+static const BranchKindInfo branch_kind_info_list[] =
+{
+    {BR_CALL,     "call"},
+    {BR_FUSED,    "fused"},
+    {BR_INDIRECT, "indirect"},
+    {BR_JCC,      "jcc"},
+    {BR_JMP,      "jmp"},
+    {BR_RET,      "ret"},
+};
+static const size_t BRANCH_KIND_INFO_LIST_SIZE = sizeof(branch_kind_info_list) / sizeof(branch_kind_info_list[0]);
+
+static const struct {const char *name; IsaLevel level;} isa_level_map[] =
+{
+    {"auto",     IL_AUTO},
+    {"baseline", IL_BASELINE},
+    {"none",     IL_NONE},
+    {"v2",       IL_V2},
+    {"v3",       IL_V3},
+    {"v4",       IL_V4},
+};
+static const size_t ISA_LEVEL_MAP_SIZE = sizeof(isa_level_map) / sizeof(isa_level_map[0]);
+
+static const size_t ALIGN_BRANCH_BOUNDARY_MIN = 16;
+static const size_t ALIGN_BRANCH_BOUNDARY_DEFAULT = 32;
+static const unsigned int ALIGN_BRANCH_KINDS_DEFAULT = BR_JCC | BR_FUSED | BR_JMP;
+static const char ANALYSIS_TARGET_DEFAULT[] = "skylake";
+
+static Option option = {NULL, NULL, 0, BR_JCC | BR_FUSED | BR_JMP, NULL, false, false, false, IL_AUTO, false}; // command line options
+
+
+/*
+check if an argument starts with a prefix
+*/
+static bool has_prefix(const char *arg, const char *prefix)
+{
+    return strncmp(arg, prefix, strlen(prefix)) == 0;
+}
+
+
+/*
+parse value of option "-malign-branch-boundary="
+*/
+static size_t parse_align_branch_boundary(const char *value)
+{
+    char *end;
+    size_t boundary = strtoul(value, &end, 10);
+    bool is_power_of_2 = ((boundary & (boundary - 1)) == 0);
+    if((*end != '\0') || ((boundary != 0) && ((boundary < ALIGN_BRANCH_BOUNDARY_MIN) || !is_power_of_2)))
+    {
+        fprintf(stderr, "invalid value '%s' for -malign-branch-boundary\n", value);
+        exit(EXIT_FAILURE);
+    }
+
+    return boundary;
+}
+
+
+/*
+parse value of option "-malign-branch=", which is a list of kinds of branch separated by '+'
+*/
+static unsigned int parse_align_branch_kinds(const char *value)
+{
+    unsigned int kinds = BR_NONE;
+    const char *start = value;
+    while(true)
+    {
+        size_t length = strcspn(start, "+");
+        bool found = false;
+        for(size_t i = 0; i < BRANCH_KIND_INFO_LIST_SIZE; i++)
+        {
+            const char *name = branch_kind_info_list[i].name;
+            if((strlen(name) == length) && (strncmp(start, name, length) == 0))
+            {
+                kinds |= branch_kind_info_list[i].kind;
+                found = true;
+                break;
+            }
+        }
+
+        if(!found)
+        {
+            fprintf(stderr, "invalid value '%s' for -malign-branch\n", value);
+            exit(EXIT_FAILURE);
+        }
+
+        if(start[length] == '\0')
+        {
+            break;
+        }
+        start += length + 1;
+    }
+
+    return kinds;
+}
+
+
+/*
+parse value of option "--isa-level-needed="
+*/
+static IsaLevel parse_isa_level(const char *value)
+{
+    for(size_t i = 0; i < ISA_LEVEL_MAP_SIZE; i++)
+    {
+        if(strcmp(value, isa_level_map[i].name) == 0)
+        {
+            return isa_level_map[i].level;
+        }
+    }
+
+    fprintf(stderr, "invalid value '%s' for --isa-level-needed\n", value);
+    exit(EXIT_FAILURE);
+}
+
+
+/*
+parse command line options
+*/
+void parse_options(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if(strcmp(arg, "-c") == 0)
+        {
+            // only relocatable object files are generated
+        }
+        else if(strcmp(arg, "-o") == 0)
+        {
+            if(i + 1 >= argc)
+            {
+                fprintf(stderr, "missing file name after '-o'\n");
+                exit(EXIT_FAILURE);
+            }
+            option.output_file = argv[++i];
+        }
+        else if(strcmp(arg, "--analyze") == 0)
+        {
+            option.analysis_target = ANALYSIS_TARGET_DEFAULT;
+        }
+        else if(has_prefix(arg, "--analyze="))
+        {
+            option.analysis_target = &arg[strlen("--analyze=")];
+        }
+        else if(has_prefix(arg, "-malign-branch-boundary="))
+        {
+            option.align_branch_boundary = parse_align_branch_boundary(&arg[strlen("-malign-branch-boundary=")]);
+        }
+        else if(has_prefix(arg, "-malign-branch="))
+        {
+            option.align_branch_kinds = parse_align_branch_kinds(&arg[strlen("-malign-branch=")]);
+        }
+        else if(strcmp(arg, "--one-pass") == 0)
+        {
+            option.one_pass = true;
+        }
+        else if(strcmp(arg, "--function-sections") == 0)
+        {
+            option.function_sections = true;
+        }
+        else if(strcmp(arg, "--data-sections") == 0)
+        {
+            option.data_sections = true;
+        }
+        else if(has_prefix(arg, "--isa-level-needed="))
+        {
+            option.isa_level_needed = parse_isa_level(&arg[strlen("--isa-level-needed=")]);
+        }
+        else if(strcmp(arg, "--x32") == 0)
+        {
+            option.x32 = true;
+        }
+        else if(strcmp(arg, "-mbranches-within-32B-boundaries") == 0)
+        {
+            option.align_branch_boundary = ALIGN_BRANCH_BOUNDARY_DEFAULT;
+            option.align_branch_kinds = ALIGN_BRANCH_KINDS_DEFAULT;
+        }
+        else if((arg[0] == '-') || (option.input_file != NULL))
+        {
+            fprintf(stderr, "unrecognized option '%s'\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        else
+        {
+            option.input_file = arg;
+        }
+    }
+
+    // output file is not generated in analysis
+    if((option.input_file == NULL) || ((option.output_file == NULL) && (option.analysis_target == NULL)))
+    {
+        fprintf(stderr, "usage: %s <input-file> -c -o <output-file>\n       %s <input-file> --analyze[=<microarchitecture>]\n", argv[0], argv[0]);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+/*
+get command line options
+*/
+const Option *get_option(void)
+{
+    return &option;
+}
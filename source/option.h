@@ -0,0 +1,39 @@
+#ifndef OPTION_H
+#define OPTION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum IsaLevel IsaLevel;
+typedef struct Option Option;
+
+// x86-64 ISA level recorded in .note.gnu.property section
+enum IsaLevel
+{
+    IL_AUTO,     // level derived from instructions in the object
+    IL_NONE,     // no level (the section is not emitted)
+    IL_BASELINE, // x86-64-baseline
+    IL_V2,       // x86-64-v2
+    IL_V3,       // x86-64-v3
+    IL_V4,       // x86-64-v4
+};
+
+// structure for command line options
+struct Option
+{
+    const char *input_file;          // name of input file
+    const char *output_file;         // name of output file
+    size_t align_branch_boundary;    // boundary which branches should not cross (0 if disabled)
+    unsigned int align_branch_kinds; // set of kinds of branches to be aligned
+    const char *analysis_target;     // name of microarchitecture for which basic blocks are analyzed (NULL if disabled)
+    bool one_pass;                   // flag indicating that each statement is encoded as soon as it is parsed
+    bool function_sections;          // flag indicating that each global label in .text section is placed in its own section
+    bool data_sections;              // flag indicating that each global label in .data, .bss and .rodata sections is placed in its own section
+    IsaLevel isa_level_needed;       // x86-64 ISA level which the object needs
+    bool x32;                        // flag indicating that an object of ELFCLASS32 is generated for the x32 ABI
+};
+
+void parse_options(int argc, char *argv[]);
+const Option *get_option(void);
+
+#endif /* !OPTION_H */
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "option.h"
 #include "parser.h"
 #include "processor.h"
 #include "tokenizer.h"
@@ -14,33 +15,64 @@ define_list_operations(Label)
 define_list_operations(Operand)
 define_list_operations(Statement)
 
+#include "map.h"
+define_map(Label)
+define_map_operations(Label)
+define_map(Symbol)
+define_map_operations(Symbol)
+
 // function prototype
 static void program(void);
 static void statement(void);
 static void parse_directive(List(Label) *labels);
+static bool peek_annotation_directive(void);
+static bool consume_frame_directive(size_t *index);
+static void parse_directive_frame(const Token *token, size_t index);
+static Elf_Word parse_frame_register(void);
+static Elf_Sxword parse_signed_immediate(void);
+static void parse_directive_arch(void);
+static void parse_directive_file(void);
+static void parse_directive_location(void);
+static bool consume_identifier(const char *name);
+static const char *parse_string_literal(const Token *token);
+static void parse_directive_section(void);
+static const char *parse_section_name(void);
+static Elf_Xword parse_section_flags(const Token *token);
+static Elf_Word parse_section_type(const Token *token);
 static void parse_directive_size(size_t size, List(Label) *labels);
 static void parse_directive_string(List(Label) *labels);
+static void parse_directive_symbol_size(void);
+static void parse_directive_symbol_type(void);
+static void parse_directive_symbol_visibility(unsigned char visibility);
 static void parse_directive_zero(List(Label) *label);
 static Label *parse_label(const Token *token);
-static Operation *parse_operation(const Token *token, List(Label) *labels);
+static void select_label_section(const Symbol *symbol);
+static Operation *parse_operation(List(Label) *labels);
 static const MnemonicInfo *parse_mnemonic(const Token *token);
+static PrefixKind parse_prefix(const Token *token);
 static List(Operand) *parse_operands(void);
 static Operand *parse_operand(void);
 static Statement *new_statement(StatementKind kind, List(Label) *labels);
 static Label *new_label(const Symbol *symbol);
 static Bss *new_bss(size_t size, List(Label) *labels);
+static SymbolAttribute *new_symbol_attribute(AttributeKind kind, const Token *token);
+static FrameDirective *new_frame_directive(FrameDirectiveKind kind);
 static Data *new_data(DataKind kind, size_t size, Elf_Sxword addend, List(Label) *labels);
 static Data *new_data_immediate(size_t size, uintmax_t value, List(Label) *labels);
 static Data *new_data_symbol(size_t size, Elf_Sxword addend, const Token *token, List(Label) *labels);
 static Data *new_data_string(const char *str, List(Label) *labels, size_t *len);
-static Operation *new_operation(MnemonicKind kind, const List(Operand) *operands, List(Label) *labels);
+static Operation *new_operation(MnemonicKind kind, PrefixKind prefix, const List(Operand) *operands, List(Label) *labels);
 static Operand *new_operand(OperandKind kind);
 static Operand *new_operand_immediate(uintmax_t immediate);
 static Operand *new_operand_register(const Token *token);
 static Operand *new_operand_memory(OperandKind kind);
 static Operand *new_operand_symbol(const Token *token);
+static RelocationSuffix parse_relocation_suffix(void);
+static SegmentKind parse_segment(void);
 static const RegisterInfo *get_register_info(const Token *token);
 static bool consume_size_specifier(OperandKind *kind);
+static bool is_acceptable_prefix(PrefixKind prefix, const MnemonicInfo *map, const List(Operand) *operands);
+static bool is_memory_operand(OperandKind kind);
 static size_t get_current_alignment(void);
 static void set_current_alignment(size_t alignment);
 static void reset_current_alignment(void);
@@ -48,8 +80,106 @@ static void reset_current_alignment(void);
 // global variable
 static List(Statement) *statement_list = NULL; // list of statements
 static List(Label) *label_list = NULL; // list of labels
+static Map(Label) *label_map = NULL; // map from name to label
+static Map(Symbol) *declaration_map = NULL; // map from name to declaration of global symbol
 
 static size_t current_alignment = 1; // current alignment
+static SourceLocation *pending_location = NULL; // location given by .loc directive, which is attached to the next instruction
+static bool location_is_stmt = true; // flag indicating that locations are recommended breakpoints, which persists over .loc directives
+static SectionKind procedure_section = SC_UND; // section of procedure started by .cfi_startproc (SC_UND if out of procedure)
+static uint8_t enabled_extensions = EX_ALL; // set of instruction set extensions enabled by .arch directive
+static bool arch_specified = false; // flag indicating that extensions are specified by .arch directive other than "default"
+
+// map from character to flag of section
+static const struct {char character; Elf_Xword flag;} section_flag_map[] = {
+    {'G', SHF_GROUP},
+    {'M', SHF_MERGE},
+    {'S', SHF_STRINGS},
+    {'T', SHF_TLS},
+    {'a', SHF_ALLOC},
+    {'w', SHF_WRITE},
+    {'x', SHF_EXECINSTR},
+};
+static const size_t SECTION_FLAG_MAP_SIZE = sizeof(section_flag_map) / sizeof(section_flag_map[0]);
+// map from name to type of section
+static const struct {const char *name; Elf_Word type;} section_type_map[] = {
+    {"fini_array",    SHT_FINI_ARRAY},
+    {"init_array",    SHT_INIT_ARRAY},
+    {"nobits",        SHT_NOBITS},
+    {"note",          SHT_NOTE},
+    {"preinit_array", SHT_PREINIT_ARRAY},
+    {"progbits",      SHT_PROGBITS},
+};
+static const size_t SECTION_TYPE_MAP_SIZE = sizeof(section_type_map) / sizeof(section_type_map[0]);
+// map from name to type of symbol
+static const struct {const char *name; unsigned char type;} symbol_type_map[] = {
+    {"function",              STT_FUNC},
+    {"gnu_indirect_function", STT_GNU_IFUNC},
+    {"notype",                STT_NOTYPE},
+    {"object",                STT_OBJECT},
+    {"tls_object",            STT_TLS},
+};
+static const size_t SYMBOL_TYPE_MAP_SIZE = sizeof(symbol_type_map) / sizeof(symbol_type_map[0]);
+// map from directive to kind of directive for call frame information and its operands
+static const struct {const char *name; FrameDirectiveKind kind; bool takes_register; bool takes_offset;} frame_directive_map[] = {
+    {".cfi_adjust_cfa_offset", FD_ADJUST_CFA_OFFSET, false, true},
+    {".cfi_def_cfa",           FD_DEF_CFA,           true,  true},
+    {".cfi_def_cfa_offset",    FD_DEF_CFA_OFFSET,    false, true},
+    {".cfi_def_cfa_register",  FD_DEF_CFA_REGISTER,  true,  false},
+    {".cfi_endproc",           FD_END_PROCEDURE,     false, false},
+    {".cfi_offset",            FD_OFFSET,            true,  true},
+    {".cfi_rel_offset",        FD_REL_OFFSET,        true,  true},
+    {".cfi_remember_state",    FD_REMEMBER_STATE,    false, false},
+    {".cfi_restore",           FD_RESTORE,           true,  false},
+    {".cfi_restore_state",     FD_RESTORE_STATE,     false, false},
+    {".cfi_same_value",        FD_SAME_VALUE,        true,  false},
+    {".cfi_startproc",         FD_START_PROCEDURE,   false, false},
+    {".cfi_undefined",         FD_UNDEFINED,         true,  false},
+};
+static const size_t FRAME_DIRECTIVE_MAP_SIZE = sizeof(frame_directive_map) / sizeof(frame_directive_map[0]);
+// sections from which sections dedicated to global labels are derived
+static const struct {const char *name; bool executable;} label_section_base_map[] = {
+    {".bss",    false},
+    {".data",   false},
+    {".rodata", false},
+    {".text",   true},
+};
+static const size_t LABEL_SECTION_BASE_MAP_SIZE = sizeof(label_section_base_map) / sizeof(label_section_base_map[0]);
+// map from suffix of symbol to kind of relocation
+static const struct {const char *name; RelocationSuffix suffix;} relocation_suffix_map[] = {
+    {"DTPOFF",   RS_DTPOFF},
+    {"GOTPCREL", RS_GOTPCREL},
+    {"GOTTPOFF", RS_GOTTPOFF},
+    {"PLT",      RS_PLT},
+    {"TPOFF",    RS_TPOFF},
+};
+static const size_t RELOCATION_SUFFIX_MAP_SIZE = sizeof(relocation_suffix_map) / sizeof(relocation_suffix_map[0]);
+// map from name to segment register overriding the default segment
+static const struct {const char *name; SegmentKind segment;} segment_map[] = {
+    {"fs", SG_FS},
+    {"gs", SG_GS},
+};
+static const size_t SEGMENT_MAP_SIZE = sizeof(segment_map) / sizeof(segment_map[0]);
+// map from name of processor to instruction set extensions supported by it
+static const struct {const char *name; uint8_t extensions;} processor_map[] = {
+    {"core2",     EX_CX16},
+    {"corei7",    EX_CX16 | EX_POPCNT},
+    {"default",   EX_ALL},
+    {"generic64", EX_NONE},
+    {"haswell",   EX_BMI | EX_BMI2 | EX_CX16 | EX_LZCNT | EX_POPCNT},
+    {"skylake",   EX_BMI | EX_BMI2 | EX_CX16 | EX_LZCNT | EX_POPCNT},
+    {"znver1",    EX_BMI | EX_BMI2 | EX_CX16 | EX_LZCNT | EX_POPCNT},
+};
+static const size_t PROCESSOR_MAP_SIZE = sizeof(processor_map) / sizeof(processor_map[0]);
+// map from name of instruction set extension to its kind
+static const struct {const char *name; ExtensionKind extension;} extension_map[] = {
+    {"bmi",    EX_BMI},
+    {"bmi2",   EX_BMI2},
+    {"cx16",   EX_CX16},
+    {"lzcnt",  EX_LZCNT},
+    {"popcnt", EX_POPCNT},
+};
+static const size_t EXTENSION_MAP_SIZE = sizeof(extension_map) / sizeof(extension_map[0]);
 
 
 /*
@@ -59,6 +189,8 @@ void construct(Program *prog)
 {
     statement_list = new_list(Statement)();
     label_list = new_list(Label)();
+    label_map = new_map(Label)();
+    declaration_map = new_map(Symbol)();
     initialize_section();
     initialize_symbol_list();
 
@@ -69,6 +201,31 @@ void construct(Program *prog)
 }
 
 
+/*
+construct program in one pass, handing over statements, labels and symbols of each statement to a function as soon as they are parsed
+* Lists in a fragment are owned by the function, and new lists are made for the next statement.
+* Tokens of a statement are released after it is handed over, so that the input is not kept as a whole.
+*/
+void construct_in_one_pass(void (*consume_fragment)(Program *fragment))
+{
+    label_map = new_map(Label)();
+    declaration_map = new_map(Symbol)();
+    initialize_section();
+
+    while(!at_eof())
+    {
+        statement_list = new_list(Statement)();
+        label_list = new_list(Label)();
+        initialize_symbol_list();
+
+        statement();
+        Program fragment = {statement_list, label_list, get_symbol_list()};
+        consume_fragment(&fragment);
+        release_tokens();
+    }
+}
+
+
 /*
 parse a program
 ```
@@ -88,27 +245,41 @@ static void program(void)
 /*
 parse a statement
 ```
-statement ::= (label ":")? directive | operation
+statement ::= (label ":" annotation-directive*)* (directive | operation)
+annotation-directive ::= ".file" file | ".loc" location | frame-directive
 ```
+* Directives annotating the following statement may be placed between labels and the statement marked by them.
 */
 static void statement(void)
 {
     Token *token;
     List(Label) *labels = new_list(Label)();
-    while(consume_token(TK_IDENTIFIER, &token))
+    while(true)
     {
-        add_list_entry_tail(Label)(labels, parse_label(token));
-        expect_reserved(":");
+        if(consume_token(TK_IDENTIFIER, &token))
+        {
+            add_list_entry_tail(Label)(labels, parse_label(token));
+            expect_reserved(":");
+        }
+        else if((get_length(Label)(labels) > 0) && peek_annotation_directive())
+        {
+            parse_directive(NULL);
+        }
+        else
+        {
+            break;
+        }
     }
 
-    if(consume_token(TK_MNEMONIC, &token))
+    if(peek_token(TK_PREFIX, &token) || peek_token(TK_MNEMONIC, &token))
     {
-        parse_operation(token, labels);
+        parse_operation(labels);
     }
     else
     {
         parse_directive(labels);
     }
+    delete_list(Label)(labels);
 }
 
 
@@ -116,16 +287,28 @@ static void statement(void)
 parse a directive
 ```
 directive ::= ".align" immediate
+            | ".arch" arch
             | ".bss"
             | ".byte" (immediate | symbol (("+" | "-") immediate)?)
+            | frame-directive
             | ".data"
+            | ".file" file
             | ".global" symbol
             | ".globl" symbol
+            | ".hidden" symbol ("," symbol)*
             | ".intel_syntax noprefix"
+            | ".internal" symbol ("," symbol)*
+            | ".loc" location
             | ".long" (immediate | symbol (("+" | "-") immediate)?)
+            | ".popsection"
+            | ".protected" symbol ("," symbol)*
+            | ".pushsection" section
             | ".quad" (immediate | symbol (("+" | "-") immediate)?)
+            | ".section" section
+            | ".size" symbol "," (immediate | "." "-" symbol)
             | ".string" string-literal
             | ".text"
+            | ".type" symbol "," "@" symbol-type
             | ".value" (immediate | symbol (("+" | "-") immediate)?)
             | ".word" (immediate | symbol (("+" | "-") immediate)?)
             | ".zero" immediate
@@ -133,10 +316,16 @@ directive ::= ".align" immediate
 */
 static void parse_directive(List(Label) *labels)
 {
+    Token *token = get_token();
+    size_t index;
     if(consume_reserved(".align"))
     {
         set_current_alignment(expect_token(TK_IMMEDIATE)->value);
     }
+    else if(consume_reserved(".arch"))
+    {
+        parse_directive_arch();
+    }
     else if(consume_reserved(".bss"))
     {
         reset_current_alignment();
@@ -146,30 +335,76 @@ static void parse_directive(List(Label) *labels)
     {
         parse_directive_size(SIZEOF_8BIT, labels);
     }
+    else if(consume_frame_directive(&index))
+    {
+        parse_directive_frame(token, index);
+    }
     else if(consume_reserved(".data"))
     {
         reset_current_alignment();
         set_current_section(".data");
     }
+    else if(consume_reserved(".file"))
+    {
+        parse_directive_file();
+    }
     else if(consume_reserved(".global") || consume_reserved(".globl"))
     {
         Token *token = expect_token(TK_IDENTIFIER);
         Symbol *symbol = new_symbol(token);
         symbol->bind = STB_GLOBAL;
         symbol->declared = true;
+        insert_map(Symbol)(declaration_map, symbol->body, symbol);
+    }
+    else if(consume_reserved(".hidden"))
+    {
+        parse_directive_symbol_visibility(STV_HIDDEN);
     }
     else if(consume_reserved(".intel_syntax noprefix"))
     {
         // do nothing
     }
+    else if(consume_reserved(".internal"))
+    {
+        parse_directive_symbol_visibility(STV_INTERNAL);
+    }
+    else if(consume_reserved(".loc"))
+    {
+        parse_directive_location();
+    }
     else if(consume_reserved(".long"))
     {
         parse_directive_size(SIZEOF_32BIT, labels);
     }
+    else if(consume_reserved(".popsection"))
+    {
+        if(!pop_section())
+        {
+            report_error(NULL, "no section to be popped.");
+        }
+        reset_current_alignment();
+    }
+    else if(consume_reserved(".protected"))
+    {
+        parse_directive_symbol_visibility(STV_PROTECTED);
+    }
+    else if(consume_reserved(".pushsection"))
+    {
+        push_section();
+        parse_directive_section();
+    }
     else if(consume_reserved(".quad"))
     {
         parse_directive_size(SIZEOF_64BIT, labels);
     }
+    else if(consume_reserved(".section"))
+    {
+        parse_directive_section();
+    }
+    else if(consume_reserved(".size"))
+    {
+        parse_directive_symbol_size();
+    }
     else if(consume_reserved(".string"))
     {
         parse_directive_string(labels);
@@ -179,6 +414,10 @@ static void parse_directive(List(Label) *labels)
         reset_current_alignment();
         set_current_section(".text");
     }
+    else if(consume_reserved(".type"))
+    {
+        parse_directive_symbol_type();
+    }
     else if(consume_reserved(".value") || consume_reserved(".word"))
     {
         parse_directive_size(SIZEOF_16BIT, labels);
@@ -194,6 +433,429 @@ static void parse_directive(List(Label) *labels)
 }
 
 
+/*
+check if the next directive annotates the following statement without making any statement
+*/
+static bool peek_annotation_directive(void)
+{
+    for(size_t i = 0; i < FRAME_DIRECTIVE_MAP_SIZE; i++)
+    {
+        if(peek_reserved(frame_directive_map[i].name))
+        {
+            return true;
+        }
+    }
+
+    return peek_reserved(".file") || peek_reserved(".loc");
+}
+
+
+/*
+consume a directive for call frame information, and return its index in the map by argument
+*/
+static bool consume_frame_directive(size_t *index)
+{
+    for(size_t i = 0; i < FRAME_DIRECTIVE_MAP_SIZE; i++)
+    {
+        if(consume_reserved(frame_directive_map[i].name))
+        {
+            *index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+parse directive for call frame information
+```
+frame-directive ::= ".cfi_startproc" "simple"?
+                  | ".cfi_endproc"
+                  | ".cfi_remember_state"
+                  | ".cfi_restore_state"
+                  | (".cfi_def_cfa_register" | ".cfi_restore" | ".cfi_same_value" | ".cfi_undefined") frame-register
+                  | (".cfi_adjust_cfa_offset" | ".cfi_def_cfa_offset") signed-immediate
+                  | (".cfi_def_cfa" | ".cfi_offset" | ".cfi_rel_offset") frame-register "," signed-immediate
+frame-register ::= register | immediate
+signed-immediate ::= "-"? immediate
+```
+* Directives other than .cfi_startproc must be in a procedure started by .cfi_startproc in the current section.
+*/
+static void parse_directive_frame(const Token *token, size_t index)
+{
+    FrameDirectiveKind kind = frame_directive_map[index].kind;
+    if((kind == FD_START_PROCEDURE) && (procedure_section != SC_UND))
+    {
+        report_error(token->str, "previous procedure is not terminated by .cfi_endproc.");
+    }
+    else if((kind != FD_START_PROCEDURE) && (procedure_section != get_current_section()))
+    {
+        report_error(token->str, "directive is out of procedure started by .cfi_startproc in the current section.");
+    }
+
+    FrameDirective *directive = new_frame_directive(kind);
+    if(kind == FD_START_PROCEDURE)
+    {
+        directive->simple = consume_identifier("simple");
+        procedure_section = get_current_section();
+        prepare_eh_frame();
+    }
+    else if(kind == FD_END_PROCEDURE)
+    {
+        procedure_section = SC_UND;
+    }
+
+    if(frame_directive_map[index].takes_register)
+    {
+        directive->reg = parse_frame_register();
+        if(frame_directive_map[index].takes_offset)
+        {
+            expect_reserved(",");
+        }
+    }
+    if(frame_directive_map[index].takes_offset)
+    {
+        directive->offset = parse_signed_immediate();
+    }
+}
+
+
+/*
+parse register for call frame information, which is given by its name or DWARF number
+*/
+static Elf_Word parse_frame_register(void)
+{
+    Token *token;
+    if(consume_token(TK_IMMEDIATE, &token))
+    {
+        return token->value;
+    }
+
+    token = expect_token(TK_REGISTER);
+    Elf_Word number = 0;
+    if(!get_frame_register(get_register_info(token)->reg_kind, &number))
+    {
+        report_error(token->str, "unsupported register for call frame information.");
+    }
+
+    return number;
+}
+
+
+/*
+parse an immediate which may be negative
+*/
+static Elf_Sxword parse_signed_immediate(void)
+{
+    bool negative = consume_reserved("-");
+    Elf_Sxword value = expect_token(TK_IMMEDIATE)->value;
+
+    return negative ? -value : value;
+}
+
+
+/*
+parse directive for instruction set extensions enabled for the following instructions
+```
+".arch" arch
+arch ::= processor | "." extension | ".no" extension
+processor ::= "core2" | "corei7" | "default" | "generic64" | "haswell" | "skylake" | "znver1"
+extension ::= "bmi" | "bmi2" | "cx16" | "lzcnt" | "popcnt"
+```
+* A processor replaces the set of enabled extensions with those supported by it, and an extension is enabled or disabled individually.
+* Instructions following the directive other than "default" are assumed to be selected at runtime, so that they are not needed by the object.
+*/
+static void parse_directive_arch(void)
+{
+    for(size_t i = 0; i < PROCESSOR_MAP_SIZE; i++)
+    {
+        if(consume_identifier(processor_map[i].name))
+        {
+            enabled_extensions = processor_map[i].extensions;
+            arch_specified = (strcmp(processor_map[i].name, "default") != 0);
+            return;
+        }
+    }
+
+    Token *token = expect_token(TK_IDENTIFIER);
+    bool disabled = (token->len > 3) && (strncmp(token->str, ".no", 3) == 0);
+    size_t offset = disabled ? 3 : 1;
+    if(token->str[0] == '.')
+    {
+        for(size_t i = 0; i < EXTENSION_MAP_SIZE; i++)
+        {
+            const char *name = extension_map[i].name;
+            if((strlen(name) == token->len - offset) && (strncmp(name, token->str + offset, token->len - offset) == 0))
+            {
+                enabled_extensions = disabled ? (enabled_extensions & ~extension_map[i].extension) : (enabled_extensions | extension_map[i].extension);
+                arch_specified = true;
+                return;
+            }
+        }
+    }
+
+    report_error(token->str, "unsupported processor or extension.");
+}
+
+
+/*
+parse directive for file
+```
+".file" file
+file ::= string-literal | immediate string-literal string-literal?
+```
+* A file without number names the source file, which is ignored since no symbol of file is made.
+* A numbered file is given by its name or by its directory and name, and is referred by .loc directive.
+*/
+static void parse_directive_file(void)
+{
+    Token *token;
+    if(consume_token(TK_STRING, &token))
+    {
+        return;
+    }
+
+    Elf_Word number = expect_token(TK_IMMEDIATE)->value;
+    const char *directory = NULL;
+    const char *name = parse_string_literal(expect_token(TK_STRING));
+    if(consume_token(TK_STRING, &token))
+    {
+        directory = name;
+        name = parse_string_literal(token);
+    }
+    set_line_file(number, directory, name);
+}
+
+
+/*
+parse directive for source location
+```
+".loc" location
+location ::= immediate immediate immediate? location-option*
+location-option ::= "is_stmt" immediate | "discriminator" immediate | "prologue_end" | "epilogue_begin"
+```
+* The location is attached to the next instruction.
+*/
+static void parse_directive_location(void)
+{
+    Token *token = expect_token(TK_IMMEDIATE);
+    if(!has_line_file(token->value))
+    {
+        report_error(token->str, "file %ju is not given by .file directive.", token->value);
+    }
+
+    SourceLocation *location = calloc(1, sizeof(SourceLocation));
+    location->file = token->value;
+    location->line = expect_token(TK_IMMEDIATE)->value;
+    location->column = consume_token(TK_IMMEDIATE, &token) ? token->value : 0;
+    location->flags = LF_NONE;
+    location->discriminator = 0;
+    while(true)
+    {
+        if(consume_identifier("is_stmt"))
+        {
+            location_is_stmt = (expect_token(TK_IMMEDIATE)->value != 0);
+        }
+        else if(consume_identifier("discriminator"))
+        {
+            location->discriminator = expect_token(TK_IMMEDIATE)->value;
+        }
+        else if(consume_identifier("prologue_end"))
+        {
+            location->flags |= LF_PROLOGUE_END;
+        }
+        else if(consume_identifier("epilogue_begin"))
+        {
+            location->flags |= LF_EPILOGUE_BEGIN;
+        }
+        else
+        {
+            break;
+        }
+    }
+    location->flags |= location_is_stmt ? LF_IS_STMT : LF_NONE;
+
+    // a location not followed by any instruction is replaced
+    free(pending_location);
+    pending_location = location;
+}
+
+
+/*
+consume an identifier of a given name
+*/
+static bool consume_identifier(const char *name)
+{
+    Token *token;
+    if(!peek_token(TK_IDENTIFIER, &token) || (strlen(name) != token->len) || (strncmp(token->str, name, token->len) != 0))
+    {
+        return false;
+    }
+
+    return consume_token(TK_IDENTIFIER, &token);
+}
+
+
+/*
+parse a string-literal into a null-terminated string, converting escape sequences
+*/
+static const char *parse_string_literal(const Token *token)
+{
+    char *string = calloc(token->len + 1, sizeof(char));
+    size_t size = 0;
+    for(size_t len = 0; len < token->len; size++)
+    {
+        int value;
+        len += convert_escape_sequence(&token->str[len], &value);
+        string[size] = value;
+    }
+
+    return string;
+}
+
+
+/*
+parse directive for section
+```
+section ::= section-name ("," string-literal ("," "@" identifier ("," immediate)? ("," symbol ("," "comdat")?)?)?)?
+```
+* Type and flags of section are determined by its name unless they are specified.
+* A section with flag 'G' is a member of the group named by the symbol, which is a COMDAT group if "comdat" follows.
+*/
+static void parse_directive_section(void)
+{
+    Token *token = get_token();
+    const char *name = parse_section_name();
+    Elf_Word type;
+    Elf_Xword flags;
+    Elf_Xword entry_size;
+    const char *signature = NULL;
+    Elf_Word group_flags = 0;
+    get_default_section_attributes(name, &type, &flags, &entry_size);
+    if(consume_reserved(","))
+    {
+        flags = parse_section_flags(expect_token(TK_STRING));
+        if(consume_reserved(","))
+        {
+            expect_reserved("@");
+            type = parse_section_type(expect_token(TK_IDENTIFIER));
+            Token *operand;
+            bool separated = consume_reserved(",");
+            if(separated && consume_token(TK_IMMEDIATE, &operand))
+            {
+                entry_size = operand->value;
+                separated = consume_reserved(",");
+            }
+            if(separated)
+            {
+                signature = make_identifier(expect_token(TK_IDENTIFIER));
+                if(consume_reserved(","))
+                {
+                    if(!consume_identifier("comdat"))
+                    {
+                        report_error(NULL, "expected 'comdat'.");
+                    }
+                    group_flags = GRP_COMDAT;
+                }
+            }
+        }
+    }
+
+    if((flags & SHF_MERGE) && (entry_size == 0))
+    {
+        report_error(token->str, "entry size of mergeable section '%s' is not specified.", name);
+    }
+    if(((flags & SHF_GROUP) != 0) != (signature != NULL))
+    {
+        report_error(token->str, "group of section '%s' is specified without flag 'G' or vice versa.", name);
+    }
+
+    Group *group = NULL;
+    if(signature != NULL)
+    {
+        // group section is made before its members
+        group = make_group(signature, group_flags);
+        if(group == NULL)
+        {
+            report_error(token->str, "group '%s' is already made with different linkage.", signature);
+        }
+    }
+
+    reset_current_alignment();
+    Section *section = make_section(name, type, flags, entry_size);
+    if((group != NULL) && !add_group_member(group, section))
+    {
+        report_error(token->str, "section '%s' already exists out of group '%s'.", name, signature);
+    }
+    set_current_section(name);
+}
+
+
+/*
+parse name of section, which may be the same as a directive switching section
+*/
+static const char *parse_section_name(void)
+{
+    Token *token = get_token();
+    if(!consume_token(TK_IDENTIFIER, &token) && !consume_reserved(".bss") && !consume_reserved(".data") && !consume_reserved(".text"))
+    {
+        report_error(NULL, "expected name of section.");
+    }
+
+    return make_identifier(token);
+}
+
+
+/*
+parse flags of section
+*/
+static Elf_Xword parse_section_flags(const Token *token)
+{
+    Elf_Xword flags = 0;
+    for(size_t i = 0; i < token->len; i++)
+    {
+        bool found = false;
+        for(size_t j = 0; j < SECTION_FLAG_MAP_SIZE; j++)
+        {
+            if(section_flag_map[j].character == token->str[i])
+            {
+                flags |= section_flag_map[j].flag;
+                found = true;
+                break;
+            }
+        }
+
+        if(!found)
+        {
+            report_error(&token->str[i], "unsupported flag of section '%c'.", token->str[i]);
+        }
+    }
+
+    return flags;
+}
+
+
+/*
+parse type of section
+*/
+static Elf_Word parse_section_type(const Token *token)
+{
+    for(size_t i = 0; i < SECTION_TYPE_MAP_SIZE; i++)
+    {
+        const char *name = section_type_map[i].name;
+        if((strlen(name) == token->len) && (strncmp(token->str, name, token->len) == 0))
+        {
+            return section_type_map[i].type;
+        }
+    }
+
+    report_error(token->str, "unsupported type of section.");
+    return SHT_NULL;
+}
+
+
 /*
 parse directive for size
 */
@@ -261,14 +923,89 @@ parse directive for zero
 static void parse_directive_zero(List(Label) *labels)
 {
     size_t size = expect_token(TK_IMMEDIATE)->value;
-    if(get_current_section() == SC_DATA)
+    if(get_section(get_current_section())->type == SHT_NOBITS)
     {
-        new_data_immediate(size, 0, labels);
+        new_bss(size, labels);
     }
     else
     {
-        new_bss(size, labels);
+        new_data_immediate(size, 0, labels);
+    }
+}
+
+
+/*
+parse directive for size of symbol
+```
+".size" symbol "," (immediate | "." "-" symbol)
+```
+* The location "." is that of the directive in the current section, which is determined after statements are laid out.
+*/
+static void parse_directive_symbol_size(void)
+{
+    SymbolAttribute *attribute = new_symbol_attribute(AT_SIZE, expect_token(TK_IDENTIFIER));
+    expect_reserved(",");
+
+    Token *token;
+    if(consume_token(TK_IMMEDIATE, &token))
+    {
+        attribute->size = token->value;
+        return;
+    }
+
+    token = expect_token(TK_IDENTIFIER);
+    if((token->len != 1) || (token->str[0] != '.'))
+    {
+        report_error(token->str, "expected immediate or '.'.");
+    }
+    expect_reserved("-");
+    attribute->origin = make_identifier(expect_token(TK_IDENTIFIER));
+}
+
+
+/*
+parse directive for type of symbol
+```
+".type" symbol "," "@" symbol-type
+symbol-type ::= "function" | "gnu_indirect_function" | "notype" | "object" | "tls_object"
+```
+*/
+static void parse_directive_symbol_type(void)
+{
+    SymbolAttribute *attribute = new_symbol_attribute(AT_TYPE, expect_token(TK_IDENTIFIER));
+    expect_reserved(",");
+    expect_reserved("@");
+
+    Token *token = expect_token(TK_IDENTIFIER);
+    for(size_t i = 0; i < SYMBOL_TYPE_MAP_SIZE; i++)
+    {
+        if((strlen(symbol_type_map[i].name) == token->len) && (strncmp(symbol_type_map[i].name, token->str, token->len) == 0))
+        {
+            attribute->type = symbol_type_map[i].type;
+            return;
+        }
     }
+
+    report_error(token->str, "unsupported type of symbol.");
+}
+
+
+/*
+parse directive for visibility of symbols
+```
+(".hidden" | ".internal" | ".protected") symbol ("," symbol)*
+```
+* A symbol is made for each name, so that a name which is neither defined nor referred is registered as an undefined symbol.
+*/
+static void parse_directive_symbol_visibility(unsigned char visibility)
+{
+    do
+    {
+        Token *token = expect_token(TK_IDENTIFIER);
+        SymbolAttribute *attribute = new_symbol_attribute(AT_VISIBILITY, token);
+        attribute->visibility = visibility;
+        new_symbol(token)->attributed = true;
+    } while(consume_reserved(","));
 }
 
 
@@ -278,29 +1015,77 @@ parse a label
 static Label *parse_label(const Token *token)
 {
     Symbol *symbol = new_symbol(token);
+    select_label_section(symbol);
     symbol->located = get_current_section();
     symbol->labeled = true;
 
-    if(search_label(label_list, symbol) != NULL)
+    Label *label = new_label(symbol);
+    if(insert_map(Label)(label_map, symbol->body, label) != label)
     {
         report_error(NULL, "duplicated label '%s'", symbol->body);
     }
 
-    return new_label(symbol);
+    return label;
+}
+
+
+/*
+switch to a section dedicated to a global label if function sections or data sections are enabled
+* Only labels declared as global before they are defined are placed in their own sections.
+*/
+static void select_label_section(const Symbol *symbol)
+{
+    if(search_map(Symbol)(declaration_map, symbol->body) == NULL)
+    {
+        return;
+    }
+
+    const Option *option = get_option();
+    SectionKind base = get_base_section();
+    const char *name = get_section(base)->name;
+    for(size_t i = 0; i < LABEL_SECTION_BASE_MAP_SIZE; i++)
+    {
+        if(strcmp(name, label_section_base_map[i].name) == 0)
+        {
+            if(label_section_base_map[i].executable ? option->function_sections : option->data_sections)
+            {
+                set_label_section(base, symbol->body);
+                set_current_alignment(get_current_alignment());
+            }
+            return;
+        }
+    }
 }
 
 
 /*
 parse an operation
 ```
-operation ::= mnemonic operands?
+operation ::= prefix? mnemonic operands?
 ```
 */
-static Operation *parse_operation(const Token *token, List(Label) *labels)
+static Operation *parse_operation(List(Label) *labels)
 {
+    Token *token;
+    PrefixKind prefix = PF_NONE;
+    if(consume_token(TK_PREFIX, &token))
+    {
+        prefix = parse_prefix(token);
+    }
+
+    token = expect_token(TK_MNEMONIC);
     const MnemonicInfo *map = parse_mnemonic(token);
+    if((map->extensions & ~enabled_extensions) != 0)
+    {
+        report_error(token->str, "'%s' is not enabled by .arch directive.", make_identifier(token));
+    }
+    const List(Operand) *operands = map->take_operands ? parse_operands() : NULL;
+    if(!is_acceptable_prefix(prefix, map, operands))
+    {
+        report_error(token->str, "invalid prefix for '%s'.", make_identifier(token));
+    }
 
-    return new_operation(map->kind, map->take_operands ? parse_operands() : NULL, labels);
+    return new_operation(map->kind, prefix, operands, labels);
 }
 
 
@@ -323,6 +1108,26 @@ static const MnemonicInfo *parse_mnemonic(const Token *token)
 }
 
 
+/*
+parse an instruction prefix
+*/
+static PrefixKind parse_prefix(const Token *token)
+{
+    for(size_t i = 0; i < PREFIX_INFO_LIST_SIZE; i++)
+    {
+        const PrefixInfo *info = &prefix_info_list[i];
+        if((token->len == strlen(info->name)) && (strncmp(token->str, info->name, token->len) == 0))
+        {
+            return info->kind;
+        }
+    }
+
+    report_error(token->str, "invalid prefix '%s'.", make_identifier(token));
+
+    return PF_NONE;
+}
+
+
 /*
 parse operands
 ```
@@ -345,7 +1150,7 @@ static List(Operand) *parse_operands(void)
 /*
 parse an operand
 ```
-operand ::= immediate | register | memory | symbol
+operand ::= immediate | register | memory | symbol ("@" "PLT")?
 ```
 */
 static Operand *parse_operand(void)
@@ -385,6 +1190,11 @@ static Statement *new_statement(StatementKind kind, List(Label) *labels)
     statement->kind = kind;
     statement->section = get_current_section();
     statement->alignment = current_alignment;
+    if(kind == ST_INSTRUCTION)
+    {
+        statement->location = pending_location;
+        pending_location = NULL;
+    }
 
     // update list of statements
     add_list_entry_tail(Statement)(statement_list, statement);
@@ -434,6 +1244,47 @@ static Bss *new_bss(size_t size, List(Label) *labels)
 }
 
 
+/*
+make a new attribute of symbol
+* Attribute is a statement of no size, which is not aligned so as to mark the location of the directive.
+*/
+static SymbolAttribute *new_symbol_attribute(AttributeKind kind, const Token *token)
+{
+    SymbolAttribute *attribute = calloc(1, sizeof(SymbolAttribute));
+    attribute->kind = kind;
+    attribute->name = make_identifier(token);
+    attribute->type = STT_NOTYPE;
+    attribute->visibility = STV_DEFAULT;
+    attribute->size = 0;
+    attribute->origin = NULL;
+
+    Statement *statement = new_statement(ST_ATTRIBUTE, NULL);
+    statement->alignment = 1;
+    statement->attribute = attribute;
+
+    return attribute;
+}
+
+
+/*
+make a new directive for call frame information
+*/
+static FrameDirective *new_frame_directive(FrameDirectiveKind kind)
+{
+    FrameDirective *directive = calloc(1, sizeof(FrameDirective));
+    directive->kind = kind;
+    directive->reg = 0;
+    directive->offset = 0;
+    directive->simple = false;
+
+    Statement *statement = new_statement(ST_FRAME, NULL);
+    statement->alignment = 1;
+    statement->frame = directive;
+
+    return directive;
+}
+
+
 /*
 make a new data
 */
@@ -493,11 +1344,13 @@ static Data *new_data_string(const char *str, List(Label) *labels, size_t *len)
 /*
 make a new operation
 */
-static Operation *new_operation(MnemonicKind kind, const List(Operand) *operands, List(Label) *labels)
+static Operation *new_operation(MnemonicKind kind, PrefixKind prefix, const List(Operand) *operands, List(Label) *labels)
 {
     Operation *operation = calloc(1, sizeof(Operation));
     operation->kind = kind;
+    operation->prefix = prefix;
     operation->operands = operands;
+    operation->arch_specified = arch_specified;
 
     Statement *statement = new_statement(ST_INSTRUCTION, labels);
     statement->operation = operation;
@@ -567,21 +1420,53 @@ static Operand *new_operand_register(const Token *token)
 
 /*
 make a new operand for memory
+* Memory without base register is addressed by displacement, which is typically an offset from the thread pointer.
+* Symbols relative to rip and offsets of symbols in TLS are distinguished by their suffixes.
 */
 static Operand *new_operand_memory(OperandKind kind)
 {
     Operand *operand = new_operand(kind);
+    operand->segment = parse_segment();
+
+    // absolute address in segment may be written without brackets
+    Token *token;
+    if((operand->segment != SG_NONE) && consume_token(TK_IMMEDIATE, &token))
+    {
+        operand->reg = REG_NONE;
+        operand->immediate = token->value;
+        return operand;
+    }
 
     expect_reserved("[");
-    Token *token = expect_token(TK_REGISTER);
-    operand->reg = get_register_info(token)->reg_kind;
+    bool displacement = false;
+    if(consume_token(TK_REGISTER, &token))
+    {
+        operand->reg = get_register_info(token)->reg_kind;
+    }
+    else
+    {
+        operand->reg = REG_NONE;
+        displacement = true;
+    }
     while(true)
     {
-        if(consume_reserved("+"))
+        if(displacement || consume_reserved("+"))
         {
+            displacement = false;
             if(consume_token(TK_IDENTIFIER, &token))
             {
                 operand->symbol = new_symbol(token);
+                operand->symbol->suffix = parse_relocation_suffix();
+                RelocationSuffix suffix = operand->symbol->suffix;
+                bool relative = (suffix == RS_NONE) || (suffix == RS_GOTPCREL) || (suffix == RS_GOTTPOFF);
+                if(suffix == RS_PLT)
+                {
+                    report_error(token->str, "unsupported suffix of symbol in memory.");
+                }
+                else if(relative != (operand->reg == REG_RIP))
+                {
+                    report_error(token->str, relative ? "symbol is referred only relative to rip." : "offset of symbol in TLS is not relative to rip.");
+                }
             }
             else
             {
@@ -610,26 +1495,61 @@ static Operand *new_operand_symbol(const Token *token)
 {
     Operand *operand = new_operand(OP_SYMBOL);
     operand->symbol = new_symbol(token);
+    operand->symbol->suffix = parse_relocation_suffix();
+    if((operand->symbol->suffix != RS_NONE) && (operand->symbol->suffix != RS_PLT))
+    {
+        report_error(token->str, "unsupported suffix of symbol as operand.");
+    }
 
     return operand;
 }
 
 
 /*
-search label by name
+parse suffix of symbol designating kind of relocation
+```
+relocation-suffix ::= ("@" ("DTPOFF" | "GOTPCREL" | "GOTTPOFF" | "PLT" | "TPOFF"))?
+```
 */
-Label *search_label(const List(Label) *label_list, const Symbol *symbol)
+static RelocationSuffix parse_relocation_suffix(void)
 {
-    for_each_entry(Label, cursor, label_list)
+    if(!consume_reserved("@"))
+    {
+        return RS_NONE;
+    }
+
+    const Token *token = expect_token(TK_IDENTIFIER);
+    for(size_t i = 0; i < RELOCATION_SUFFIX_MAP_SIZE; i++)
     {
-        Label *label = get_element(Label)(cursor);
-        if(strcmp(label->symbol->body, symbol->body) == 0)
+        if((strlen(relocation_suffix_map[i].name) == token->len) && (strncmp(relocation_suffix_map[i].name, token->str, token->len) == 0))
         {
-            return label;
+            return relocation_suffix_map[i].suffix;
         }
     }
 
-    return NULL;
+    report_error(token->str, "unsupported suffix of symbol.");
+    return RS_NONE;
+}
+
+
+/*
+parse segment register overriding the default segment of memory
+```
+segment ::= (("fs" | "gs") ":")?
+```
+*/
+static SegmentKind parse_segment(void)
+{
+    for(size_t i = 0; i < SEGMENT_MAP_SIZE; i++)
+    {
+        if(consume_identifier(segment_map[i].name))
+        {
+            expect_reserved(":");
+            return segment_map[i].segment;
+        }
+    }
+
+    return SG_NONE;
 }
 
 
@@ -654,7 +1574,7 @@ static const RegisterInfo *get_register_info(const Token *token)
 /*
 consume a size specifier
 ```
-size-specifier ::= "byte ptr" | "word ptr" | "dword ptr" | "qword ptr"
+size-specifier ::= "byte ptr" | "word ptr" | "dword ptr" | "qword ptr" | "xmmword ptr"
 ```
 */
 static bool consume_size_specifier(OperandKind *kind)
@@ -677,6 +1597,10 @@ static bool consume_size_specifier(OperandKind *kind)
     {
         *kind = OP_M64;
     }
+    else if(consume_reserved("xmmword ptr"))
+    {
+        *kind = OP_M128;
+    }
     else
     {
         consumed = false;
@@ -686,6 +1610,45 @@ static bool consume_size_specifier(OperandKind *kind)
 }
 
 
+/*
+check if an instruction prefix is acceptable for an operation
+* The lock prefix requires a memory destination, which can be either operand of xchg.
+*/
+static bool is_acceptable_prefix(PrefixKind prefix, const MnemonicInfo *map, const List(Operand) *operands)
+{
+    if(prefix == PF_NONE)
+    {
+        return true;
+    }
+    if((map->prefixes & prefix) == 0)
+    {
+        return false;
+    }
+    if(prefix != PF_LOCK)
+    {
+        return true;
+    }
+
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
+    if(is_memory_operand(get_element(Operand)(entry)->kind))
+    {
+        return true;
+    }
+
+    entry = next_entry(Operand, entry);
+    return (map->kind == MN_XCHG) && !end_iteration(Operand)(operands, entry) && is_memory_operand(get_element(Operand)(entry)->kind);
+}
+
+
+/*
+check if kind of operand is memory
+*/
+static bool is_memory_operand(OperandKind kind)
+{
+    return (kind == OP_M8) || (kind == OP_M16) || (kind == OP_M32) || (kind == OP_M64) || (kind == OP_M128);
+}
+
+
 /*
 get current alignment
 */
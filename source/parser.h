@@ -4,15 +4,19 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "debug_line.h"
+#include "eh_frame.h"
 #include "elf_wrap.h"
 #include "processor.h"
 #include "section.h"
 #include "symbol.h"
 
+typedef enum AttributeKind AttributeKind;
 typedef enum StatementKind StatementKind;
 typedef struct Label Label;
 typedef struct Program Program;
 typedef struct Statement Statement;
+typedef struct SymbolAttribute SymbolAttribute;
 
 #include "list.h"
 define_list(Label)
@@ -24,6 +28,27 @@ enum StatementKind
     ST_INSTRUCTION, // instruction
     ST_VALUE,       // .byte, .word, .dword, .qword directive
     ST_ZERO,        // .zero directive
+    ST_ATTRIBUTE,   // .hidden, .internal, .protected, .size, .type directive
+    ST_FRAME,       // .cfi_* directive
+};
+
+// kind of attribute of symbol
+enum AttributeKind
+{
+    AT_SIZE,       // size of symbol
+    AT_TYPE,       // type of symbol
+    AT_VISIBILITY, // visibility of symbol
+};
+
+// structure for attribute of symbol
+struct SymbolAttribute
+{
+    AttributeKind kind;       // kind of attribute
+    const char *name;         // name of symbol
+    unsigned char type;       // type of symbol
+    unsigned char visibility; // visibility of symbol
+    Elf_Xword size;           // size of symbol
+    const char *origin;       // name of symbol whose address is subtracted from the location of the directive to obtain the size (NULL if size is immediate)
 };
 
 // structure for label
@@ -48,15 +73,18 @@ struct Statement
     SectionKind section;      // section of statement
     Elf_Addr address;         // address of statement
     Elf_Xword alignment;      // alignment of statement
+    SourceLocation *location; // source location given by .loc directive (NULL if not given)
     union
     {
         Operation *operation; // instruction
         Data *data;           // .byte, .word, .dword, .qword directive
         Bss *bss;             // .zero directive
+        SymbolAttribute *attribute; // .hidden, .internal, .protected, .size, .type directive
+        FrameDirective *frame;      // .cfi_* directive
     };
 };
 
 void construct(Program *prog);
-Label *search_label(const List(Label) *label_list, const Symbol *symbol);
+void construct_in_one_pass(void (*consume_fragment)(Program *fragment));
 
 #endif /* !PARSER_H */
@@ -2,8 +2,11 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "buffer.h"
+#include "note_property.h"
 #include "processor.h"
 #include "section.h"
 #include "symbol.h"
@@ -11,8 +14,13 @@
 #define min(a, b)    ((a) < (b) ? (a) : (b))
 
 typedef enum ConditionCode ConditionCode;
+typedef enum EncodingPrefix EncodingPrefix;
+typedef enum ModRMRole ModRMRole;
+typedef enum OperandPattern OperandPattern;
 typedef struct BinaryOperationOpecode BinaryOperationOpecode;
-typedef struct UnaryOperationOpecode UnaryOperationOpecode;
+typedef struct InstructionEncoding InstructionEncoding;
+typedef struct InstructionEncodingRange InstructionEncodingRange;
+typedef struct VexOperationOpecode VexOperationOpecode;
 
 enum ConditionCode
 {
@@ -26,6 +34,59 @@ enum ConditionCode
     CC_NE  = 0x05,
     CC_NL  = 0x0d,
     CC_NLE = 0x0f,
+    CC_NO  = 0x01,
+    CC_NP  = 0x0b,
+    CC_NS  = 0x09,
+    CC_O   = 0x00,
+    CC_P   = 0x0a,
+    CC_S   = 0x08,
+};
+
+// prefixes of instruction encoding
+enum EncodingPrefix
+{
+    EP_NONE  = 0x00, // no prefix
+    EP_66    = 0x01, // operand size override or mandatory prefix 0x66
+    EP_F2    = 0x02, // mandatory prefix 0xf2
+    EP_F3    = 0x04, // mandatory prefix 0xf3
+    EP_REX_W = 0x08, // REX prefix with W bit
+};
+
+// role of ModR/M byte
+enum ModRMRole
+{
+    MR_0,    // reg field is an opecode extension 0
+    MR_1,    // reg field is an opecode extension 1
+    MR_2,    // reg field is an opecode extension 2
+    MR_3,    // reg field is an opecode extension 3
+    MR_4,    // reg field is an opecode extension 4
+    MR_5,    // reg field is an opecode extension 5
+    MR_6,    // reg field is an opecode extension 6
+    MR_7,    // reg field is an opecode extension 7
+    MR_REG,  // reg field specifies the register operand
+    MR_NONE, // no ModR/M byte
+};
+
+// pattern of operand in instruction encoding
+enum OperandPattern
+{
+    OPP_NONE,  // no operand
+    OPP_IMM8,  // 8-bit immediate
+    OPP_IMM16, // 16-bit immediate
+    OPP_IMM32, // 32-bit immediate
+    OPP_M8,    // 8-bit memory
+    OPP_M16,   // 16-bit memory
+    OPP_M32,   // 32-bit memory
+    OPP_M64,   // 64-bit memory
+    OPP_M128,  // 128-bit memory
+    OPP_R8,    // 8-bit register
+    OPP_R16,   // 16-bit register
+    OPP_R32,   // 32-bit register
+    OPP_R64,   // 64-bit register
+    OPP_RM8,   // 8-bit register or memory
+    OPP_RM16,  // 16-bit register or memory
+    OPP_RM32,  // 32-bit register or memory
+    OPP_RM64,  // 64-bit register or memory
 };
 
 struct BinaryOperationOpecode
@@ -42,65 +103,90 @@ struct BinaryOperationOpecode
     uint8_t rm;           // encoding of type RM
 };
 
-struct UnaryOperationOpecode
+// structure for an encoding of instruction generated from the instruction specification
+struct InstructionEncoding
 {
-    uint8_t op_byte;   // opecode for 8-bit operands
-    uint8_t op;        // opecode
-    uint8_t reg_field; // reg field
+    MnemonicKind kind;                  // kind of mnemonic
+    size_t operand_number;              // number of operands
+    OperandPattern operand_patterns[2]; // patterns of operands
+    uint8_t prefixes;                   // set of prefixes
+    uint32_t opecode;                   // opecode
+    ModRMRole modrm;                    // role of ModR/M byte
+    size_t imm_size;                    // size of immediate
 };
 
+// structure for range of encodings of a mnemonic in the list of encodings
+struct InstructionEncodingRange
+{
+    size_t start;  // index of the first encoding
+    size_t number; // number of encodings
+};
+
+struct VexOperationOpecode
+{
+    uint8_t pp;        // implied mandatory prefix
+    uint8_t map;       // implied leading opecode bytes
+    uint8_t opecode;   // opecode
+    uint8_t reg_field; // reg field for encoding of type VM
+};
+
+#include "instruction_table.h"
+
 static void generate_op_add(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_and(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_andn(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_bextr(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_blsi(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_blsmsk(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_blsr(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_bzhi(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_call(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_cdq(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_cmp(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_cqo(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_cwd(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_idiv(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_imul(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jb(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jbe(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_je(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jecxz(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jl(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jle(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jmp(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jnb(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jnbe(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jne(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jnl(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_jnle(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jno(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jnp(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jns(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jo(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jp(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_jrcxz(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_js(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_lea(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_leave(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_mov(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_movsx(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_movsxd(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_movzx(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_neg(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_nop(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_not(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_mulx(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_or(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_pdep(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_pext(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_pop(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_push(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_pushfq(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_ret(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_rorx(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_sal(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_sar(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setb(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setbe(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_sete(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setl(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setle(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setnb(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setnbe(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setne(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setnl(const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setnle(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_sarx(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_shlx(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_shr(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_shrx(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_sub(const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_op_xchg(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_xor(const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_binary_arithmetic_operation(const BinaryOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_unary_arithmetic_operation(const UnaryOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_vex_operation_rmv(const VexOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_vex_operation_rvm(const VexOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_vex_operation_vm(const VexOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer);
+static void generate_encoded_operation(const Operation *operation, ByteBufferType *buffer);
+static const InstructionEncoding *search_instruction_encoding(const Operation *operation);
 static void generate_op_jcc(ConditionCode code, const List(Operand) *operands, ByteBufferType *buffer);
-static void generate_op_setcc(ConditionCode code, const List(Operand) *operands, ByteBufferType *buffer);
 static void generate_op_shift(uint8_t rm, const List(Operand) *operands, ByteBufferType *buffer);
 static bool is_immediate(OperandKind kind);
 static bool is_register(OperandKind kind);
@@ -109,6 +195,7 @@ static bool is_register_or_memory(OperandKind kind);
 static bool is_eax_register(RegisterKind kind);
 static bool is_type_i_encoding(const Operand *operand1, const Operand *operand2);
 static bool is_signed_immediate(uintmax_t imm, size_t size);
+static bool is_matching_operand_pattern(const Operand *operand, OperandPattern pattern);
 static size_t get_operand_size(OperandKind kind);
 static uint8_t get_register_index(RegisterKind kind);
 static uint8_t get_rex_prefix(const Operand *operand, size_t prefix_position, bool specify_size);
@@ -116,6 +203,7 @@ static uint8_t get_rex_prefix_for_size(const Operand *operand);
 static uint8_t get_rex_prefix_from_position(size_t prefix_position);
 static uint8_t get_modrm_byte(uint8_t mod, uint8_t reg, uint8_t rm);
 static uint8_t get_sib_byte(uint8_t ss, uint8_t index, uint8_t base);
+static size_t get_disp_size(const Operand *operand);
 static uint8_t get_mod_field(const Operand *operand);
 static uint8_t get_reg_field(RegisterKind kind);
 static uint8_t get_rm_field(RegisterKind kind);
@@ -129,79 +217,193 @@ static void append_binary_imm(uintmax_t imm, size_t size, ByteBufferType *buffer
 static void append_binary_imm_least(uintmax_t imm, ByteBufferType *buffer);
 static void append_binary_imm32(uint32_t imm32, ByteBufferType *buffer);
 static void append_binary_relocation(size_t size, Symbol *symbol, Elf_Addr address, Elf_Sxword addend, ByteBufferType *buffer);
+static void append_binary_branch_target(Symbol *symbol, ByteBufferType *buffer);
+static void set_got_relaxation(const Operation *operation, Elf_Addr start, const ByteBufferType *buffer);
+static void append_binary_vex_prefix(const VexOperationOpecode *opecode, const Operand *operand_reg, const Operand *operand_vvvv, const Operand *operand_rm, ByteBufferType *buffer);
 static void may_append_binary_instruction_prefix(OperandKind kind, uint8_t prefix, ByteBufferType *buffer);
+static void may_append_binary_segment_prefix(const List(Operand) *operands, ByteBufferType *buffer);
 static void may_append_binary_rex_prefix_reg_rm(const Operand *operand_reg, const Operand *operand_rm, bool specify_size, ByteBufferType *buffer);
 static void may_append_binary_rex_prefix_reg(const Operand *operand, bool specify_size, ByteBufferType *buffer);
 
 const MnemonicInfo mnemonic_info_list[] = 
 {
-    {MN_ADD,    "add",    true,  generate_op_add},
-    {MN_AND,    "and",    true,  generate_op_and},
-    {MN_CALL,   "call",   true,  generate_op_call},
-    {MN_CDQ,    "cdq",    false, generate_op_cdq},
-    {MN_CMP,    "cmp",    true,  generate_op_cmp},
-    {MN_CQO,    "cqo",    false, generate_op_cqo},
-    {MN_CWD,    "cwd",    false, generate_op_cwd},
-    {MN_IDIV,   "idiv",   true,  generate_op_idiv},
-    {MN_IMUL,   "imul",   true,  generate_op_imul},
-    {MN_JA,     "ja",     true,  generate_op_jnbe},
-    {MN_JB,     "jb",     true,  generate_op_jb},
-    {MN_JBE,    "jbe",    true,  generate_op_jbe},
-    {MN_JE,     "je",     true,  generate_op_je},
-    {MN_JG,     "jg",     true,  generate_op_jnle},
-    {MN_JGE,    "jge",    true,  generate_op_jnl},
-    {MN_JL,     "jl",     true,  generate_op_jl},
-    {MN_JLE,    "jle",    true,  generate_op_jle},
-    {MN_JMP,    "jmp",    true,  generate_op_jmp},
-    {MN_JNA,    "jna",    true,  generate_op_jbe},
-    {MN_JNAE,   "jnae",   true,  generate_op_jb},
-    {MN_JNBE,   "jnbe",   true,  generate_op_jnbe},
-    {MN_JNE,    "jne",    true,  generate_op_jne},
-    {MN_JNG,    "jng",    true,  generate_op_jle},
-    {MN_JNGE,   "jnge",   true,  generate_op_jl},
-    {MN_JNL,    "jnl",    true,  generate_op_jnl},
-    {MN_JNLE,   "jnle",   true,  generate_op_jnle},
-    {MN_LEA,    "lea",    true,  generate_op_lea},
-    {MN_LEAVE,  "leave",  false, generate_op_leave},
-    {MN_MOV,    "mov",    true,  generate_op_mov},
-    {MN_MOVSX,  "movsx",  true,  generate_op_movsx},
-    {MN_MOVSXD, "movsxd", true,  generate_op_movsxd},
-    {MN_MOVZX,  "movzx",  true,  generate_op_movzx},
-    {MN_NEG,    "neg",    true,  generate_op_neg},
-    {MN_NOP,    "nop",    false, generate_op_nop},
-    {MN_NOT,    "not",    true,  generate_op_not},
-    {MN_OR,     "or",     true,  generate_op_or},
-    {MN_POP,    "pop",    true,  generate_op_pop},
-    {MN_PUSH,   "push",   true,  generate_op_push},
-    {MN_PUSHFQ, "pushfq", false, generate_op_pushfq},
-    {MN_RET,    "ret",    false, generate_op_ret},
-    {MN_SAL,    "sal",    true,  generate_op_sal},
-    {MN_SAR,    "sar",    true,  generate_op_sar},
-    {MN_SETA,   "seta",   true,  generate_op_setnbe},
-    {MN_SETAE,  "setae",  true,  generate_op_setnb},
-    {MN_SETB,   "setb",   true,  generate_op_setb},
-    {MN_SETBE,  "setbe",  true,  generate_op_setbe},
-    {MN_SETE,   "sete",   true,  generate_op_sete},
-    {MN_SETG,   "setg",   true,  generate_op_setnle},
-    {MN_SETGE,  "setge",  true,  generate_op_setnl},
-    {MN_SETL,   "setl",   true,  generate_op_setl},
-    {MN_SETLE,  "setle",  true,  generate_op_setle},
-    {MN_SETNA,  "setna",  true,  generate_op_setbe},
-    {MN_SETNAE, "setnae", true,  generate_op_setb},
-    {MN_SETNB,  "setnb",  true,  generate_op_setnb},
-    {MN_SETNBE, "setnbe", true,  generate_op_setnbe},
-    {MN_SETNE,  "setne",  true,  generate_op_setne},
-    {MN_SETNG,  "setng",  true,  generate_op_setle},
-    {MN_SETNGE, "setnge", true,  generate_op_setl},
-    {MN_SETNL,  "setnl",  true,  generate_op_setnl},
-    {MN_SETNLE, "setnle", true,  generate_op_setnle},
-    {MN_SHL,    "shl",    true,  generate_op_sal},
-    {MN_SHR,    "shr",    true,  generate_op_shr},
-    {MN_SUB,    "sub",    true,  generate_op_sub},
-    {MN_XOR,    "xor",    true,  generate_op_xor},
+    {MN_ADD,        "add",        true,  PF_LOCK,                     EX_NONE,    generate_op_add},
+    {MN_AND,        "and",        true,  PF_LOCK,                     EX_NONE,    generate_op_and},
+    {MN_ANDN,       "andn",       true,  PF_NONE,                     EX_BMI,     generate_op_andn},
+    {MN_BEXTR,      "bextr",      true,  PF_NONE,                     EX_BMI,     generate_op_bextr},
+    {MN_BLSI,       "blsi",       true,  PF_NONE,                     EX_BMI,     generate_op_blsi},
+    {MN_BLSMSK,     "blsmsk",     true,  PF_NONE,                     EX_BMI,     generate_op_blsmsk},
+    {MN_BLSR,       "blsr",       true,  PF_NONE,                     EX_BMI,     generate_op_blsr},
+    {MN_BSF,        "bsf",        true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_BSR,        "bsr",        true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_BT,         "bt",         true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_BTC,        "btc",        true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_BTR,        "btr",        true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_BTS,        "bts",        true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_BZHI,       "bzhi",       true,  PF_NONE,                     EX_BMI2,    generate_op_bzhi},
+    {MN_CALL,       "call",       true,  PF_NONE,                     EX_NONE,    generate_op_call},
+    {MN_CDQ,        "cdq",        false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVA,      "cmova",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVAE,     "cmovae",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVB,      "cmovb",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVBE,     "cmovbe",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVC,      "cmovc",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVE,      "cmove",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVG,      "cmovg",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVGE,     "cmovge",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVL,      "cmovl",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVLE,     "cmovle",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNA,     "cmovna",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNAE,    "cmovnae",    true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNB,     "cmovnb",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNBE,    "cmovnbe",    true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNC,     "cmovnc",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNE,     "cmovne",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNG,     "cmovng",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNGE,    "cmovnge",    true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNL,     "cmovnl",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNLE,    "cmovnle",    true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNO,     "cmovno",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNP,     "cmovnp",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNS,     "cmovns",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVNZ,     "cmovnz",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVO,      "cmovo",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVP,      "cmovp",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVPE,     "cmovpe",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVPO,     "cmovpo",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVS,      "cmovs",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMOVZ,      "cmovz",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_CMP,        "cmp",        true,  PF_NONE,                     EX_NONE,    generate_op_cmp},
+    {MN_CMPSB,      "cmpsb",      false, PF_REP | PF_REPE | PF_REPNE, EX_NONE,    NULL},
+    {MN_CMPXCHG,    "cmpxchg",    true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_CMPXCHG16B, "cmpxchg16b", true,  PF_LOCK,                     EX_CX16,    NULL},
+    {MN_CQO,        "cqo",        false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_CWD,        "cwd",        false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_IDIV,       "idiv",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_IMUL,       "imul",       true,  PF_NONE,                     EX_NONE,    generate_op_imul},
+    {MN_JA,         "ja",         true,  PF_NONE,                     EX_NONE,    generate_op_jnbe},
+    {MN_JAE,        "jae",        true,  PF_NONE,                     EX_NONE,    generate_op_jnb},
+    {MN_JB,         "jb",         true,  PF_NONE,                     EX_NONE,    generate_op_jb},
+    {MN_JBE,        "jbe",        true,  PF_NONE,                     EX_NONE,    generate_op_jbe},
+    {MN_JC,         "jc",         true,  PF_NONE,                     EX_NONE,    generate_op_jb},
+    {MN_JE,         "je",         true,  PF_NONE,                     EX_NONE,    generate_op_je},
+    {MN_JECXZ,      "jecxz",      true,  PF_NONE,                     EX_NONE,    generate_op_jecxz},
+    {MN_JG,         "jg",         true,  PF_NONE,                     EX_NONE,    generate_op_jnle},
+    {MN_JGE,        "jge",        true,  PF_NONE,                     EX_NONE,    generate_op_jnl},
+    {MN_JL,         "jl",         true,  PF_NONE,                     EX_NONE,    generate_op_jl},
+    {MN_JLE,        "jle",        true,  PF_NONE,                     EX_NONE,    generate_op_jle},
+    {MN_JMP,        "jmp",        true,  PF_NONE,                     EX_NONE,    generate_op_jmp},
+    {MN_JNA,        "jna",        true,  PF_NONE,                     EX_NONE,    generate_op_jbe},
+    {MN_JNAE,       "jnae",       true,  PF_NONE,                     EX_NONE,    generate_op_jb},
+    {MN_JNB,        "jnb",        true,  PF_NONE,                     EX_NONE,    generate_op_jnb},
+    {MN_JNBE,       "jnbe",       true,  PF_NONE,                     EX_NONE,    generate_op_jnbe},
+    {MN_JNC,        "jnc",        true,  PF_NONE,                     EX_NONE,    generate_op_jnb},
+    {MN_JNE,        "jne",        true,  PF_NONE,                     EX_NONE,    generate_op_jne},
+    {MN_JNG,        "jng",        true,  PF_NONE,                     EX_NONE,    generate_op_jle},
+    {MN_JNGE,       "jnge",       true,  PF_NONE,                     EX_NONE,    generate_op_jl},
+    {MN_JNL,        "jnl",        true,  PF_NONE,                     EX_NONE,    generate_op_jnl},
+    {MN_JNLE,       "jnle",       true,  PF_NONE,                     EX_NONE,    generate_op_jnle},
+    {MN_JNO,        "jno",        true,  PF_NONE,                     EX_NONE,    generate_op_jno},
+    {MN_JNP,        "jnp",        true,  PF_NONE,                     EX_NONE,    generate_op_jnp},
+    {MN_JNS,        "jns",        true,  PF_NONE,                     EX_NONE,    generate_op_jns},
+    {MN_JNZ,        "jnz",        true,  PF_NONE,                     EX_NONE,    generate_op_jne},
+    {MN_JO,         "jo",         true,  PF_NONE,                     EX_NONE,    generate_op_jo},
+    {MN_JP,         "jp",         true,  PF_NONE,                     EX_NONE,    generate_op_jp},
+    {MN_JPE,        "jpe",        true,  PF_NONE,                     EX_NONE,    generate_op_jp},
+    {MN_JPO,        "jpo",        true,  PF_NONE,                     EX_NONE,    generate_op_jnp},
+    {MN_JRCXZ,      "jrcxz",      true,  PF_NONE,                     EX_NONE,    generate_op_jrcxz},
+    {MN_JS,         "js",         true,  PF_NONE,                     EX_NONE,    generate_op_js},
+    {MN_JZ,         "jz",         true,  PF_NONE,                     EX_NONE,    generate_op_je},
+    {MN_LEA,        "lea",        true,  PF_NONE,                     EX_NONE,    generate_op_lea},
+    {MN_LEAVE,      "leave",      false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_LFENCE,     "lfence",     false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_LODSB,      "lodsb",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_LZCNT,      "lzcnt",      true,  PF_NONE,                     EX_LZCNT,   NULL},
+    {MN_MFENCE,     "mfence",     false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_MOV,        "mov",        true,  PF_NONE,                     EX_NONE,    generate_op_mov},
+    {MN_MOVSB,      "movsb",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_MOVSD,      "movsd",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_MOVSQ,      "movsq",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_MOVSW,      "movsw",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_MOVSX,      "movsx",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_MOVSXD,     "movsxd",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_MOVZX,      "movzx",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_MULX,       "mulx",       true,  PF_NONE,                     EX_BMI2,    generate_op_mulx},
+    {MN_NEG,        "neg",        true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_NOP,        "nop",        false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_NOT,        "not",        true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_OR,         "or",         true,  PF_LOCK,                     EX_NONE,    generate_op_or},
+    {MN_PAUSE,      "pause",      false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_PDEP,       "pdep",       true,  PF_NONE,                     EX_BMI2,    generate_op_pdep},
+    {MN_PEXT,       "pext",       true,  PF_NONE,                     EX_BMI2,    generate_op_pext},
+    {MN_POP,        "pop",        true,  PF_NONE,                     EX_NONE,    generate_op_pop},
+    {MN_POPCNT,     "popcnt",     true,  PF_NONE,                     EX_POPCNT,  NULL},
+    {MN_PUSH,       "push",       true,  PF_NONE,                     EX_NONE,    generate_op_push},
+    {MN_PUSHFQ,     "pushfq",     false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_RET,        "ret",        false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_RORX,       "rorx",       true,  PF_NONE,                     EX_BMI2,    generate_op_rorx},
+    {MN_SAL,        "sal",        true,  PF_NONE,                     EX_NONE,    generate_op_sal},
+    {MN_SAR,        "sar",        true,  PF_NONE,                     EX_NONE,    generate_op_sar},
+    {MN_SARX,       "sarx",       true,  PF_NONE,                     EX_BMI2,    generate_op_sarx},
+    {MN_SCASB,      "scasb",      false, PF_REP | PF_REPE | PF_REPNE, EX_NONE,    NULL},
+    {MN_SETA,       "seta",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETAE,      "setae",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETB,       "setb",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETBE,      "setbe",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETC,       "setc",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETE,       "sete",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETG,       "setg",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETGE,      "setge",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETL,       "setl",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETLE,      "setle",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNA,      "setna",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNAE,     "setnae",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNB,      "setnb",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNBE,     "setnbe",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNC,      "setnc",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNE,      "setne",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNG,      "setng",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNGE,     "setnge",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNL,      "setnl",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNLE,     "setnle",     true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNO,      "setno",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNP,      "setnp",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNS,      "setns",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETNZ,      "setnz",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETO,       "seto",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETP,       "setp",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETPE,      "setpe",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETPO,      "setpo",      true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETS,       "sets",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SETZ,       "setz",       true,  PF_NONE,                     EX_NONE,    NULL},
+    {MN_SFENCE,     "sfence",     false, PF_NONE,                     EX_NONE,    NULL},
+    {MN_SHL,        "shl",        true,  PF_NONE,                     EX_NONE,    generate_op_sal},
+    {MN_SHLX,       "shlx",       true,  PF_NONE,                     EX_BMI2,    generate_op_shlx},
+    {MN_SHR,        "shr",        true,  PF_NONE,                     EX_NONE,    generate_op_shr},
+    {MN_SHRX,       "shrx",       true,  PF_NONE,                     EX_BMI2,    generate_op_shrx},
+    {MN_STOSB,      "stosb",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_STOSD,      "stosd",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_STOSQ,      "stosq",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_STOSW,      "stosw",      false, PF_REP,                      EX_NONE,    NULL},
+    {MN_SUB,        "sub",        true,  PF_LOCK,                     EX_NONE,    generate_op_sub},
+    {MN_TZCNT,      "tzcnt",      true,  PF_NONE,                     EX_BMI,     NULL},
+    {MN_XADD,       "xadd",       true,  PF_LOCK,                     EX_NONE,    NULL},
+    {MN_XCHG,       "xchg",       true,  PF_LOCK,                     EX_NONE,    generate_op_xchg},
+    {MN_XOR,        "xor",        true,  PF_LOCK,                     EX_NONE,    generate_op_xor},
 };
 const size_t MNEMONIC_INFO_LIST_SIZE = sizeof(mnemonic_info_list) / sizeof(mnemonic_info_list[0]);
 
+const PrefixInfo prefix_info_list[] = 
+{
+    {PF_LOCK,  "lock"},
+    {PF_REP,   "rep"},
+    {PF_REPE,  "repe"},
+    {PF_REPNE, "repne"},
+    {PF_REPNE, "repnz"},
+    {PF_REPE,  "repz"},
+};
+const size_t PREFIX_INFO_LIST_SIZE = sizeof(prefix_info_list) / sizeof(prefix_info_list[0]);
+
 const RegisterInfo register_info_list[] = 
 {
     {REG_AL,   "al",   OP_R8},
@@ -273,6 +475,12 @@ const RegisterInfo register_info_list[] =
 const size_t REGISTER_INFO_LIST_SIZE = sizeof(register_info_list) / sizeof(register_info_list[0]);
 
 static const uint8_t PREFIX_OPERAND_SIZE_OVERRIDE = 0x66;
+static const uint8_t PREFIX_ADDRESS_SIZE_OVERRIDE = 0x67;
+static const uint8_t PREFIX_LOCK = 0xf0;
+static const uint8_t PREFIX_REPNE = 0xf2;
+static const uint8_t PREFIX_REP = 0xf3;
+static const uint8_t PREFIX_SEGMENT_FS = 0x64;
+static const uint8_t PREFIX_SEGMENT_GS = 0x65;
 
 static const uint8_t PREFIX_NONE = 0x00;
 static const uint8_t PREFIX_REX = 0x40;
@@ -280,11 +488,22 @@ static const size_t PREFIX_POSITION_REX_W = 3;
 static const size_t PREFIX_POSITION_REX_R = 2;
 static const size_t PREFIX_POSITION_REX_B = 0;
 
+static const uint8_t PREFIX_VEX_3BYTE = 0xc4;
+static const uint8_t VEX_PP_NONE = 0x00;
+static const uint8_t VEX_PP_66 = 0x01;
+static const uint8_t VEX_PP_F3 = 0x02;
+static const uint8_t VEX_PP_F2 = 0x03;
+static const uint8_t VEX_MAP_0F38 = 0x02;
+static const uint8_t VEX_MAP_0F3A = 0x03;
+static const size_t VEX_POSITION_RXB = 5;
+static const size_t VEX_POSITION_W = 7;
+static const size_t VEX_POSITION_VVVV = 3;
+static const uint8_t VEX_VVVV_MASK = 0x0f;
+
 static const uint8_t MOD_MEM = 0;
 static const uint8_t MOD_MEM_DISP8 = 1;
 static const uint8_t MOD_MEM_DISP32 = 2;
 static const uint8_t MOD_REG = 3;
-static const uint8_t MOD_INVALID = 0xff;
 
 static const uint8_t REGISTER_INDEX_EAX = 0;
 static const uint8_t REGISTER_INDEX_ECX = 1;
@@ -304,6 +523,7 @@ static const uint8_t REGISTER_INDEX_R14D = 14;
 static const uint8_t REGISTER_INDEX_R15D = 15;
 static const uint8_t REGISTER_INDEX_INVALID = 0xff;
 static const uint8_t REG_FIELD_MASK = 0x07;
+static const uint8_t RM_FIELD_NO_BASE = 0x08; // r/m field out of range, which designates memory without base register
 
 static const size_t MODRM_POSITION_MOD = 6;
 static const size_t MODRM_POSITION_REG = 3;
@@ -314,8 +534,22 @@ static const size_t SIB_POSITION_INDEX = 3;
 static const size_t SIB_POSITION_BASE = 0;
 
 static const size_t OPECODE_SIZE_MAX = 3;
+static const size_t NOP_SIZE_MAX = 9;
 static const uint8_t UINT8_T_MASK = 0xff;
 
+static const uint8_t nop_list[][9] =
+{
+    {0x90},
+    {0x66, 0x90},
+    {0x0f, 0x1f, 0x00},
+    {0x0f, 0x1f, 0x40, 0x00},
+    {0x0f, 0x1f, 0x44, 0x00, 0x00},
+    {0x66, 0x0f, 0x1f, 0x44, 0x00, 0x00},
+    {0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00},
+    {0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
 
 /*
 generate data
@@ -324,7 +558,7 @@ void generate_data(const Data *data, ByteBufferType *buffer)
 {
     if(data->kind == DT_SYMBOL)
     {
-        set_symbol(buffer->size, data->addend, SC_DATA, data->symbol);
+        set_symbol(buffer->size, data->addend, data->size, false, data->symbol);
     }
 
     if(data->value == 0)
@@ -343,7 +577,159 @@ generate an operation
 */
 void generate_operation(const Operation *operation, ByteBufferType *buffer)
 {
-    mnemonic_info_list[operation->kind].generate_function(operation->operands, buffer);
+    Elf_Addr start = buffer->size;
+    switch(operation->prefix)
+    {
+    case PF_LOCK:
+        append_binary_prefix(PREFIX_LOCK, buffer);
+        break;
+
+    case PF_REP:
+    case PF_REPE:
+        append_binary_prefix(PREFIX_REP, buffer);
+        break;
+
+    case PF_REPNE:
+        append_binary_prefix(PREFIX_REPNE, buffer);
+        break;
+
+    case PF_NONE:
+    default:
+        break;
+    }
+    may_append_binary_segment_prefix(operation->operands, buffer);
+
+    const MnemonicInfo *info = &mnemonic_info_list[operation->kind];
+    add_used_extensions(info->extensions, !operation->arch_specified);
+    if(info->generate_function != NULL)
+    {
+        info->generate_function(operation->operands, buffer);
+    }
+    else
+    {
+        generate_encoded_operation(operation, buffer);
+    }
+    set_got_relaxation(operation, start, buffer);
+}
+
+
+/*
+generate padding consisting of the recommended multi-byte NOP instructions
+*/
+void generate_nop_padding(size_t size, ByteBufferType *buffer)
+{
+    while(size > 0)
+    {
+        size_t nop_size = min(size, NOP_SIZE_MAX);
+        append_bytes((const char *)nop_list[nop_size - 1], nop_size, buffer);
+        size -= nop_size;
+    }
+}
+
+
+/*
+get kind of branch
+*/
+BranchKind get_branch_kind(const Operation *operation)
+{
+    switch(operation->kind)
+    {
+    case MN_CALL:
+        return (get_first_element(Operand)(operation->operands)->kind == OP_SYMBOL) ? BR_CALL : BR_INDIRECT;
+
+    case MN_JMP:
+        return (get_first_element(Operand)(operation->operands)->kind == OP_SYMBOL) ? BR_JMP : BR_INDIRECT;
+
+    case MN_RET:
+        return BR_RET;
+
+    case MN_JA:
+    case MN_JAE:
+    case MN_JB:
+    case MN_JBE:
+    case MN_JC:
+    case MN_JE:
+    case MN_JECXZ:
+    case MN_JG:
+    case MN_JGE:
+    case MN_JL:
+    case MN_JLE:
+    case MN_JNA:
+    case MN_JNAE:
+    case MN_JNB:
+    case MN_JNBE:
+    case MN_JNC:
+    case MN_JNE:
+    case MN_JNG:
+    case MN_JNGE:
+    case MN_JNL:
+    case MN_JNLE:
+    case MN_JNO:
+    case MN_JNP:
+    case MN_JNS:
+    case MN_JNZ:
+    case MN_JO:
+    case MN_JP:
+    case MN_JPE:
+    case MN_JPO:
+    case MN_JRCXZ:
+    case MN_JS:
+    case MN_JZ:
+        return BR_JCC;
+
+    default:
+        return BR_NONE;
+    }
+}
+
+
+/*
+check if an operation and the following conditional jump are fused into a single micro-op
+*/
+bool is_fused_operation_pair(const Operation *operation, const Operation *jcc)
+{
+    bool is_fusible_operation = (operation->kind == MN_ADD) || (operation->kind == MN_AND) || (operation->kind == MN_CMP) || (operation->kind == MN_SUB);
+    if(!is_fusible_operation || (operation->prefix != PF_NONE) || (get_branch_kind(jcc) != BR_JCC))
+    {
+        return false;
+    }
+
+    bool tests_all_flags = false;
+    switch(jcc->kind)
+    {
+    case MN_JECXZ:
+    case MN_JRCXZ:
+        // jumps which do not test flags are never fused
+        return false;
+
+    case MN_JNO:
+    case MN_JNP:
+    case MN_JNS:
+    case MN_JO:
+    case MN_JP:
+    case MN_JPE:
+    case MN_JPO:
+    case MN_JS:
+        tests_all_flags = true;
+        break;
+
+    default:
+        break;
+    }
+
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operation->operands);
+    const Operand *operand1 = get_element(Operand)(entry);
+    const Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
+    if(operation->kind == MN_CMP)
+    {
+        // cmp fuses unless it compares memory with an immediate
+        return !tests_all_flags && !(is_memory(operand1->kind) && is_immediate(operand2->kind));
+    }
+    else
+    {
+        // add, and and sub fuse only if their destination is a register
+        return ((operation->kind == MN_AND) || !tests_all_flags) && is_register(operand1->kind);
+    }
 }
 
 
@@ -367,6 +753,66 @@ static void generate_op_and(const List(Operand) *operands, ByteBufferType *buffe
 }
 
 
+/*
+generate andn operation
+*/
+static void generate_op_andn(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    const VexOperationOpecode opecode = {VEX_PP_NONE, VEX_MAP_0F38, 0xf2, 0x00};
+    generate_vex_operation_rvm(&opecode, operands, buffer);
+}
+
+
+/*
+generate bextr operation
+*/
+static void generate_op_bextr(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    const VexOperationOpecode opecode = {VEX_PP_NONE, VEX_MAP_0F38, 0xf7, 0x00};
+    generate_vex_operation_rmv(&opecode, operands, buffer);
+}
+
+
+/*
+generate blsi operation
+*/
+static void generate_op_blsi(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    const VexOperationOpecode opecode = {VEX_PP_NONE, VEX_MAP_0F38, 0xf3, 0x03};
+    generate_vex_operation_vm(&opecode, operands, buffer);
+}
+
+
+/*
+generate blsmsk operation
+*/
+static void generate_op_blsmsk(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    const VexOperationOpecode opecode = {VEX_PP_NONE, VEX_MAP_0F38, 0xf3, 0x02};
+    generate_vex_operation_vm(&opecode, operands, buffer);
+}
+
+
+/*
+generate blsr operation
+*/
+static void generate_op_blsr(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    const VexOperationOpecode opecode = {VEX_PP_NONE, VEX_MAP_0F38, 0xf3, 0x01};
+    generate_vex_operation_vm(&opecode, operands, buffer);
+}
+
+
+/*
+generate bzhi operation
+*/
+static void generate_op_bzhi(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    const VexOperationOpecode opecode = {VEX_PP_NONE, VEX_MAP_0F38, 0xf5, 0x00};
+    generate_vex_operation_rmv(&opecode, operands, buffer);
+}
+
+
 /*
 generate call operation
 */
@@ -380,7 +826,7 @@ static void generate_op_call(const List(Operand) *operands, ByteBufferType *buff
         * CALL rel32
         */
         append_binary_opecode(0xe8, buffer);
-        append_binary_relocation(SIZEOF_32BIT, operand->symbol, buffer->size, -SIZEOF_32BIT, buffer);
+        append_binary_branch_target(operand->symbol, buffer);
     }
     else if(is_register(operand->kind) || is_memory(operand->kind))
     {
@@ -397,15 +843,6 @@ static void generate_op_call(const List(Operand) *operands, ByteBufferType *buff
 }
 
 
-/*
-generate cdq operation
-*/
-static void generate_op_cdq(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    append_binary_opecode(0x99, buffer);
-}
-
-
 /*
 generate cmp operation
 */
@@ -416,50 +853,6 @@ static void generate_op_cmp(const List(Operand) *operands, ByteBufferType *buffe
 }
 
 
-/*
-generate cqo operation
-*/
-static void generate_op_cqo(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    append_binary_prefix(get_rex_prefix_from_position(PREFIX_POSITION_REX_W), buffer);
-    generate_op_cdq(operands, buffer);
-}
-
-
-/*
-generate cwd operation
-*/
-static void generate_op_cwd(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    append_binary_prefix(PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
-    generate_op_cdq(operands, buffer);
-}
-
-
-/*
-generate idiv operation
-*/
-static void generate_op_idiv(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    /*
-    handle the following instructions
-    * IDIV r8
-    * IDIV r16
-    * IDIV r32
-    * IDIV r64
-    */
-    Operand *operand = get_first_element(Operand)(operands);
-    assert(is_register(operand->kind) || is_memory(operand->kind));
-
-    may_append_binary_instruction_prefix(operand->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
-    may_append_binary_rex_prefix_reg(operand, true, buffer);
-    uint32_t opecode = (get_operand_size(operand->kind) == SIZEOF_8BIT) ? 0xf6 : 0xf7;
-    append_binary_opecode(opecode, buffer);
-    append_binary_modrm(get_mod_field(operand), 0x07, get_rm_field(operand->reg), buffer);
-    append_binary_disp(operand, buffer->size, -SIZEOF_32BIT, buffer);
-}
-
-
 /*
 generate imul operation
 */
@@ -575,6 +968,16 @@ static void generate_op_je(const List(Operand) *operands, ByteBufferType *buffer
 }
 
 
+/*
+generate jecxz operation
+*/
+static void generate_op_jecxz(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    append_binary_prefix(PREFIX_ADDRESS_SIZE_OVERRIDE, buffer);
+    generate_op_jrcxz(operands, buffer);
+}
+
+
 /*
 generate jl operation
 */
@@ -606,7 +1009,7 @@ static void generate_op_jmp(const List(Operand) *operands, ByteBufferType *buffe
         * JMP rel32
         */
         append_binary_opecode(0xe9, buffer);
-        append_binary_relocation(SIZEOF_32BIT, operand->symbol, buffer->size, -SIZEOF_32BIT, buffer);
+        append_binary_branch_target(operand->symbol, buffer);
     }
     else if(is_register(operand->kind) || is_memory(operand->kind))
     {
@@ -623,6 +1026,15 @@ static void generate_op_jmp(const List(Operand) *operands, ByteBufferType *buffe
 }
 
 
+/*
+generate jnb operation
+*/
+static void generate_op_jnb(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_NB, operands, buffer);
+}
+
+
 /*
 generate jnbe operation
 */
@@ -659,6 +1071,79 @@ static void generate_op_jnle(const List(Operand) *operands, ByteBufferType *buff
 }
 
 
+/*
+generate jno operation
+*/
+static void generate_op_jno(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_NO, operands, buffer);
+}
+
+
+/*
+generate jnp operation
+*/
+static void generate_op_jnp(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_NP, operands, buffer);
+}
+
+
+/*
+generate jns operation
+*/
+static void generate_op_jns(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_NS, operands, buffer);
+}
+
+
+/*
+generate jo operation
+*/
+static void generate_op_jo(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_O, operands, buffer);
+}
+
+
+/*
+generate jp operation
+*/
+static void generate_op_jp(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_P, operands, buffer);
+}
+
+
+/*
+generate jrcxz operation
+*/
+static void generate_op_jrcxz(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    Operand *operand = get_first_element(Operand)(operands);
+
+    if(operand->kind == OP_SYMBOL)
+    {
+        /*
+        handle the following instructions
+        * JRCXZ rel8
+        */
+        append_binary_opecode(0xe3, buffer);
+        append_binary_relocation(SIZEOF_8BIT, operand->symbol, buffer->size, -SIZEOF_8BIT, buffer);
+    }
+}
+
+
+/*
+generate js operation
+*/
+static void generate_op_js(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    generate_op_jcc(CC_S, operands, buffer);
+}
+
+
 /*
 generate lea operation
 */
@@ -679,19 +1164,6 @@ static void generate_op_lea(const List(Operand) *operands, ByteBufferType *buffe
 }
 
 
-/*
-generate leave operation
-*/
-static void generate_op_leave(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    /*
-    handle the following instructions
-    * LEAVE
-    */
-    append_binary_opecode(0xc9, buffer);
-}
-
-
 /*
 generate mov operation
 */
@@ -791,125 +1263,42 @@ static void generate_op_mov(const List(Operand) *operands, ByteBufferType *buffe
 
 
 /*
-generate movsx operation
-*/
-static void generate_op_movsx(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
-    Operand *operand1 = get_element(Operand)(entry);
-    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
-    assert(is_register(operand1->kind) && is_register_or_memory(operand2->kind));
-    assert(get_operand_size(operand1->kind) > get_operand_size(operand2->kind));
-
-    /*
-    handle the following instructions
-    * MOVSX r16, r/m8
-    * MOVSX r32, r/m8
-    * MOVSX r64, r/m8
-    * MOVSX r32, r/m16
-    * MOVSX r64, r/m16
-    */
-    may_append_binary_instruction_prefix(operand1->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
-    may_append_binary_rex_prefix_reg_rm(operand1, operand2, true, buffer);
-    uint32_t opecode = (get_operand_size(operand2->kind) == SIZEOF_8BIT) ? 0x0fbe : 0x0fbf;
-    append_binary_opecode(opecode, buffer);
-    append_binary_modrm(get_mod_field(operand2), get_reg_field(operand1->reg), get_rm_field(operand2->reg), buffer);
-    append_binary_disp(operand2, buffer->size, -SIZEOF_32BIT, buffer);
-}
-
-
-/*
-generate movsxd operation
-*/
-static void generate_op_movsxd(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
-    Operand *operand1 = get_element(Operand)(entry);
-    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
-    assert(is_register(operand1->kind) && is_register_or_memory(operand2->kind));
-
-    /*
-    handle the following instructions
-    * MOVSXD r16, r/m16
-    * MOVSXD r32, r/m32
-    * MOVSXD r64, r/m32
-    */
-    may_append_binary_instruction_prefix(operand1->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
-    may_append_binary_rex_prefix_reg_rm(operand1, operand2, true, buffer);
-    append_binary_opecode(0x63, buffer);
-    append_binary_modrm(get_mod_field(operand2), get_reg_field(operand1->reg), get_rm_field(operand2->reg), buffer);
-    append_binary_disp(operand2, buffer->size, -SIZEOF_32BIT, buffer);
-}
-
-
-/*
-generate movzx operation
+generate mulx operation
 */
-static void generate_op_movzx(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_mulx(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
-    Operand *operand1 = get_element(Operand)(entry);
-    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
-    assert(is_register(operand1->kind) && is_register_or_memory(operand2->kind));
-    assert((get_operand_size(operand1->kind) > get_operand_size(operand2->kind)) && (get_operand_size(operand2->kind) <= SIZEOF_16BIT));
-
-    /*
-    handle the following instructions
-    * MOVZX r16, r/m8
-    * MOVZX r32, r/m8
-    * MOVZX r64, r/m8
-    * MOVZX r32, r/m16
-    * MOVZX r64, r/m16
-    */
-    may_append_binary_instruction_prefix(operand1->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
-    may_append_binary_rex_prefix_reg_rm(operand1, operand2, true, buffer);
-    uint32_t opecode = (get_operand_size(operand2->kind) == SIZEOF_8BIT) ? 0x0fb6 : 0x0fb7;
-    append_binary_opecode(opecode, buffer);
-    append_binary_modrm(get_mod_field(operand2), get_reg_field(operand1->reg), get_rm_field(operand2->reg), buffer);
-    append_binary_disp(operand2, buffer->size, -SIZEOF_32BIT, buffer);
-}
-
-
-/*
-generate neg operation
-*/
-static void generate_op_neg(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    const UnaryOperationOpecode opecode = {0xf6, 0xf7, 0x03};
-    generate_unary_arithmetic_operation(&opecode, operands, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_F2, VEX_MAP_0F38, 0xf6, 0x00};
+    generate_vex_operation_rvm(&opecode, operands, buffer);
 }
 
 
 /*
-generate nop operation
+generate or operation
 */
-static void generate_op_nop(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_or(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    /*
-    handle the following instructions
-    * NOP
-    */
-    append_binary_opecode(0x90, buffer);
+    const BinaryOperationOpecode opecode = {0x0c, 0x0d, 0x01, 0x80, 0x81, 0x83, 0x08, 0x09, 0x0a, 0x0b};
+    generate_binary_arithmetic_operation(&opecode, operands, buffer);
 }
 
 
 /*
-generate not operation
+generate pdep operation
 */
-static void generate_op_not(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_pdep(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    const UnaryOperationOpecode opecode = {0xf6, 0xf7, 0x02};
-    generate_unary_arithmetic_operation(&opecode, operands, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_F2, VEX_MAP_0F38, 0xf5, 0x00};
+    generate_vex_operation_rvm(&opecode, operands, buffer);
 }
 
 
 /*
-generate or operation
+generate pext operation
 */
-static void generate_op_or(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_pext(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    const BinaryOperationOpecode opecode = {0x0c, 0x0d, 0x01, 0x80, 0x81, 0x83, 0x08, 0x09, 0x0a, 0x0b};
-    generate_binary_arithmetic_operation(&opecode, operands, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_F3, VEX_MAP_0F38, 0xf5, 0x00};
+    generate_vex_operation_rvm(&opecode, operands, buffer);
 }
 
 
@@ -1001,24 +1390,28 @@ static void generate_op_push(const List(Operand) *operands, ByteBufferType *buff
 
 
 /*
-generate pushfq operation
+generate rorx operation
 */
-static void generate_op_pushfq(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_rorx(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    append_binary_opecode(0x9c, buffer);
-}
-
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
+    Operand *operand1 = get_element(Operand)(entry);
+    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
+    Operand *operand3 = get_element(Operand)(next_entry(Operand, next_entry(Operand, entry)));
+    assert(is_register(operand1->kind) && is_register_or_memory(operand2->kind) && is_immediate(operand3->kind));
+    assert((get_operand_size(operand1->kind) >= SIZEOF_32BIT) && (get_operand_size(operand1->kind) == get_operand_size(operand2->kind)));
 
-/*
-generate ret operation
-*/
-static void generate_op_ret(const List(Operand) *operands, ByteBufferType *buffer)
-{
     /*
     handle the following instructions
-    * RET
+    * RORX r32, r/m32, imm8
+    * RORX r64, r/m64, imm8
     */
-    append_binary_opecode(0xc3, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_F2, VEX_MAP_0F3A, 0xf0, 0x00};
+    append_binary_vex_prefix(&opecode, operand1, NULL, operand2, buffer);
+    append_binary_opecode(opecode.opecode, buffer);
+    append_binary_modrm(get_mod_field(operand2), get_reg_field(operand1->reg), get_rm_field(operand2->reg), buffer);
+    append_binary_disp(operand2, buffer->size, -(SIZEOF_32BIT + SIZEOF_8BIT), buffer);
+    append_binary_imm(operand3->immediate, SIZEOF_8BIT, buffer);
 }
 
 
@@ -1036,106 +1429,46 @@ generate sar operation
 */
 static void generate_op_sar(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    generate_op_shift(0x07, operands, buffer);
-}
-
-
-/*
-generate setb operation
-*/
-static void generate_op_setb(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_B, operands, buffer);
-}
-
-
-/*
-generate setbe operation
-*/
-static void generate_op_setbe(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_BE, operands, buffer);
-}
-
-
-/*
-generate sete operation
-*/
-static void generate_op_sete(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_E, operands, buffer);
-}
-
-
-/*
-generate setl operation
-*/
-static void generate_op_setl(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_L, operands, buffer);
-}
-
-
-/*
-generate setle operation
-*/
-static void generate_op_setle(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_LE, operands, buffer);
-}
-
-
-/*
-generate setnb operation
-*/
-static void generate_op_setnb(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_NB, operands, buffer);
-}
-
-
-/*
-generate setnbe operation
-*/
-static void generate_op_setnbe(const List(Operand) *operands, ByteBufferType *buffer)
-{
-    generate_op_setcc(CC_NBE, operands, buffer);
+    generate_op_shift(0x07, operands, buffer);
 }
 
 
 /*
-generate setne operation
+generate sarx operation
 */
-static void generate_op_setne(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_sarx(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    generate_op_setcc(CC_NE, operands, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_F3, VEX_MAP_0F38, 0xf7, 0x00};
+    generate_vex_operation_rmv(&opecode, operands, buffer);
 }
 
 
 /*
-generate setnl operation
+generate shlx operation
 */
-static void generate_op_setnl(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_shlx(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    generate_op_setcc(CC_NL, operands, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_66, VEX_MAP_0F38, 0xf7, 0x00};
+    generate_vex_operation_rmv(&opecode, operands, buffer);
 }
 
 
 /*
-generate setnle operation
+generate shr operation
 */
-static void generate_op_setnle(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_shr(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    generate_op_setcc(CC_NLE, operands, buffer);
+    generate_op_shift(0x05, operands, buffer);
 }
 
 
 /*
-generate shr operation
+generate shrx operation
 */
-static void generate_op_shr(const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_op_shrx(const List(Operand) *operands, ByteBufferType *buffer)
 {
-    generate_op_shift(0x05, operands, buffer);
+    const VexOperationOpecode opecode = {VEX_PP_F2, VEX_MAP_0F38, 0xf7, 0x00};
+    generate_vex_operation_rmv(&opecode, operands, buffer);
 }
 
 
@@ -1149,6 +1482,57 @@ static void generate_op_sub(const List(Operand) *operands, ByteBufferType *buffe
 }
 
 
+/*
+generate xchg operation
+*/
+static void generate_op_xchg(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
+    Operand *operand1 = get_element(Operand)(entry);
+    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
+    assert(is_register_or_memory(operand1->kind) && is_register_or_memory(operand2->kind));
+    assert(get_operand_size(operand1->kind) == get_operand_size(operand2->kind));
+
+    // exchange is commutative, so that operands are swapped to put memory in r/m field or accumulator in reg field
+    size_t size = get_operand_size(operand1->kind);
+    if(is_memory(operand2->kind) || (is_register(operand1->kind) && is_eax_register(operand1->reg) && (size != SIZEOF_8BIT)))
+    {
+        Operand *operand = operand1;
+        operand1 = operand2;
+        operand2 = operand;
+    }
+
+    if(is_register(operand1->kind) && is_eax_register(operand2->reg) && (size != SIZEOF_8BIT) && !((size == SIZEOF_32BIT) && is_eax_register(operand1->reg)))
+    {
+        /*
+        handle the following instructions
+        * XCHG r16, AX
+        * XCHG r32, EAX
+        * XCHG r64, RAX
+        */
+        may_append_binary_instruction_prefix(operand1->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
+        may_append_binary_rex_prefix_reg(operand1, true, buffer);
+        append_binary_opecode(0x90 + get_reg_field(operand1->reg), buffer);
+    }
+    else
+    {
+        /*
+        handle the following instructions
+        * XCHG r/m8, r8
+        * XCHG r/m16, r16
+        * XCHG r/m32, r32
+        * XCHG r/m64, r64
+        */
+        may_append_binary_instruction_prefix(operand1->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
+        may_append_binary_rex_prefix_reg_rm(operand2, operand1, true, buffer);
+        uint32_t opecode = (size == SIZEOF_8BIT) ? 0x86 : 0x87;
+        append_binary_opecode(opecode, buffer);
+        append_binary_modrm(get_mod_field(operand1), get_reg_field(operand2->reg), get_rm_field(operand1->reg), buffer);
+        append_binary_disp(operand1, buffer->size, -SIZEOF_32BIT, buffer);
+    }
+}
+
+
 /*
 generate xor operation
 */
@@ -1201,10 +1585,10 @@ static void generate_binary_arithmetic_operation(const BinaryOperationOpecode *o
         may_append_binary_rex_prefix_reg_rm(operand2, operand1, true, buffer);
         uint32_t op = (get_operand_size(operand1->kind) == SIZEOF_8BIT) ? opecode->mi_byte : (imm_size == SIZEOF_8BIT ? opecode->mi_imm8 : opecode->mi);
         append_binary_opecode(op, buffer);
-        append_binary_modrm(get_mod_field(operand1), opecode->reg_field_mi, get_reg_field(operand1->reg), buffer);
+        append_binary_modrm(get_mod_field(operand1), opecode->reg_field_mi, get_rm_field(operand1->reg), buffer);
         if(is_memory(operand1->kind))
         {
-            append_binary_disp(operand1, buffer->size, -SIZEOF_32BIT, buffer);
+            append_binary_disp(operand1, buffer->size, -(SIZEOF_32BIT + imm_size), buffer);
         }
         append_binary_imm(operand2->immediate, imm_size, buffer);
     }
@@ -1249,25 +1633,198 @@ static void generate_binary_arithmetic_operation(const BinaryOperationOpecode *o
 
 
 /*
-generate unary arithmetic operation
+generate VEX-encoded operation of type RMV
 */
-static void generate_unary_arithmetic_operation(const UnaryOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer)
+static void generate_vex_operation_rmv(const VexOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer)
 {
-    const Operand *operand = get_first_element(Operand)(operands);
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
+    Operand *operand1 = get_element(Operand)(entry);
+    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
+    Operand *operand3 = get_element(Operand)(next_entry(Operand, next_entry(Operand, entry)));
+    assert(is_register(operand1->kind) && is_register_or_memory(operand2->kind) && is_register(operand3->kind));
+    assert((get_operand_size(operand1->kind) >= SIZEOF_32BIT) && (get_operand_size(operand1->kind) == get_operand_size(operand2->kind)) && (get_operand_size(operand1->kind) == get_operand_size(operand3->kind)));
 
     /*
     handle the following instructions
-    * <mnemonic> r/m8
-    * <mnemonic> r/m16
-    * <mnemonic> r/m32
-    * <mnemonic> r/m64
+    * <mnemonic> r32, r/m32, r32
+    * <mnemonic> r64, r/m64, r64
     */
-    may_append_binary_instruction_prefix(operand->kind, PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
-    may_append_binary_rex_prefix_reg(operand, true, buffer);
-    uint32_t op = (get_operand_size(operand->kind) == SIZEOF_8BIT) ? opecode->op_byte : opecode->op;
-    append_binary_opecode(op, buffer);
-    append_binary_modrm(get_mod_field(operand), opecode->reg_field, get_rm_field(operand->reg), buffer);
-    append_binary_disp(operand, buffer->size, -SIZEOF_32BIT, buffer);
+    append_binary_vex_prefix(opecode, operand1, operand3, operand2, buffer);
+    append_binary_opecode(opecode->opecode, buffer);
+    append_binary_modrm(get_mod_field(operand2), get_reg_field(operand1->reg), get_rm_field(operand2->reg), buffer);
+    append_binary_disp(operand2, buffer->size, -SIZEOF_32BIT, buffer);
+}
+
+
+/*
+generate VEX-encoded operation of type RVM
+*/
+static void generate_vex_operation_rvm(const VexOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer)
+{
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
+    Operand *operand1 = get_element(Operand)(entry);
+    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
+    Operand *operand3 = get_element(Operand)(next_entry(Operand, next_entry(Operand, entry)));
+    assert(is_register(operand1->kind) && is_register(operand2->kind) && is_register_or_memory(operand3->kind));
+    assert((get_operand_size(operand1->kind) >= SIZEOF_32BIT) && (get_operand_size(operand1->kind) == get_operand_size(operand2->kind)) && (get_operand_size(operand1->kind) == get_operand_size(operand3->kind)));
+
+    /*
+    handle the following instructions
+    * <mnemonic> r32, r32, r/m32
+    * <mnemonic> r64, r64, r/m64
+    */
+    append_binary_vex_prefix(opecode, operand1, operand2, operand3, buffer);
+    append_binary_opecode(opecode->opecode, buffer);
+    append_binary_modrm(get_mod_field(operand3), get_reg_field(operand1->reg), get_rm_field(operand3->reg), buffer);
+    append_binary_disp(operand3, buffer->size, -SIZEOF_32BIT, buffer);
+}
+
+
+/*
+generate VEX-encoded operation of type VM
+*/
+static void generate_vex_operation_vm(const VexOperationOpecode *opecode, const List(Operand) *operands, ByteBufferType *buffer)
+{
+    ListEntry(Operand) *entry = get_first_entry(Operand)(operands);
+    Operand *operand1 = get_element(Operand)(entry);
+    Operand *operand2 = get_element(Operand)(next_entry(Operand, entry));
+    assert(is_register(operand1->kind) && is_register_or_memory(operand2->kind));
+    assert((get_operand_size(operand1->kind) >= SIZEOF_32BIT) && (get_operand_size(operand1->kind) == get_operand_size(operand2->kind)));
+
+    /*
+    handle the following instructions
+    * <mnemonic> r32, r/m32
+    * <mnemonic> r64, r/m64
+    */
+    append_binary_vex_prefix(opecode, NULL, operand1, operand2, buffer);
+    append_binary_opecode(opecode->opecode, buffer);
+    append_binary_modrm(get_mod_field(operand2), opecode->reg_field, get_rm_field(operand2->reg), buffer);
+    append_binary_disp(operand2, buffer->size, -SIZEOF_32BIT, buffer);
+}
+
+
+/*
+generate operation by the instruction encoding table
+*/
+static void generate_encoded_operation(const Operation *operation, ByteBufferType *buffer)
+{
+    const InstructionEncoding *encoding = search_instruction_encoding(operation);
+    if(encoding == NULL)
+    {
+        fprintf(stderr, "invalid combination of operands for '%s'\n", mnemonic_info_list[operation->kind].name);
+        exit(EXIT_FAILURE);
+    }
+
+    // classify operands by their roles
+    const Operand *operand_reg = NULL;
+    const Operand *operand_rm = NULL;
+    const Operand *operand_imm = NULL;
+    if(operation->operands != NULL)
+    {
+        size_t index = 0;
+        for_each_entry(Operand, cursor, operation->operands)
+        {
+            const Operand *operand = get_element(Operand)(cursor);
+            OperandPattern pattern = encoding->operand_patterns[index];
+            if(is_immediate(operand->kind))
+            {
+                operand_imm = operand;
+            }
+            else if((OPP_R8 <= pattern) && (pattern <= OPP_R64))
+            {
+                operand_reg = operand;
+            }
+            else
+            {
+                operand_rm = operand;
+            }
+            index++;
+        }
+    }
+
+    // legacy and mandatory prefixes precede REX prefix
+    if(encoding->prefixes & EP_66)
+    {
+        append_binary_prefix(PREFIX_OPERAND_SIZE_OVERRIDE, buffer);
+    }
+    if(encoding->prefixes & EP_F2)
+    {
+        append_binary_prefix(PREFIX_REPNE, buffer);
+    }
+    if(encoding->prefixes & EP_F3)
+    {
+        append_binary_prefix(PREFIX_REP, buffer);
+    }
+
+    // REX prefix for byte registers is required only to access spl, bpl, sil and dil
+    uint8_t rex = (encoding->prefixes & EP_REX_W) ? get_rex_prefix_from_position(PREFIX_POSITION_REX_W) : PREFIX_NONE;
+    if(operand_reg != NULL)
+    {
+        rex |= get_rex_prefix(operand_reg, PREFIX_POSITION_REX_R, get_operand_size(operand_reg->kind) == SIZEOF_8BIT);
+    }
+    if(operand_rm != NULL)
+    {
+        rex |= get_rex_prefix(operand_rm, PREFIX_POSITION_REX_B, get_operand_size(operand_rm->kind) == SIZEOF_8BIT);
+    }
+    if(rex != PREFIX_NONE)
+    {
+        append_binary_prefix(rex, buffer);
+    }
+
+    append_binary_opecode(encoding->opecode, buffer);
+
+    if(encoding->modrm != MR_NONE)
+    {
+        uint8_t reg_field = (encoding->modrm == MR_REG) ? get_reg_field(operand_reg->reg) : encoding->modrm;
+        append_binary_modrm(get_mod_field(operand_rm), reg_field, get_rm_field(operand_rm->reg), buffer);
+        append_binary_disp(operand_rm, buffer->size, -(SIZEOF_32BIT + encoding->imm_size), buffer);
+    }
+
+    if(encoding->imm_size > 0)
+    {
+        append_binary_imm(operand_imm->immediate, encoding->imm_size, buffer);
+    }
+}
+
+
+/*
+search the instruction encoding table for an encoding matching operands
+*/
+static const InstructionEncoding *search_instruction_encoding(const Operation *operation)
+{
+    assert(operation->kind < sizeof(instruction_encoding_range_list) / sizeof(instruction_encoding_range_list[0]));
+    const InstructionEncodingRange *range = &instruction_encoding_range_list[operation->kind];
+    size_t operand_number = (operation->operands == NULL) ? 0 : get_length(Operand)(operation->operands);
+    for(size_t i = range->start; i < range->start + range->number; i++)
+    {
+        const InstructionEncoding *encoding = &instruction_encoding_list[i];
+        if(encoding->operand_number != operand_number)
+        {
+            continue;
+        }
+
+        bool matched = true;
+        if(operand_number > 0)
+        {
+            size_t index = 0;
+            for_each_entry(Operand, cursor, operation->operands)
+            {
+                if(!is_matching_operand_pattern(get_element(Operand)(cursor), encoding->operand_patterns[index]))
+                {
+                    matched = false;
+                    break;
+                }
+                index++;
+            }
+        }
+
+        if(matched)
+        {
+            return encoding;
+        }
+    }
+
+    return NULL;
 }
 
 
@@ -1285,29 +1842,11 @@ static void generate_op_jcc(ConditionCode code, const List(Operand) *operands, B
         * <mnemonic> rel32
         */
         append_binary_opecode(0x0f80 + code, buffer);
-        append_binary_relocation(SIZEOF_32BIT, operand->symbol, buffer->size, -SIZEOF_32BIT, buffer);
+        append_binary_branch_target(operand->symbol, buffer);
     }
 }
 
 
-/*
-generate setcc operation
-*/
-static void generate_op_setcc(ConditionCode code, const List(Operand) *operands, ByteBufferType *buffer)
-{
-    const Operand *operand = get_first_element(Operand)(operands);
-
-    /*
-    handle the following instructions
-    * <mnemonic> r/m8
-    */
-    may_append_binary_rex_prefix_reg(operand, true, buffer);
-    append_binary_opecode(0x0f90 + code, buffer);
-    append_binary_modrm(get_mod_field(operand), 0x00, get_rm_field(operand->reg), buffer); // reg field of the ModR/M byte is not used
-    append_binary_disp(operand, buffer->size, -SIZEOF_32BIT, buffer);
-}
-
-
 /*
 generate shift operation
 */
@@ -1374,7 +1913,7 @@ check if operand is memory
 */
 static bool is_memory(OperandKind kind)
 {
-    return (kind == OP_M8) || (kind == OP_M16) || (kind == OP_M32) || (kind == OP_M64);
+    return (kind == OP_M8) || (kind == OP_M16) || (kind == OP_M32) || (kind == OP_M64) || (kind == OP_M128);
 }
 
 
@@ -1423,6 +1962,68 @@ static bool is_signed_immediate(uintmax_t imm, size_t size)
 }
 
 
+/*
+check if an operand matches a pattern of operand in instruction encoding
+*/
+static bool is_matching_operand_pattern(const Operand *operand, OperandPattern pattern)
+{
+    switch(pattern)
+    {
+    case OPP_IMM8:
+        return operand->kind == OP_IMM8;
+
+    case OPP_IMM16:
+        return (operand->kind == OP_IMM8) || (operand->kind == OP_IMM16);
+
+    case OPP_IMM32:
+        return (operand->kind == OP_IMM8) || (operand->kind == OP_IMM16) || (operand->kind == OP_IMM32);
+
+    case OPP_M8:
+        return operand->kind == OP_M8;
+
+    case OPP_M16:
+        return operand->kind == OP_M16;
+
+    case OPP_M32:
+        return operand->kind == OP_M32;
+
+    case OPP_M64:
+        return operand->kind == OP_M64;
+
+    case OPP_M128:
+        return operand->kind == OP_M128;
+
+    case OPP_R8:
+        return operand->kind == OP_R8;
+
+    case OPP_R16:
+        return operand->kind == OP_R16;
+
+    case OPP_R32:
+        return operand->kind == OP_R32;
+
+    case OPP_R64:
+        return operand->kind == OP_R64;
+
+    case OPP_RM8:
+        return (operand->kind == OP_R8) || (operand->kind == OP_M8);
+
+    case OPP_RM16:
+        return (operand->kind == OP_R16) || (operand->kind == OP_M16);
+
+    case OPP_RM32:
+        return (operand->kind == OP_R32) || (operand->kind == OP_M32);
+
+    case OPP_RM64:
+        return (operand->kind == OP_R64) || (operand->kind == OP_M64);
+
+    case OPP_NONE:
+    default:
+        return false;
+    }
+}
+
+
 /*
 get the least number of bytes to represent an immediate value
 */
@@ -1478,6 +2079,9 @@ static size_t get_operand_size(OperandKind kind)
     case OP_M64:
         return SIZEOF_64BIT;
 
+    case OP_M128:
+        return SIZEOF_128BIT;
+
     default:
         return 0;
     }
@@ -1526,6 +2130,7 @@ static uint8_t get_register_index(RegisterKind kind)
     case REG_EBP:
     case REG_RBP:
     case REG_RIP:
+    case REG_NONE:
         return REGISTER_INDEX_EBP;
 
     case REG_SIL:
@@ -1673,6 +2278,37 @@ static uint8_t get_sib_byte(uint8_t ss, uint8_t index, uint8_t base)
 }
 
 
+/*
+get size of displacement of memory operand
+*/
+static size_t get_disp_size(const Operand *operand)
+{
+    intmax_t disp = (intmax_t)operand->immediate;
+    if(is_register(operand->kind))
+    {
+        return 0;
+    }
+    else if((operand->reg == REG_NONE) || (operand->symbol != NULL))
+    {
+        // displacement is an absolute address or an offset given by symbol
+        return SIZEOF_32BIT;
+    }
+    else if((disp == 0) && (get_rm_field(operand->reg) != REGISTER_INDEX_EBP))
+    {
+        // r/m field of rbp or r13 without displacement means rip-relative address
+        return 0;
+    }
+    else if((INT8_MIN <= disp) && (disp <= INT8_MAX))
+    {
+        return SIZEOF_8BIT;
+    }
+    else
+    {
+        return SIZEOF_32BIT;
+    }
+}
+
+
 /*
 get value of mod field
 */
@@ -1684,13 +2320,13 @@ static uint8_t get_mod_field(const Operand *operand)
     }
     else
     {
-        if(operand->reg == REG_RIP)
+        if((operand->reg == REG_RIP) || (operand->reg == REG_NONE))
         {
             return MOD_MEM;
         }
         else
         {
-            switch(get_least_size(operand->immediate))
+            switch(get_disp_size(operand))
             {
             case 0:
                 return MOD_MEM;
@@ -1698,11 +2334,8 @@ static uint8_t get_mod_field(const Operand *operand)
             case SIZEOF_8BIT:
                 return MOD_MEM_DISP8;
 
-            case SIZEOF_32BIT:
-                return MOD_MEM_DISP32;
-
             default:
-                return MOD_INVALID;
+                return MOD_MEM_DISP32;
             }
         }
     }
@@ -1723,7 +2356,7 @@ get value of r/m field
 */
 static uint8_t get_rm_field(RegisterKind kind)
 {
-    return get_reg_field(kind);
+    return (kind == REG_NONE) ? RM_FIELD_NO_BASE : get_reg_field(kind);
 }
 
 
@@ -1785,12 +2418,14 @@ append binary for ModR/M byte
 */
 static void append_binary_modrm(uint8_t mod, uint8_t reg, uint8_t rm, ByteBufferType *buffer)
 {
-    uint8_t modrm = get_modrm_byte(mod, reg, rm);
+    // r/m field of rbp without displacement means rip-relative address, so that absolute address is given by SIB byte without base and index
+    bool no_base = (rm == RM_FIELD_NO_BASE);
+    uint8_t modrm = get_modrm_byte(mod, reg, no_base ? REGISTER_INDEX_ESP : rm);
     append_bytes((char *)&modrm, sizeof(modrm), buffer);
 
-    if((mod != MOD_REG) && (rm == REGISTER_INDEX_ESP))
+    if((mod != MOD_REG) && (no_base || (rm == REGISTER_INDEX_ESP)))
     {
-        append_binary_sib(0x00, REGISTER_INDEX_ESP, REGISTER_INDEX_ESP, buffer);
+        append_binary_sib(0x00, REGISTER_INDEX_ESP, no_base ? REGISTER_INDEX_EBP : REGISTER_INDEX_ESP, buffer);
     }
 }
 
@@ -1814,9 +2449,15 @@ static void append_binary_disp(const Operand *operand, Elf_Addr address, Elf_Sxw
     {
         append_binary_relocation(SIZEOF_32BIT, operand->symbol, address, addend, buffer);
     }
+    else if(operand->symbol != NULL)
+    {
+        // offset given by symbol does not depend on where it appears
+        set_symbol(buffer->size, operand->immediate, SIZEOF_32BIT, false, operand->symbol);
+        append_binary_imm32(0, buffer);
+    }
     else
     {
-        append_binary_imm_least(operand->immediate, buffer);
+        append_binary_imm(operand->immediate, get_disp_size(operand), buffer);
     }
 }
 
@@ -1857,9 +2498,13 @@ append binary for relocation value
 */
 static void append_binary_relocation(size_t size, Symbol *symbol, Elf_Addr address, Elf_Sxword addend, ByteBufferType *buffer)
 {
-    set_symbol(address, addend, SC_TEXT, symbol);
+    set_symbol(address, addend, size, true, symbol);
     switch(size)
     {
+    case SIZEOF_8BIT:
+        append_binary_imm(0, SIZEOF_8BIT, buffer); // imm8 is a temporal value to be replaced during resolving symbols or relocation
+        break;
+
     case SIZEOF_32BIT:
     default:
         append_binary_imm32(0, buffer); // imm32 is a temporal value to be replaced during resolving symbols or relocation
@@ -1868,6 +2513,81 @@ static void append_binary_relocation(size_t size, Symbol *symbol, Elf_Addr addre
 }
 
 
+/*
+append binary for relative address of the target of a direct branch
+* Direct branches refer to their targets through PLT, so that the linker can bind them to functions in shared objects.
+*/
+static void append_binary_branch_target(Symbol *symbol, ByteBufferType *buffer)
+{
+    symbol->suffix = RS_PLT;
+    append_binary_relocation(SIZEOF_32BIT, symbol, buffer->size, -SIZEOF_32BIT, buffer);
+}
+
+
+/*
+mark references to GOT entries which the linker can relax into direct references
+* The displacement has to end an instruction of mov, call, jmp or binary arithmetic operations.
+*/
+static void set_got_relaxation(const Operation *operation, Elf_Addr start, const ByteBufferType *buffer)
+{
+    switch(operation->kind)
+    {
+    case MN_ADD:
+    case MN_AND:
+    case MN_CALL:
+    case MN_CMP:
+    case MN_JMP:
+    case MN_MOV:
+    case MN_OR:
+    case MN_SUB:
+    case MN_XOR:
+        break;
+
+    default:
+        return;
+    }
+
+    for_each_entry(Operand, cursor, operation->operands)
+    {
+        Symbol *symbol = get_element(Operand)(cursor)->symbol;
+        if((symbol == NULL) || (symbol->suffix != RS_GOTPCREL) || (symbol->address + SIZEOF_32BIT != buffer->size))
+        {
+            continue;
+        }
+
+        // the displacement follows an opecode of 1 byte and ModR/M byte, which may be preceded by REX prefix
+        bool rex = (symbol->address >= start + 3) && (((uint8_t)buffer->body[symbol->address - 3] & 0xf0) == PREFIX_REX);
+        symbol->suffix = rex ? RS_REX_GOTPCRELX : RS_GOTPCRELX;
+    }
+}
+
+
+/*
+append binary for 3-byte VEX prefix
+*/
+static void append_binary_vex_prefix(const VexOperationOpecode *opecode, const Operand *operand_reg, const Operand *operand_vvvv, const Operand *operand_rm, ByteBufferType *buffer)
+{
+    uint8_t rex = PREFIX_NONE;
+    uint8_t vvvv = 0x00;
+    if(operand_reg != NULL)
+    {
+        rex |= get_rex_prefix(operand_reg, PREFIX_POSITION_REX_R, false);
+    }
+    if(operand_vvvv != NULL)
+    {
+        vvvv = get_register_index(operand_vvvv->reg);
+    }
+    rex |= get_rex_prefix(operand_rm, PREFIX_POSITION_REX_B, false);
+    const Operand *operand_size = (operand_reg != NULL) ? operand_reg : operand_vvvv;
+    uint8_t w = (get_operand_size(operand_size->kind) == SIZEOF_64BIT) ? 1 : 0;
+
+    // R, X, B and vvvv fields are stored in inverted form
+    append_binary_prefix(PREFIX_VEX_3BYTE, buffer);
+    append_binary_prefix(((uint8_t)(~rex & ~PREFIX_REX) << VEX_POSITION_RXB) | opecode->map, buffer);
+    append_binary_prefix((w << VEX_POSITION_W) | ((~vvvv & VEX_VVVV_MASK) << VEX_POSITION_VVVV) | opecode->pp, buffer);
+}
+
+
 /*
 append binary for instruction prefix if necessary
 */
@@ -1880,6 +2600,42 @@ static void may_append_binary_instruction_prefix(OperandKind kind, uint8_t prefi
 }
 
 
+/*
+append binary for segment override prefix if a memory operand specifies segment register
+*/
+static void may_append_binary_segment_prefix(const List(Operand) *operands, ByteBufferType *buffer)
+{
+    if(operands == NULL)
+    {
+        return;
+    }
+
+    for_each_entry(Operand, cursor, operands)
+    {
+        const Operand *operand = get_element(Operand)(cursor);
+        if(!is_memory(operand->kind))
+        {
+            continue;
+        }
+
+        switch(operand->segment)
+        {
+        case SG_FS:
+            append_binary_prefix(PREFIX_SEGMENT_FS, buffer);
+            break;
+
+        case SG_GS:
+            append_binary_prefix(PREFIX_SEGMENT_GS, buffer);
+            break;
+
+        case SG_NONE:
+        default:
+            break;
+        }
+    }
+}
+
+
 /*
 append binary for REX prefix for instructions with reg and r/m fields if necessary
 */
@@ -12,21 +12,39 @@
 #define SIZEOF_16BIT    sizeof(uint16_t)
 #define SIZEOF_32BIT    sizeof(uint32_t)
 #define SIZEOF_64BIT    sizeof(uint64_t)
+#define SIZEOF_128BIT   (2 * sizeof(uint64_t))
 
+typedef enum BranchKind BranchKind;
 typedef enum DataKind DataKind;
+typedef enum ExtensionKind ExtensionKind;
 typedef enum OperandKind OperandKind;
+typedef enum PrefixKind PrefixKind;
 typedef enum MnemonicKind MnemonicKind;
 typedef enum RegisterKind RegisterKind;
+typedef enum SegmentKind SegmentKind;
 typedef struct Bss Bss;
 typedef struct Data Data;
 typedef struct MnemonicInfo MnemonicInfo;
 typedef struct Operand Operand;
 typedef struct Operation Operation;
+typedef struct PrefixInfo PrefixInfo;
 typedef struct RegisterInfo RegisterInfo;
 
 #include "list.h"
 define_list(Operand)
 
+// kind of branch
+enum BranchKind
+{
+    BR_NONE     = 0x00, // not a branch
+    BR_JCC      = 0x01, // conditional jump
+    BR_FUSED    = 0x02, // conditional jump fused with the preceding instruction
+    BR_JMP      = 0x04, // unconditional direct jump
+    BR_CALL     = 0x08, // direct call
+    BR_RET      = 0x10, // return
+    BR_INDIRECT = 0x20, // indirect jump and call
+};
+
 // kind of data
 enum DataKind
 {
@@ -34,22 +52,82 @@ enum DataKind
     DT_SYMBOL,    // symbol
 };
 
+// kind of instruction set extension
+enum ExtensionKind
+{
+    EX_NONE   = 0x00, // no extension
+    EX_BMI    = 0x01, // bit manipulation instruction set 1
+    EX_BMI2   = 0x02, // bit manipulation instruction set 2
+    EX_CX16   = 0x04, // cmpxchg16b
+    EX_LZCNT  = 0x08, // lzcnt
+    EX_POPCNT = 0x10, // popcnt
+    EX_ALL    = 0x1f, // all extensions
+};
+
 // kind of mnemonic
 enum MnemonicKind
 {
     MN_ADD,
     MN_AND,
+    MN_ANDN,
+    MN_BEXTR,
+    MN_BLSI,
+    MN_BLSMSK,
+    MN_BLSR,
+    MN_BSF,
+    MN_BSR,
+    MN_BT,
+    MN_BTC,
+    MN_BTR,
+    MN_BTS,
+    MN_BZHI,
     MN_CALL,
     MN_CDQ,
+    MN_CMOVA,
+    MN_CMOVAE,
+    MN_CMOVB,
+    MN_CMOVBE,
+    MN_CMOVC,
+    MN_CMOVE,
+    MN_CMOVG,
+    MN_CMOVGE,
+    MN_CMOVL,
+    MN_CMOVLE,
+    MN_CMOVNA,
+    MN_CMOVNAE,
+    MN_CMOVNB,
+    MN_CMOVNBE,
+    MN_CMOVNC,
+    MN_CMOVNE,
+    MN_CMOVNG,
+    MN_CMOVNGE,
+    MN_CMOVNL,
+    MN_CMOVNLE,
+    MN_CMOVNO,
+    MN_CMOVNP,
+    MN_CMOVNS,
+    MN_CMOVNZ,
+    MN_CMOVO,
+    MN_CMOVP,
+    MN_CMOVPE,
+    MN_CMOVPO,
+    MN_CMOVS,
+    MN_CMOVZ,
     MN_CMP,
+    MN_CMPSB,
+    MN_CMPXCHG,
+    MN_CMPXCHG16B,
     MN_CQO,
     MN_CWD,
     MN_IDIV,
     MN_IMUL,
     MN_JA,
+    MN_JAE,
     MN_JB,
     MN_JBE,
+    MN_JC,
     MN_JE,
+    MN_JECXZ,
     MN_JG,
     MN_JGE,
     MN_JL,
@@ -57,32 +135,62 @@ enum MnemonicKind
     MN_JMP,
     MN_JNA,
     MN_JNAE,
+    MN_JNB,
     MN_JNBE,
+    MN_JNC,
     MN_JNE,
     MN_JNG,
     MN_JNGE,
     MN_JNL,
     MN_JNLE,
+    MN_JNO,
+    MN_JNP,
+    MN_JNS,
+    MN_JNZ,
+    MN_JO,
+    MN_JP,
+    MN_JPE,
+    MN_JPO,
+    MN_JRCXZ,
+    MN_JS,
+    MN_JZ,
     MN_LEA,
     MN_LEAVE,
+    MN_LFENCE,
+    MN_LODSB,
+    MN_LZCNT,
+    MN_MFENCE,
     MN_MOV,
+    MN_MOVSB,
+    MN_MOVSD,
+    MN_MOVSQ,
+    MN_MOVSW,
     MN_MOVSX,
     MN_MOVSXD,
     MN_MOVZX,
+    MN_MULX,
     MN_NEG,
     MN_NOP,
     MN_NOT,
     MN_OR,
+    MN_PAUSE,
+    MN_PDEP,
+    MN_PEXT,
     MN_POP,
+    MN_POPCNT,
     MN_PUSH,
     MN_PUSHFQ,
     MN_RET,
+    MN_RORX,
     MN_SAL,
     MN_SAR,
+    MN_SARX,
+    MN_SCASB,
     MN_SETA,
     MN_SETAE,
     MN_SETB,
     MN_SETBE,
+    MN_SETC,
     MN_SETE,
     MN_SETG,
     MN_SETGE,
@@ -92,14 +200,35 @@ enum MnemonicKind
     MN_SETNAE,
     MN_SETNB,
     MN_SETNBE,
+    MN_SETNC,
     MN_SETNE,
     MN_SETNG,
     MN_SETNGE,
     MN_SETNL,
     MN_SETNLE,
+    MN_SETNO,
+    MN_SETNP,
+    MN_SETNS,
+    MN_SETNZ,
+    MN_SETO,
+    MN_SETP,
+    MN_SETPE,
+    MN_SETPO,
+    MN_SETS,
+    MN_SETZ,
+    MN_SFENCE,
     MN_SHL,
+    MN_SHLX,
     MN_SHR,
+    MN_SHRX,
+    MN_STOSB,
+    MN_STOSD,
+    MN_STOSQ,
+    MN_STOSW,
     MN_SUB,
+    MN_TZCNT,
+    MN_XADD,
+    MN_XCHG,
     MN_XOR,
 };
 
@@ -118,9 +247,20 @@ enum OperandKind
     OP_M16,    // 16-bit memory
     OP_M32,    // 32-bit memory
     OP_M64,    // 64-bit memory
+    OP_M128,   // 128-bit memory
     OP_SYMBOL, // symbol
 };
 
+// kind of instruction prefix
+enum PrefixKind
+{
+    PF_NONE  = 0x00, // no prefix
+    PF_LOCK  = 0x01, // lock
+    PF_REP   = 0x02, // rep
+    PF_REPE  = 0x04, // repe, repz
+    PF_REPNE = 0x08, // repne, repnz
+};
+
 // kind of register
 enum RegisterKind
 {
@@ -189,6 +329,15 @@ enum RegisterKind
     REG_R14,
     REG_R15,
     REG_RIP,
+    REG_NONE, // no base register of memory operand
+};
+
+// kind of segment register overriding the default segment
+enum SegmentKind
+{
+    SG_NONE, // default segment
+    SG_FS,   // fs segment
+    SG_GS,   // gs segment
 };
 
 // structure for bss
@@ -213,7 +362,9 @@ struct MnemonicInfo
     MnemonicKind kind;                                                        // kind of mnemonic
     const char *name;                                                         // name of mnemonic
     bool take_operands;                                                       // flag indicating that the mnemonic takes operands
-    const void (*generate_function)(const List(Operand) *, ByteBufferType *); // function to generate operation
+    uint8_t prefixes;                                                         // set of prefixes accepted by the mnemonic
+    uint8_t extensions;                                                       // set of instruction set extensions required by the mnemonic
+    const void (*generate_function)(const List(Operand) *, ByteBufferType *); // function to generate operation (NULL if encoded by the instruction table)
 };
 
 // structure for operand
@@ -225,6 +376,7 @@ struct Operand
         uintmax_t immediate; // immediate value
         RegisterKind reg;    // kind of register
         Symbol *symbol;      // symbol
+        SegmentKind segment; // segment register overriding the default segment (only for memory)
     };
 };
 
@@ -232,7 +384,16 @@ struct Operand
 struct Operation
 {
     MnemonicKind kind;             // kind of operation
+    PrefixKind prefix;             // instruction prefix
     const List(Operand) *operands; // list of operands
+    bool arch_specified;           // flag indicating that the instruction follows .arch directive other than "default"
+};
+
+// structure for mapping from string to kind of instruction prefix
+struct PrefixInfo
+{
+    PrefixKind kind;  // kind of prefix
+    const char *name; // name of prefix
 };
 
 // structure for mapping from string to kind of register
@@ -246,11 +407,17 @@ struct RegisterInfo
 extern const MnemonicInfo mnemonic_info_list[];
 extern const size_t MNEMONIC_INFO_LIST_SIZE;
 
+extern const PrefixInfo prefix_info_list[];
+extern const size_t PREFIX_INFO_LIST_SIZE;
+
 extern const RegisterInfo register_info_list[];
 extern const size_t REGISTER_INFO_LIST_SIZE;
 
 void generate_data(const Data *data, ByteBufferType *buffer);
 void generate_operation(const Operation *operation, ByteBufferType *text_body);
+void generate_nop_padding(size_t size, ByteBufferType *buffer);
+BranchKind get_branch_kind(const Operation *operation);
+bool is_fused_operation_pair(const Operation *operation, const Operation *jcc);
 size_t get_least_size(uintmax_t value);
 
 #endif /* !PROCESSOR_H */
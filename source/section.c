@@ -3,13 +3,22 @@
 #include <string.h>
 
 #include "buffer.h"
+#include "elf_class.h"
 #include "output.h"
 #include "section.h"
+#include "string_table.h"
 
 #include "list.h"
 define_list_operations(Elf_Shdr)
+define_list_operations(Group)
 define_list_operations(Section)
 
+#include "map.h"
+define_map(Group)
+define_map_operations(Group)
+define_map(Section)
+define_map_operations(Section)
+
 static Section *new_section
 (
     SectionKind kind,
@@ -19,10 +28,11 @@ static Section *new_section
     Elf_Xword alignment,
     Elf_Xword entry_size
 );
-static Section *get_section_by_name(const char *name);
+static bool needs_symtab_shndx(void);
+static bool has_section_prefix(const char *name, const char *prefix);
 static bool has_rela_section(const Section *section);
 static void set_index_of_sections(void);
-static Elf_Word get_strtab_position(const ByteBufferType *strtab_body, const char *name, Elf_Word sh_type);
+static void make_group_sections(void);
 static Elf_Shdr *new_section_header_table
 (
     const char *section_name,
@@ -41,14 +51,43 @@ static size_t output_section(const ByteBufferType *buffer, Elf_Off offset, size_
 static const Elf_Addr DEFAULT_SECTION_ADDR = 0;
 static const Elf_Word DEFAULT_SECTION_INFO = 0;
 static const Elf_Xword DEFAULT_SECTION_ALIGNMENT = 1;
-static const Elf_Xword RELA_SECTION_ALIGNMENT = 8;
-static const Elf_Xword SYMTAB_SECTION_ALIGNMENT = 8;
-static const size_t STRLEN_OF_RELA = 5; // strlen(".rela")
+static const Elf_Xword SYMTAB_SHNDX_SECTION_ALIGNMENT = 4;
+static const Elf_Xword GROUP_SECTION_ALIGNMENT = 4;
+static const char GROUP_SECTION_NAME[] = ".group";
+static const char RELA_SECTION_PREFIX[] = ".rela";
+#define ADDRESS_ENTRY_SIZE ((Elf_Xword)-1) // entry size replaced with the size of address
 
-static List(Section) *section_list; // list of base sections
-static List(Elf_Shdr) *shdr_list;   // list of section header table entries
+static const SectionAttributeInfo default_section_attribute_list[] =
+{
+    {".bss",           SHT_NOBITS,        SHF_WRITE | SHF_ALLOC,           0},
+    {".data",          SHT_PROGBITS,      SHF_WRITE | SHF_ALLOC,           0},
+    {".fini_array",    SHT_FINI_ARRAY,    SHF_WRITE | SHF_ALLOC,           ADDRESS_ENTRY_SIZE},
+    {".init_array",    SHT_INIT_ARRAY,    SHF_WRITE | SHF_ALLOC,           ADDRESS_ENTRY_SIZE},
+    {".note",          SHT_NOTE,          0,                               0},
+    {".preinit_array", SHT_PREINIT_ARRAY, SHF_WRITE | SHF_ALLOC,           ADDRESS_ENTRY_SIZE},
+    {".rodata",        SHT_PROGBITS,      SHF_ALLOC,                       0},
+    {".tbss",          SHT_NOBITS,        SHF_WRITE | SHF_ALLOC | SHF_TLS, 0},
+    {".tdata",         SHT_PROGBITS,      SHF_WRITE | SHF_ALLOC | SHF_TLS, 0},
+    {".text",          SHT_PROGBITS,      SHF_ALLOC | SHF_EXECINSTR,        0},
+};
+static const size_t DEFAULT_SECTION_ATTRIBUTE_LIST_SIZE = sizeof(default_section_attribute_list) / sizeof(default_section_attribute_list[0]);
+
+static List(Section) *section_list;   // list of base sections
+static Section **section_array;       // array of base sections indexed by their kinds (NULL if not made yet)
+static size_t section_array_capacity; // number of slots of the array
+static Map(Section) *section_map;     // map from name to base section
+static List(Group) *group_list;       // list of section groups
+static Map(Group) *group_map;         // map from signature to section group
+static List(Elf_Shdr) *shdr_list;     // list of section header table entries
+static StringTable *shstrtab;         // string table of section names
 
 static SectionKind current_section = SC_TEXT;
+static SectionKind next_custom_section = SC_CUSTOM; // kind of custom section to be made next
+static SectionKind label_section = SC_UND;          // section dedicated to the last label placed in its own section
+static SectionKind label_section_base = SC_UND;     // section from which the last dedicated section is derived
+static SectionKind *section_stack = NULL;           // stack of sections saved by .pushsection
+static size_t section_stack_size = 0;               // number of sections in the stack
+static size_t section_stack_capacity = 0;           // capacity of the stack
 
 
 /*
@@ -69,13 +108,36 @@ static Section *new_section
     section->rela_body = calloc(1, sizeof(ByteBufferType));
     section->kind = kind;
     section->name = name;
+    char *rela_name = calloc(strlen(RELA_SECTION_PREFIX) + strlen(name) + 1, sizeof(char));
+    section->rela_name = strcat(strcpy(rela_name, RELA_SECTION_PREFIX), name);
     section->type = type;
     section->flags = flags;
     section->link = SHN_UNDEF;
     section->info = DEFAULT_SECTION_INFO;
     section->alignment = alignment;
     section->entry_size = entry_size;
+    section->symtab_index = 0;
+    section->group = NULL;
     add_list_entry_tail(Section)(section_list, section);
+    if(type != SHT_GROUP)
+    {
+        // group sections are not looked up by name, since all of them have the same name
+        insert_map(Section)(section_map, name, section);
+    }
+
+    // kinds of sections are dense, so that they are used as indices of array
+    if((size_t)kind >= section_array_capacity)
+    {
+        size_t capacity = (section_array_capacity == 0) ? SC_CUSTOM : section_array_capacity;
+        while((size_t)kind >= capacity)
+        {
+            capacity *= 2;
+        }
+        section_array = realloc(section_array, capacity * sizeof(Section *));
+        memset(&section_array[section_array_capacity], 0, (capacity - section_array_capacity) * sizeof(Section *));
+        section_array_capacity = capacity;
+    }
+    section_array[kind] = section;
 
     return section;
 }
@@ -87,6 +149,9 @@ initialize base sections
 void initialize_section(void)
 {
     section_list = new_list(Section)();
+    section_map = new_map(Section)();
+    group_list = new_list(Group)();
+    group_map = new_map(Group)();
     shdr_list = new_list(Elf_Shdr)();
 
     // make reserved sections
@@ -100,11 +165,17 @@ void initialize_section(void)
 /*
 make metadata sections
 */
-void make_metadata_sections(ByteBufferType *symtab_body, ByteBufferType *strtab_body, ByteBufferType *shstrtab_body)
+void make_metadata_sections(ByteBufferType *symtab_body, ByteBufferType *symtab_shndx_body, ByteBufferType *strtab_body, ByteBufferType *shstrtab_body)
 {
-    Section *section_symtab = new_section(SC_SYMTAB, ".symtab", SHT_SYMTAB, 0, SYMTAB_SECTION_ALIGNMENT, sizeof(Elf_Sym));
+    Section *section_symtab = new_section(SC_SYMTAB, ".symtab", SHT_SYMTAB, 0, get_address_size(), get_sym_size());
     section_symtab->body = symtab_body;
 
+    if(needs_symtab_shndx())
+    {
+        Section *section_symtab_shndx = new_section(SC_SYMTAB_SHNDX, ".symtab_shndx", SHT_SYMTAB_SHNDX, 0, SYMTAB_SHNDX_SECTION_ALIGNMENT, sizeof(Elf_Word));
+        section_symtab_shndx->body = symtab_shndx_body;
+    }
+
     Section *section_strtab = new_section(SC_STRTAB, ".strtab", SHT_STRTAB, 0, DEFAULT_SECTION_ALIGNMENT, 0);
     section_strtab->body = strtab_body;
 
@@ -112,6 +183,7 @@ void make_metadata_sections(ByteBufferType *symtab_body, ByteBufferType *strtab_
     section_shstrtab->body = shstrtab_body;
 
     set_index_of_sections();
+    make_group_sections();
 }
 
 
@@ -137,44 +209,204 @@ void set_current_section(const char *name)
 
 
 /*
-get base section
+make a new custom section unless a section of the same name exists, and return the section of the name
 */
-Section *get_section(SectionKind kind)
+Section *make_section(const char *name, Elf_Word type, Elf_Xword flags, Elf_Xword entry_size)
 {
-    for_each_entry(Section, cursor, section_list)
+    Section *section = get_section_by_name(name);
+    if(section == NULL)
     {
-        Section *section = get_element(Section)(cursor);
-        if(section->kind == kind)
-        {
-            return section;
-        }
+        section = new_section(next_custom_section, name, type, flags, DEFAULT_SECTION_ALIGNMENT, entry_size);
+        next_custom_section++;
     }
 
-    return NULL;
+    return section;
 }
 
 
 /*
-get base section by name
+check if name of section is a prefix or starts with the prefix followed by "."
 */
-static Section *get_section_by_name(const char *name)
+static bool has_section_prefix(const char *name, const char *prefix)
 {
-    for_each_entry(Section, cursor, section_list)
+    size_t len = strlen(prefix);
+    return (strncmp(name, prefix, len) == 0) && ((name[len] == '\0') || (name[len] == '.'));
+}
+
+
+/*
+get default type, flags and entry size of section by its name
+* Entries of arrays of addresses have the size of address, which is 4 bytes for ELFCLASS32.
+*/
+void get_default_section_attributes(const char *name, Elf_Word *type, Elf_Xword *flags, Elf_Xword *entry_size)
+{
+    *type = SHT_PROGBITS;
+    *flags = 0;
+    *entry_size = 0;
+    for(size_t i = 0; i < DEFAULT_SECTION_ATTRIBUTE_LIST_SIZE; i++)
     {
-        Section *section = get_element(Section)(cursor);
-        if(strcmp(section->name, name) == 0)
+        const SectionAttributeInfo *info = &default_section_attribute_list[i];
+        if(has_section_prefix(name, info->name))
         {
-            return section;
+            *type = info->type;
+            *flags = info->flags;
+            *entry_size = (info->entry_size == ADDRESS_ENTRY_SIZE) ? get_address_size() : info->entry_size;
+            return;
         }
     }
+}
+
+
+/*
+make a new section group unless a group of the same signature exists, and return the group of the signature
+* This function returns NULL if the existing group has different flags.
+*/
+Group *make_group(const char *signature, Elf_Word flags)
+{
+    Group *group = search_map(Group)(group_map, signature);
+    if(group != NULL)
+    {
+        return (group->flags == flags) ? group : NULL;
+    }
+
+    group = calloc(1, sizeof(Group));
+    group->signature = signature;
+    group->flags = flags;
+    group->section = new_section(next_custom_section, GROUP_SECTION_NAME, SHT_GROUP, 0, GROUP_SECTION_ALIGNMENT, sizeof(Elf_Word));
+    next_custom_section++;
+    add_list_entry_tail(Group)(group_list, group);
+    insert_map(Group)(group_map, signature, group);
 
-    return NULL;
+    return group;
 }
 
 
-static ByteBufferType *append_shstrtab(const char *name, ByteBufferType *buffer)
+/*
+add a section to a group
+* This function returns false if the section belongs to another group or is made before the group, since the group section must precede its members.
+*/
+bool add_group_member(Group *group, Section *section)
 {
-    return append_bytes(name, strlen(name) + 1, buffer);
+    if(section->group == group)
+    {
+        return true;
+    }
+    if((section->group != NULL) || (section->kind < group->section->kind))
+    {
+        return false;
+    }
+
+    section->group = group;
+    section->flags |= SHF_GROUP;
+    return true;
+}
+
+
+/*
+get list of section groups
+*/
+List(Group) *get_group_list(void)
+{
+    return group_list;
+}
+
+
+/*
+push the current section to the stack
+*/
+void push_section(void)
+{
+    if(section_stack_size == section_stack_capacity)
+    {
+        section_stack_capacity = (section_stack_capacity == 0) ? 8 : (section_stack_capacity * 2);
+        section_stack = realloc(section_stack, section_stack_capacity * sizeof(SectionKind));
+    }
+    section_stack[section_stack_size] = current_section;
+    section_stack_size++;
+}
+
+
+/*
+pop a section from the stack and make it the current section, or return false if the stack is empty
+*/
+bool pop_section(void)
+{
+    if(section_stack_size == 0)
+    {
+        return false;
+    }
+
+    section_stack_size--;
+    current_section = section_stack[section_stack_size];
+    return true;
+}
+
+
+/*
+switch to a section dedicated to a label, which is named after the label following the name of the base section such as ".text.main"
+*/
+void set_label_section(SectionKind base, const char *label)
+{
+    const Section *section = get_section(base);
+    char *name = calloc(strlen(section->name) + strlen(label) + 2, sizeof(char));
+    sprintf(name, "%s.%s", section->name, label);
+    make_section(name, section->type, section->flags, section->entry_size);
+    set_current_section(name);
+    label_section = current_section;
+    label_section_base = base;
+}
+
+
+/*
+get section from which the current section is derived, which is the current section itself unless it is dedicated to a label
+*/
+SectionKind get_base_section(void)
+{
+    return (current_section == label_section) ? label_section_base : current_section;
+}
+
+
+/*
+get base section
+*/
+Section *get_section(SectionKind kind)
+{
+    return ((size_t)kind < section_array_capacity) ? section_array[kind] : NULL;
+}
+
+
+/*
+get list of base sections
+*/
+List(Section) *get_section_list(void)
+{
+    return section_list;
+}
+
+
+/*
+get base section by name
+*/
+Section *get_section_by_name(const char *name)
+{
+    return search_map(Section)(section_map, name);
+}
+
+
+/*
+check if section header indices exceed the range of ordinary indices, which requires .symtab_shndx section
+* This function should be called before metadata sections are made.
+*/
+static bool needs_symtab_shndx(void)
+{
+    // metadata sections are .symtab, .strtab and .shstrtab
+    size_t shnum = 3;
+    for_each_entry(Section, cursor, section_list)
+    {
+        shnum += has_rela_section(get_element(Section)(cursor)) ? 2 : 1;
+    }
+
+    return shnum >= SHN_LORESERVE;
 }
 
 
@@ -184,28 +416,27 @@ make section name string table
 ByteBufferType *make_shstrtab(ByteBufferType *buffer)
 {
     // add names of indispensable sections
-    append_shstrtab("", buffer);
-    append_shstrtab(".symtab", buffer);
-    append_shstrtab(".strtab", buffer);
-    append_shstrtab(".shstrtab", buffer);
-
-    // add names of defined sections
-    static const char *rela_prefix = ".rela";
-    const size_t prefix_size = strlen(rela_prefix);
+    shstrtab = new_string_table();
+    add_string(shstrtab, ".symtab");
+    if(needs_symtab_shndx())
+    {
+        add_string(shstrtab, ".symtab_shndx");
+    }
+    add_string(shstrtab, ".strtab");
+    add_string(shstrtab, ".shstrtab");
+
+    // add names of defined sections, which are merged into names of the associated relocation sections
     for_each_entry(Section, cursor, section_list)
     {
         Section *section = get_element(Section)(cursor);
-        if(section->kind != SC_UND)
+        add_string(shstrtab, section->name);
+        if(has_rela_section(section))
         {
-            if(section->rela_body->size > 0)
-            {
-                append_bytes(rela_prefix, prefix_size, buffer); // append prefix ".rela" if the section has the associated relocation section
-            }
-            append_shstrtab(section->name, buffer);
+            add_string(shstrtab, section->rela_name);
         }
     }
 
-    return buffer;
+    return build_string_table(shstrtab, buffer);
 }
 
 
@@ -237,12 +468,47 @@ static void set_index_of_sections(void)
 }
 
 
+/*
+make bodies of group sections after indices of sections are set
+* A body consists of flags of the group followed by section header indices of its members including relocation sections.
+*/
+static void make_group_sections(void)
+{
+    for_each_entry(Group, cursor, group_list)
+    {
+        const Group *group = get_element(Group)(cursor);
+        append_uint(group->flags, sizeof(Elf_Word), group->section->body);
+    }
+
+    for_each_entry(Section, cursor, section_list)
+    {
+        const Section *section = get_element(Section)(cursor);
+        if(section->group != NULL)
+        {
+            ByteBufferType *body = section->group->section->body;
+            append_uint(section->index, sizeof(Elf_Word), body);
+            if(has_rela_section(section))
+            {
+                append_uint(section->index + 1, sizeof(Elf_Word), body);
+            }
+        }
+    }
+
+    for_each_entry(Group, cursor, group_list)
+    {
+        Section *section = get_element(Group)(cursor)->section;
+        section->size = section->body->size;
+        section->link = get_section(SC_SYMTAB)->index; // sh_link holds section header index of the associated symbol table
+    }
+}
+
+
 /*
 set offset of sections
 */
 void set_offset_of_sections(void)
 {
-    Elf_Off offset = sizeof(Elf_Ehdr);
+    Elf_Off offset = get_ehdr_size();
     for_each_entry(Section, cursor, section_list)
     {
         Section *section = get_element(Section)(cursor);
@@ -265,7 +531,7 @@ void set_offset_of_sections(void)
         Section *section = get_element(Section)(cursor);
         if(has_rela_section(section))
         {
-            section->rela_offset = align_to(offset, RELA_SECTION_ALIGNMENT);
+            section->rela_offset = align_to(offset, get_address_size());
             offset = section->rela_offset + section->rela_body->size;
         }
     }
@@ -275,42 +541,6 @@ void set_offset_of_sections(void)
 }
 
 
-/*
-get string table index of name
-*/
-static Elf_Word get_strtab_position(const ByteBufferType *strtab_body, const char *name, Elf_Word sh_type)
-{
-    size_t len = strlen(name);
-    size_t range = strtab_body->size - len;
-
-    for(Elf_Word pos = 0; pos < range; pos++)
-    {
-        const char *start = &strtab_body->body[pos];
-        bool equal = true;
-        for(size_t i = 0; i < len; i++)
-        {
-            if(start[i] != name[i])
-            {
-                equal = false;
-                break;
-            }
-        }
-
-        if(equal)
-        {
-            if(sh_type == SHT_RELA)
-            {
-                pos -= STRLEN_OF_RELA;
-            }
-
-            return pos;
-        }
-    }
-
-    return range;
-}
-
-
 /*
 set members of a section header table entry
 */
@@ -330,8 +560,7 @@ static Elf_Shdr *new_section_header_table
     Elf_Shdr *shdr = calloc(1, sizeof(Elf_Shdr));
 
     // set members
-    const Section *section_shstrtab = get_section(SC_SHSTRTAB);
-    shdr->sh_name = get_strtab_position(section_shstrtab->body, section_name, sh_type);
+    shdr->sh_name = get_string_offset(shstrtab, section_name);
     shdr->sh_type = sh_type;
     shdr->sh_flags = sh_flags;
     shdr->sh_addr = DEFAULT_SECTION_ADDR;
@@ -370,15 +599,15 @@ static void new_section_header_table_from_section(const Section *section)
         // .rela.xxx section
         const Section *section_symtab = get_section(SC_SYMTAB);
         new_section_header_table(
-            section->name,
+            section->rela_name,
             SHT_RELA,
-            SHF_INFO_LINK,
+            SHF_INFO_LINK | (section->flags & SHF_GROUP),
             section->rela_offset,
             section->rela_body->size,
             section_symtab->index, // sh_link holds section header index of the associated symbol table
             section->index, // sh_info holds section header index of the section to which the relocation applies
-            RELA_SECTION_ALIGNMENT,
-            sizeof(Elf_Rela));
+            get_address_size(),
+            get_rela_size());
     }
 }
 
@@ -401,6 +630,19 @@ void generate_section_header_table_entries(size_t symtab_shinfo)
 
     section_shstrtab->size = section_shstrtab->body->size;
 
+    Section *section_symtab_shndx = get_section(SC_SYMTAB_SHNDX);
+    if(section_symtab_shndx != NULL)
+    {
+        section_symtab_shndx->size = section_symtab_shndx->body->size;
+        section_symtab_shndx->link = section_symtab->index; // sh_link holds section header index of the associated symbol table
+    }
+
+    // the initial entry holds the number of entries and index of .shstrtab section if they do not fit in the ELF header
+    Section *section_und = get_section(SC_UND);
+    Elf_Word shnum = section_shstrtab->index + 1;
+    section_und->size = (shnum >= SHN_LORESERVE) ? shnum : 0;
+    section_und->link = (section_shstrtab->index >= SHN_LORESERVE) ? section_shstrtab->index : SHN_UNDEF;
+
     // make section header table entries
     for_each_entry(Section, cursor, section_list)
     {
@@ -466,6 +708,6 @@ void output_section_header_table_entries(FILE *fp)
     for_each_entry(Elf_Shdr, cursor, shdr_list)
     {
         const Elf_Shdr *shdr = get_element(Elf_Shdr)(cursor);
-        output_buffer(shdr, sizeof(Elf_Shdr), fp);
+        output_section_header(shdr, fp);
     }
 }
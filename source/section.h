@@ -1,6 +1,7 @@
 #ifndef SECTION_H
 #define SECTION_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 
@@ -8,10 +9,13 @@
 #include "elf_wrap.h"
 
 typedef enum SectionKind SectionKind;
+typedef struct Group Group;
 typedef struct Section Section;
+typedef struct SectionAttributeInfo SectionAttributeInfo;
 
 #include "list.h"
 define_list(Elf_Shdr)
+define_list(Group)
 define_list(Section)
 
 // kind of section
@@ -21,10 +25,11 @@ enum SectionKind
     SC_TEXT,     // .text section
     SC_DATA,     // .data section
     SC_BSS,      // .bss section
-    SC_SYMTAB,   // .symtab section
-    SC_STRTAB,   // .strtab section
-    SC_SHSTRTAB, // .shstrtab section
-    SC_CUSTOM,   // custom section
+    SC_SYMTAB,       // .symtab section
+    SC_SYMTAB_SHNDX, // .symtab_shndx section (only if extended section indices are needed)
+    SC_STRTAB,       // .strtab section
+    SC_SHSTRTAB,     // .shstrtab section
+    SC_CUSTOM,       // the first custom section, which is followed by the other custom sections in order of appearance
 };
 
 // structure for base section
@@ -32,6 +37,7 @@ struct Section
 {
     SectionKind kind;          // kind of section
     const char *name;          // name of section
+    const char *rela_name;     // name of relocation section
     ByteBufferType *body;      // body of section
     ByteBufferType *rela_body; // body of relocation section
     Elf_Off rela_offset;       // offset of corresponding relocation section
@@ -44,13 +50,43 @@ struct Section
     Elf_Word info;             // dditional section information
     Elf_Xword alignment;       // alignment of section
     Elf_Xword entry_size;      // entry size of table in section (if exists)
+    Elf_Xword symtab_index;    // index of symbol table entry for section (0 if not registered to the symbol table)
+    Group *group;              // group to which section belongs (NULL if section is not a member of any group)
+};
+
+// structure for section group
+struct Group
+{
+    const char *signature; // name of signature symbol
+    Elf_Word flags;        // flags of group
+    Section *section;      // group section, which lists section header indices of members
+};
+
+// structure for default attributes of sections by name
+struct SectionAttributeInfo
+{
+    const char *name;     // name of section, which also matches names of sections starting with it followed by "."
+    Elf_Word type;        // type of section
+    Elf_Xword flags;      // flags of section
+    Elf_Xword entry_size; // size of entries (ADDRESS_ENTRY_SIZE for arrays of addresses)
 };
 
 void initialize_section(void);
-void make_metadata_sections(ByteBufferType *symtab_body, ByteBufferType *strtab_body, ByteBufferType *shstrtab_body);
+void make_metadata_sections(ByteBufferType *symtab_body, ByteBufferType *symtab_shndx_body, ByteBufferType *strtab_body, ByteBufferType *shstrtab_body);
 SectionKind get_current_section(void);
 void set_current_section(const char *name);
+Section *make_section(const char *name, Elf_Word type, Elf_Xword flags, Elf_Xword entry_size);
+void get_default_section_attributes(const char *name, Elf_Word *type, Elf_Xword *flags, Elf_Xword *entry_size);
+Group *make_group(const char *signature, Elf_Word flags);
+bool add_group_member(Group *group, Section *section);
+List(Group) *get_group_list(void);
+void push_section(void);
+bool pop_section(void);
+void set_label_section(SectionKind base, const char *label);
+SectionKind get_base_section(void);
 Section *get_section(SectionKind kind);
+Section *get_section_by_name(const char *name);
+List(Section) *get_section_list(void);
 ByteBufferType *make_shstrtab(ByteBufferType *buffer);
 void set_offset_of_sections(void);
 void generate_section_header_table_entries(size_t symtab_shinfo);
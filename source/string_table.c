@@ -0,0 +1,129 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "string_table.h"
+
+#include "list.h"
+define_list_operations(StringTableEntry)
+
+#include "map.h"
+define_map_operations(StringTableEntry)
+
+static int compare_reversed_strings(const void *entry1, const void *entry2);
+
+
+/*
+make a new string table
+*/
+StringTable *new_string_table(void)
+{
+    StringTable *table = calloc(1, sizeof(StringTable));
+    table->entry_list = new_list(StringTableEntry)();
+    table->entry_map = new_map(StringTableEntry)();
+
+    return table;
+}
+
+
+/*
+add a string to string table unless it has been added
+*/
+void add_string(StringTable *table, const char *string)
+{
+    if(search_map(StringTableEntry)(table->entry_map, string) != NULL)
+    {
+        return;
+    }
+
+    StringTableEntry *entry = calloc(1, sizeof(StringTableEntry));
+    entry->string = string;
+    entry->len = strlen(string);
+    entry->offset = 0;
+    insert_map(StringTableEntry)(table->entry_map, string, entry);
+    add_list_entry_tail(StringTableEntry)(table->entry_list, entry);
+}
+
+
+/*
+compare strings from their ends in descending order, so that a string follows the others ending with it
+*/
+static int compare_reversed_strings(const void *entry1, const void *entry2)
+{
+    const StringTableEntry *string1 = *(StringTableEntry * const *)entry1;
+    const StringTableEntry *string2 = *(StringTableEntry * const *)entry2;
+    size_t pos1 = string1->len;
+    size_t pos2 = string2->len;
+    while((pos1 > 0) && (pos2 > 0))
+    {
+        pos1--;
+        pos2--;
+        unsigned char c1 = string1->string[pos1];
+        unsigned char c2 = string2->string[pos2];
+        if(c1 != c2)
+        {
+            return (c1 < c2) ? 1 : -1;
+        }
+    }
+
+    if(string1->len != string2->len)
+    {
+        return (string1->len < string2->len) ? 1 : -1;
+    }
+
+    return 0;
+}
+
+
+/*
+build body of string table, merging each string into the previous one if it is a suffix of the previous one
+* The empty string is put at the top of the table.
+*/
+ByteBufferType *build_string_table(const StringTable *table, ByteBufferType *buffer)
+{
+    size_t size = get_length(StringTableEntry)(table->entry_list);
+    StringTableEntry **entries = calloc(size, sizeof(StringTableEntry *));
+    size_t i = 0;
+    for_each_entry(StringTableEntry, cursor, table->entry_list)
+    {
+        entries[i] = get_element(StringTableEntry)(cursor);
+        i++;
+    }
+    qsort(entries, size, sizeof(StringTableEntry *), compare_reversed_strings);
+
+    append_bytes("\x00", 1, buffer);
+    const StringTableEntry *previous = NULL;
+    for(i = 0; i < size; i++)
+    {
+        StringTableEntry *entry = entries[i];
+        if(entry->len == 0)
+        {
+            entry->offset = 0;
+        }
+        else if((previous != NULL) && (previous->len >= entry->len) && (memcmp(&previous->string[previous->len - entry->len], entry->string, entry->len) == 0))
+        {
+            entry->offset = previous->offset + (previous->len - entry->len);
+        }
+        else
+        {
+            entry->offset = buffer->size;
+            append_bytes(entry->string, entry->len + 1, buffer);
+            previous = entry;
+        }
+    }
+    free(entries);
+
+    return buffer;
+}
+
+
+/*
+get offset of a string in string table which has been built
+*/
+Elf_Word get_string_offset(const StringTable *table, const char *string)
+{
+    const StringTableEntry *entry = search_map(StringTableEntry)(table->entry_map, string);
+    assert(entry != NULL);
+
+    return entry->offset;
+}
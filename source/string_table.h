@@ -0,0 +1,38 @@
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include <stddef.h>
+
+#include "buffer.h"
+#include "elf_wrap.h"
+
+typedef struct StringTable StringTable;
+typedef struct StringTableEntry StringTableEntry;
+
+#include "list.h"
+define_list(StringTableEntry)
+
+#include "map.h"
+define_map(StringTableEntry)
+
+// structure for string in string table
+struct StringTableEntry
+{
+    const char *string; // body of string
+    size_t len;         // length of string
+    Elf_Word offset;    // offset of string in string table
+};
+
+// structure for string table whose strings are deduplicated and merged into the others ending with them
+struct StringTable
+{
+    List(StringTableEntry) *entry_list; // list of distinct strings in order of addition
+    Map(StringTableEntry) *entry_map;   // map from string to its entry
+};
+
+StringTable *new_string_table(void);
+void add_string(StringTable *table, const char *string);
+ByteBufferType *build_string_table(const StringTable *table, ByteBufferType *buffer);
+Elf_Word get_string_offset(const StringTable *table, const char *string);
+
+#endif /* !STRING_TABLE_H */
@@ -1,5 +1,4 @@
 #include <stdlib.h>
-#include <string.h>
 
 #include "symbol.h"
 
@@ -20,11 +19,16 @@ Symbol *new_symbol(const Token *token)
     symbol->value = 0;
     symbol->address = 0;
     symbol->addend = 0;
+    symbol->reloc_size = 0;
+    symbol->suffix = RS_NONE;
     symbol->appeared = SC_UND;
     symbol->located = SC_UND;
     symbol->bind = STB_LOCAL;
     symbol->labeled = false;
     symbol->declared = false;
+    symbol->attributed = false;
+    symbol->relative = false;
+    symbol->symtab_index = 0;
     add_list_entry_tail(Symbol)(symbol_list, symbol);
 
     return symbol;
@@ -32,51 +36,27 @@ Symbol *new_symbol(const Token *token)
 
 
 /*
-set information of symbol
-*/
-Symbol *set_symbol(Elf_Addr address, Elf_Sxword addend, SectionKind appeared, Symbol *symbol)
-{
-    symbol->address = address;
-    symbol->addend = addend;
-    symbol->appeared = appeared;
-
-    return symbol;
-}
-
-
-/*
-search symbol by name
+delete a symbol
 */
-Symbol *search_symbol(const List(Symbol) *symbol_list, const char *body)
+void delete_symbol(Symbol *symbol)
 {
-    for_each_entry(Symbol, cursor, symbol_list)
-    {
-        Symbol *symbol = get_element(Symbol)(cursor);
-        if(strcmp(symbol->body, body) == 0)
-        {
-            return symbol;
-        }
-    }
-
-    return NULL;
+    free((char *)symbol->body);
+    free(symbol);
 }
 
 
 /*
-search declared symbol by name
+set information of symbol
+* The section where the symbol appeared is set after the statement referring to it is generated.
 */
-Symbol *search_symbol_declaration(const List(Symbol) *symbol_list, const char *body)
+Symbol *set_symbol(Elf_Addr address, Elf_Sxword addend, size_t reloc_size, bool relative, Symbol *symbol)
 {
-    for_each_entry(Symbol, cursor, symbol_list)
-    {
-        Symbol *symbol = get_element(Symbol)(cursor);
-        if(symbol->declared && strcmp(symbol->body, body) == 0)
-        {
-            return symbol;
-        }
-    }
+    symbol->address = address;
+    symbol->addend = addend;
+    symbol->reloc_size = reloc_size;
+    symbol->relative = relative;
 
-    return NULL;
+    return symbol;
 }
 
 
@@ -7,29 +7,47 @@
 #include "tokenizer.h"
 #include "section.h"
 
+typedef enum RelocationSuffix RelocationSuffix;
 typedef struct Symbol Symbol;
 
 #include "list.h"
 define_list(Symbol)
 
+// kind of relocation designated by suffix of symbol
+enum RelocationSuffix
+{
+    RS_NONE,          // no suffix
+    RS_GOTPCREL,      // "@GOTPCREL"
+    RS_GOTPCRELX,     // "@GOTPCREL" in an instruction which the linker can relax
+    RS_REX_GOTPCRELX, // "@GOTPCREL" in an instruction with REX prefix which the linker can relax
+    RS_PLT,           // "@PLT", which is implied by the target of a direct branch
+    RS_DTPOFF,        // "@DTPOFF", offset in TLS block of module
+    RS_GOTTPOFF,      // "@GOTTPOFF", GOT entry holding offset from thread pointer
+    RS_TPOFF,         // "@TPOFF", offset from thread pointer
+};
+
 // structure for symbol
 struct Symbol
 {
-    const char *body;     // symbol body
-    Elf_Addr value;       // offset from the top of the located section
-    Elf_Addr address;     // address where the symbol appeared
-    Elf_Sxword addend;    // addend for relocation
-    SectionKind appeared; // section where symbol appeared
-    SectionKind located;  // section where symbol is located
-    unsigned char bind;   // bind of symbol
-    bool labeled;         // flag indicating that the symbol is label
-    bool declared;        // flag indicating that the symbol is declaration
+    const char *body;        // symbol body
+    Elf_Addr value;          // offset from the top of the located section
+    Elf_Addr address;        // address where the symbol appeared
+    Elf_Sxword addend;       // addend for relocation
+    size_t reloc_size;       // size of field to be relocated
+    RelocationSuffix suffix; // kind of relocation designated by suffix
+    SectionKind appeared;    // section where symbol appeared
+    SectionKind located;     // section where symbol is located
+    unsigned char bind;      // bind of symbol
+    bool labeled;            // flag indicating that the symbol is label
+    bool declared;           // flag indicating that the symbol is declaration
+    bool attributed;         // flag indicating that the symbol is named by a directive giving its visibility
+    bool relative;           // flag indicating that the symbol is referred by an address relative to where it appeared
+    Elf_Xword symtab_index;  // index of symbol table entry (only for symbols registered to the symbol table)
 };
 
 Symbol *new_symbol(const Token *token);
-Symbol *set_symbol(Elf_Addr address, Elf_Sxword addend, SectionKind appeared, Symbol *symbol);
-Symbol *search_symbol(const List(Symbol) *symbol_list, const char *body);
-Symbol *search_symbol_declaration(const List(Symbol) *symbol_list, const char *body);
+void delete_symbol(Symbol *symbol);
+Symbol *set_symbol(Elf_Addr address, Elf_Sxword addend, size_t reloc_size, bool relative, Symbol *symbol);
 void initialize_symbol_list(void);
 List(Symbol) *get_symbol_list(void);
 
@@ -12,6 +12,7 @@
 #include "tokenizer.h"
 
 typedef struct ReservedWordInfo ReservedWordInfo;
+typedef struct SourceText SourceText;
 
 struct ReservedWordInfo
 
@@ -20,16 +21,29 @@ struct ReservedWordInfo
     size_t size;       // size of list
 };
 
+struct SourceText
+{
+    char *str;       // text of source code ending with "\n\0"
+    size_t len;      // length of text
+    int line_number; // line number of the first line of text
+};
+
 #include "list.h"
 define_list(Token)
 define_list_operations(Token)
+define_list(SourceText)
+define_list_operations(SourceText)
 
 // function prototype
 static Token *new_token(TokenKind kind, char *str, int len);
+static Token *fetch_token(void);
+static void tokenize_text(char *str, int line_number);
+static char *read_line(FILE *stream);
 static int is_space(const char *str);
 static int is_comment(const char *str);
 static int is_reserved(const char *str);
 static int is_mnemonic(const char *str);
+static int is_prefix(const char *str);
 static int is_identifier(const char *str);
 static int is_string(const char *str);
 static int is_register(const char *str);
@@ -49,6 +63,7 @@ static const char *punctuator_list[] = {
     ",",
     "-",
     ":",
+    "@",
     "[",
     "]",
 };
@@ -58,20 +73,45 @@ static const char *size_specifier_list[] = {
     "word ptr",
     "dword ptr",
     "qword ptr",
+    "xmmword ptr",
 };
 // list of directives
 static const char *directive_list[] = {
     ".align",
+    ".arch",
     ".bss",
     ".byte",
+    ".cfi_adjust_cfa_offset",
+    ".cfi_def_cfa",
+    ".cfi_def_cfa_offset",
+    ".cfi_def_cfa_register",
+    ".cfi_endproc",
+    ".cfi_offset",
+    ".cfi_rel_offset",
+    ".cfi_remember_state",
+    ".cfi_restore",
+    ".cfi_restore_state",
+    ".cfi_same_value",
+    ".cfi_startproc",
+    ".cfi_undefined",
     ".data",
+    ".file",
     ".global",
     ".globl",
+    ".hidden",
     ".intel_syntax noprefix",
+    ".internal",
+    ".loc",
     ".long",
+    ".popsection",
+    ".protected",
+    ".pushsection",
     ".quad",
+    ".section",
+    ".size",
     ".string",
     ".text",
+    ".type",
     ".value",
     ".word",
     ".zero",
@@ -99,10 +139,12 @@ static const struct {int character; int value;} simple_escape_sequence_map[] = {
     {'v', '\v'},
 };
 static const size_t SIMPLE_ESCAPE_SEQUENCE_SIZE = sizeof(simple_escape_sequence_map) / sizeof(simple_escape_sequence_map[0]); // number of simple escape sequences
-static char *user_input; // input of assembler
+static List(SourceText) *text_list; // list of texts of source code which tokens are made from
 static List(Token) *token_list; // list of tokens
 static ListEntry(Token) *current_token; // currently parsing token
 static const char *file_name; // name of source file
+static FILE *source_stream; // stream of source file read line by line (only in stream mode)
+static int read_line_count; // number of lines read from stream of source file
 
 
 /*
@@ -120,6 +162,181 @@ static Token *new_token(TokenKind kind, char *str, int len)
 }
 
 
+/*
+get the currently parsing token, reading lines from the source file if necessary
+* In stream mode, lines are tokenized until a token is made or the end of file is reached.
+*/
+static Token *fetch_token(void)
+{
+    while((source_stream != NULL) && end_iteration(Token)(token_list, current_token))
+    {
+        char *line = read_line(source_stream);
+        if(line == NULL)
+        {
+            fclose(source_stream);
+            source_stream = NULL;
+            break;
+        }
+
+        ListEntry(Token) *last = get_last_entry(Token)(token_list);
+        tokenize_text(line, ++read_line_count);
+        current_token = next_entry(Token, last);
+    }
+
+    return get_element(Token)(current_token);
+}
+
+
+/*
+tokenize a given text of source code and append tokens to the token stream
+*/
+static void tokenize_text(char *str, int line_number)
+{
+    // save text
+    SourceText *text = calloc(1, sizeof(SourceText));
+    text->str = str;
+    text->len = strlen(str);
+    text->line_number = line_number;
+    add_list_entry_tail(SourceText)(text_list, text);
+
+    while(*str)
+    {
+        int len;
+
+        // ignore space
+        len = is_space(str);
+        if(len > 0)
+        {
+            str += len;
+            continue;
+        }
+
+        // ignore comment
+        len = is_comment(str);
+        if(len > 0)
+        {
+            str += len;
+            continue;
+        }
+
+        // parse a reserved string
+        len = is_reserved(str);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_RESERVED, str, len);
+            add_list_entry_tail(Token)(token_list, token);
+            str += len;
+            continue;
+        }
+
+        // parse a mnemonic
+        len = is_mnemonic(str);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_MNEMONIC, str, len);
+            add_list_entry_tail(Token)(token_list, token);
+            str += len;
+            continue;
+        }
+
+        // parse an instruction prefix
+        len = is_prefix(str);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_PREFIX, str, len);
+            add_list_entry_tail(Token)(token_list, token);
+            str += len;
+            continue;
+        }
+
+        // parse a register
+        len = is_register(str);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_REGISTER, str, len);
+            add_list_entry_tail(Token)(token_list, token);
+            str += len;
+            continue;
+        }
+
+        // parse a string-literal
+        len = is_string(str);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_STRING, str + 1, len - 2);
+            add_list_entry_tail(Token)(token_list, token);
+            str += len;
+            continue;
+        }
+
+        // parse an identifier
+        len = is_identifier(str);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_IDENTIFIER, str, len);
+            add_list_entry_tail(Token)(token_list, token);
+            str += len;
+            continue;
+        }
+
+        // parse an immediate
+        uintmax_t value;
+        len = is_immediate(str, &value);
+        if(len > 0)
+        {
+            Token *token = new_token(TK_IMMEDIATE, str, len);
+            add_list_entry_tail(Token)(token_list, token);
+            token->value = value;
+            str += len;
+            continue;
+        }
+
+        // Other characters are not accepted as a token.
+        report_error(str, "cannot tokenize.");
+    }
+
+}
+
+
+/*
+read a line from a stream
+* The line is made end with "\n\0", and NULL is returned at the end of file.
+*/
+static char *read_line(FILE *stream)
+{
+    size_t size = 128;
+    size_t len = 0;
+    char *line = calloc(size, sizeof(char));
+    while(fgets(&line[len], size - len, stream) != NULL)
+    {
+        len += strlen(&line[len]);
+        if(line[len - 1] == '\n')
+        {
+            return line;
+        }
+
+        // extend buffer, which also leaves space for "\n\0" at the end of file
+        size *= 2;
+        line = realloc(line, size);
+    }
+    if(ferror(stream))
+    {
+        fprintf(stderr, "%s: fgets: %s\n", file_name, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    if(len == 0)
+    {
+        free(line);
+        return NULL;
+    }
+    line[len] = '\n';
+    line[len + 1] = '\0';
+
+    return line;
+}
+
+
 /*
 peek a reserved string
 * If the next token is a given string, this function returns true.
@@ -127,7 +344,7 @@ peek a reserved string
 */
 bool peek_reserved(const char *str)
 {
-    Token *current = get_element(Token)(current_token);
+    Token *current = fetch_token();
 
     return (
            (current->kind == TK_RESERVED)
@@ -143,7 +360,7 @@ peek a token
 */
 bool peek_token(TokenKind kind, Token **token)
 {
-    Token *current = get_element(Token)(current_token);
+    Token *current = fetch_token();
 
     if(current->kind == kind)
     {
@@ -198,7 +415,7 @@ get the currently parsing token
 */
 Token *get_token(void)
 {
-    return get_element(Token)(current_token);
+    return fetch_token();
 }
 
 
@@ -227,7 +444,7 @@ void expect_reserved(const char *str)
 {
     if(!consume_reserved(str))
     {
-        report_error(get_element(Token)(current_token)->str, "expected '%s'.", str);
+        report_error(fetch_token()->str, "expected '%s'.", str);
     }
 }
 
@@ -239,7 +456,7 @@ parse a token
 */
 Token *expect_token(TokenKind kind)
 {
-    Token *current = get_element(Token)(current_token);
+    Token *current = fetch_token();
 
     if(current->kind != kind)
     {
@@ -254,6 +471,10 @@ Token *expect_token(TokenKind kind)
             message = "expected an immediate.";
             break;
 
+        case TK_MNEMONIC:
+            message = "expected a mnemonic.";
+            break;
+
         case TK_REGISTER:
             message = "expected a register.";
             break;
@@ -279,100 +500,73 @@ tokenize a given string
 */
 void tokenize(char *str)
 {
-    // save input
-    user_input = str;
-
     // initialize token stream
+    text_list = new_list(SourceText)();
     token_list = new_list(Token)();
+    tokenize_text(str, 1);
 
-    while(*str)
-    {
-        int len;
-
-        // ignore space
-        len = is_space(str);
-        if(len > 0)
-        {
-            str += len;
-            continue;
-        }
-
-        // ignore comment
-        len = is_comment(str);
-        if(len > 0)
-        {
-            str += len;
-            continue;
-        }
+    // reset the currently parsing token
+    current_token = get_first_entry(Token)(token_list);
+}
 
-        // parse a reserved string
-        len = is_reserved(str);
-        if(len > 0)
-        {
-            Token *token = new_token(TK_RESERVED, str, len);
-            current_token = add_list_entry_tail(Token)(token_list, token);
-            str += len;
-            continue;
-        }
 
-        // parse a mnemonic
-        len = is_mnemonic(str);
-        if(len > 0)
-        {
-            Token *token = new_token(TK_MNEMONIC, str, len);
-            current_token = add_list_entry_tail(Token)(token_list, token);
-            str += len;
-            continue;
-        }
+/*
+tokenize a source file in stream mode
+* Lines are read and tokenized only when the parser requests the token following them.
+*/
+void tokenize_stream(const char *path)
+{
+    // open source file
+    source_stream = fopen(path, "r");
+    if(source_stream == NULL)
+    {
+        fprintf(stderr, "cannot open %s: %s\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    file_name = path;
+    read_line_count = 0;
 
-        // parse a register
-        len = is_register(str);
-        if(len > 0)
-        {
-            Token *token = new_token(TK_REGISTER, str, len);
-            current_token = add_list_entry_tail(Token)(token_list, token);
-            str += len;
-            continue;
-        }
+    // initialize token stream
+    text_list = new_list(SourceText)();
+    token_list = new_list(Token)();
+    current_token = get_first_entry(Token)(token_list);
+}
 
-        // parse a string-literal
-        len = is_string(str);
-        if(len > 0)
-        {
-            Token *token = new_token(TK_STRING, str + 1, len - 2);
-            current_token = add_list_entry_tail(Token)(token_list, token);
-            str += len;
-            continue;
-        }
 
-        // parse an identifier
-        len = is_identifier(str);
-        if(len > 0)
-        {
-            Token *token = new_token(TK_IDENTIFIER, str, len);
-            current_token = add_list_entry_tail(Token)(token_list, token);
-            str += len;
-            continue;
-        }
+/*
+release tokens before the currently parsing token
+* Texts of source code are also released unless the currently parsing token or the following tokens are made from them.
+*/
+void release_tokens(void)
+{
+    // release tokens
+    ListEntry(Token) *entry = get_first_entry(Token)(token_list);
+    while(entry != current_token)
+    {
+        ListEntry(Token) *next = next_entry(Token, entry);
+        free(get_element(Token)(entry));
+        free(entry);
+        entry = next;
+    }
+    set_first_entry(Token)(token_list, current_token);
 
-        // parse an immediate
-        uintmax_t value;
-        len = is_immediate(str, &value);
-        if(len > 0)
+    // release texts
+    const Token *token = get_element(Token)(current_token);
+    ListEntry(SourceText) *text_entry = get_first_entry(SourceText)(text_list);
+    while(!end_iteration(SourceText)(text_list, text_entry))
+    {
+        SourceText *text = get_element(SourceText)(text_entry);
+        if((token != NULL) && (text->str <= token->str) && (token->str <= text->str + text->len))
         {
-            Token *token = new_token(TK_IMMEDIATE, str, len);
-            current_token = add_list_entry_tail(Token)(token_list, token);
-            token->value = value;
-            str += len;
-            continue;
+            break;
         }
-
-        // Other characters are not accepted as a token.
-        report_error(str, "cannot tokenize.");
+        ListEntry(SourceText) *next = next_entry(SourceText, text_entry);
+        free(text->str);
+        free(text);
+        free(text_entry);
+        text_entry = next;
     }
-
-    // reset the currently parsing token
-    current_token = get_first_entry(Token)(token_list);
+    set_first_entry(SourceText)(text_list, text_entry);
 }
 
 
@@ -381,6 +575,8 @@ check if the current token is the end of input
 */
 bool at_eof(void)
 {
+    fetch_token();
+
     return end_iteration(Token)(token_list, current_token);
 }
 
@@ -517,6 +713,7 @@ static int is_comment(const char *str)
 
 /*
 check if the following string is reserved
+* A reserved word ending with an alphanumeric character does not match the beginning of a longer identifier (e.g. ".text" in ".text.hot").
 */
 static int is_reserved(const char *str)
 {
@@ -529,7 +726,11 @@ static int is_reserved(const char *str)
             size_t len = strlen(word);
             if(strncmp(str, word, len) == 0)
             {
-                return len;
+                bool continued = isalnum(word[len - 1]) && (isalnum(str[len]) || (str[len] == '_') || (str[len] == '.'));
+                if(!continued)
+                {
+                    return len;
+                }
             }
         }
     }
@@ -558,6 +759,25 @@ static int is_mnemonic(const char *str)
 }
 
 
+/*
+check if the following string is an instruction prefix
+*/
+static int is_prefix(const char *str)
+{
+    for(size_t i = 0; i < PREFIX_INFO_LIST_SIZE; i++)
+    {
+        const char *prefix = prefix_info_list[i].name;
+        size_t len = strlen(prefix);
+        if((strncmp(str, prefix, len) == 0) && (!isalnum(str[len]) && (str[len] != '_')))
+        {
+            return len;
+        }
+    }
+
+    return 0;
+}
+
+
 /*
 check if the following string is an identifier
 */
@@ -797,9 +1017,20 @@ report the position at which a warning or an error is detected
 */
 static void report_position(const char *loc)
 {
+    // search the text including the given location
+    const SourceText *text = NULL;
+    for_each_entry(SourceText, cursor, text_list)
+    {
+        text = get_element(SourceText)(cursor);
+        if((text->str <= loc) && (loc <= text->str + text->len))
+        {
+            break;
+        }
+    }
+
     // search the first and last character of the line including the given location
     int start_pos = 0;
-    while((user_input < &loc[start_pos]) && (loc[start_pos-1] != '\n'))
+    while((text->str < &loc[start_pos]) && (loc[start_pos-1] != '\n'))
     {
         start_pos--;
     }
@@ -810,8 +1041,8 @@ static void report_position(const char *loc)
     }
 
     // search the line number including the given location
-    int line_number = 1;
-    for(char *p = user_input; p < &loc[start_pos]; p++)
+    int line_number = text->line_number;
+    for(const char *p = text->str; p < &loc[start_pos]; p++)
     {
         if(*p == '\n')
         {
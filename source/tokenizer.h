@@ -12,6 +12,7 @@ enum TokenKind
     TK_RESERVED,   // reserved token (punctuator, size-specifier or directive)
     TK_IDENTIFIER, // identifier
     TK_MNEMONIC,   // mnemonic
+    TK_PREFIX,     // instruction prefix
     TK_IMMEDIATE,  // immediate
     TK_REGISTER,   // register
     TK_STRING,     // string-literal
@@ -35,6 +36,8 @@ void set_token(Token *token);
 void expect_reserved(const char *str);
 Token *expect_token(TokenKind kind);
 void tokenize(char *str);
+void tokenize_stream(const char *path);
+void release_tokens(void);
 bool at_eof(void);
 char *make_identifier(const Token *token);
 char *read_file(const char *path);
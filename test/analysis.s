@@ -0,0 +1,23 @@
+.intel_syntax noprefix
+.global main
+main:
+    push rbp
+    mov rbp, rsp
+    xor eax, eax
+    mov rcx, 16
+sum:
+    add rax, qword ptr [rdi]
+    imul rax, rdx
+    add rdi, 8
+    sub rcx, 1
+    jnz sum
+update:
+    mov qword ptr [rsi], rax
+    add qword ptr [rsi+8], 1
+    cmp rax, rdx
+    cmovl rax, rdx
+    popcnt rdx, rax
+    lea rsi, qword ptr [rsi+16]
+    jmp sum
+    pop rbp
+    ret
@@ -0,0 +1,86 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_scan_common.h"
+
+
+static void generate_test_case_bit_scan_reg_reg(FILE *fp, const char *mnemonic, uintmax_t source, uintmax_t result, const RegisterInfo *reg1_info, const RegisterInfo *reg2_info)
+{
+    size_t size = reg1_info->size;
+    size_t index_list[] = {reg1_info->index, reg2_info->index};
+    const char *reg1 = reg1_info->name;
+    const char *reg2 = reg2_info->name;
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+
+    const char *work_reg = generate_save_register(fp, index_list, sizeof(index_list) / sizeof(index_list[0]));
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg2, source);
+    put_line_with_tab(fp, "%s %s, %s    # test target", mnemonic, reg1, reg2);
+    put_line_with_tab(fp, "mov %s, %s", arg2, reg1);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, result);
+    generate_restore_register(fp, work_reg);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_test_case_bit_scan_reg_mem(FILE *fp, const char *mnemonic, uintmax_t source, uintmax_t result, size_t size)
+{
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+    const char *reg = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, source);
+    put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg);
+    put_line_with_tab(fp, "%s %s, %s [rbp-8]    # test target", mnemonic, arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, result);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+void generate_all_test_case_bit_scan(FILE *fp, const BitScanOperationTestDataMaker *make_test_data)
+{
+    static const uintmax_t source_list[] = {0x0, 0x1, 0x80, 0x0ff0, 0x8001, 0x00f0000f, 0x8000000080000000, 0x0123456789abcdef, 0x8000000000000000};
+    static const size_t SOURCE_LIST_SIZE = sizeof(source_list) / sizeof(source_list[0]);
+
+    // <mnemonic> reg, reg
+    for(size_t i = 0; i < REG_LIST_SIZE; i++)
+    {
+        const RegisterInfo *reg1_info = &reg_list[i];
+        size_t size = reg1_info->size;
+        if(size > sizeof(uint8_t))
+        {
+            const RegisterInfo *reg2_info = &reg_list[(i % 16 == 15) ? (i - 15) : (i + 1)];
+            for(size_t k = 0; k < SOURCE_LIST_SIZE; k++)
+            {
+                uintmax_t source = source_list[k] & (((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1);
+                if((source != 0) || make_test_data->accept_zero)
+                {
+                    uintmax_t result = make_test_data->operate(source, size);
+                    generate_test_case_bit_scan_reg_reg(fp, make_test_data->mnemonic, source, result, reg1_info, reg2_info);
+                    put_line(fp, "");
+                }
+            }
+        }
+    }
+
+    // <mnemonic> reg, mem
+    for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+    {
+        size_t size = imm_list[j].size;
+        if(size > sizeof(uint8_t))
+        {
+            for(size_t k = 0; k < SOURCE_LIST_SIZE; k++)
+            {
+                uintmax_t source = source_list[k] & (((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1);
+                if((source != 0) || make_test_data->accept_zero)
+                {
+                    uintmax_t result = make_test_data->operate(source, size);
+                    generate_test_case_bit_scan_reg_mem(fp, make_test_data->mnemonic, source, result, size);
+                    put_line(fp, "");
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_BIT_SCAN_COMMON_H
+#define TEST_BIT_SCAN_COMMON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct BitScanOperationTestDataMaker BitScanOperationTestDataMaker;
+
+struct BitScanOperationTestDataMaker
+{
+    const char *mnemonic;
+    bool accept_zero; // whether the result for zero source is defined
+    uintmax_t (*operate)(uintmax_t, size_t);
+};
+
+void generate_all_test_case_bit_scan(FILE *fp, const BitScanOperationTestDataMaker *make_test_data);
+
+#endif /* TEST_BIT_SCAN_COMMON_H */
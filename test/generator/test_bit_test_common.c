@@ -0,0 +1,105 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_test_common.h"
+
+
+static uintmax_t get_test_pattern(size_t size)
+{
+    return 0xa5a5a5a5a5a5a5a5 & (((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1);
+}
+
+
+static void generate_test_case_bit_test_assert_carry(FILE *fp, const BitTestOperationInfo *op_info)
+{
+    put_line_with_tab(fp, "mov sil, byte ptr [rbp-16]");
+    put_line_with_tab(fp, "mov dil, 0x%x", op_info->carry);
+    put_line_with_tab(fp, "call assert_equal_uint8");
+}
+
+
+static void generate_test_case_bit_test_reg(FILE *fp, const BitTestOperationInfo *op_info, const RegisterInfo *reg_info, const char *source)
+{
+    size_t size = reg_info->size;
+    size_t index_list[] = {reg_info->index, REGISTER_INDEX_ECX};
+    const char *reg = reg_info->name;
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+
+    const char *work_reg = generate_save_register(fp, index_list, sizeof(index_list) / sizeof(index_list[0]));
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, op_info->lhs);
+    put_line_with_tab(fp, "mov cl, 0x%x", op_info->rhs);
+    put_line_with_tab(fp, "%s %s, %s    # test target", op_info->mnemonic, reg, source);
+    put_line_with_tab(fp, "mov %s, %s", arg2, reg);
+    put_line_with_tab(fp, "setc dil");
+    generate_restore_register(fp, work_reg);
+    put_line_with_tab(fp, "mov byte ptr [rbp-16], dil");
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, op_info->result);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    generate_test_case_bit_test_assert_carry(fp, op_info);
+}
+
+
+static void generate_test_case_bit_test_mem(FILE *fp, const BitTestOperationInfo *op_info, size_t size, const char *source)
+{
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+    const char *reg = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, op_info->lhs);
+    put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg);
+    put_line_with_tab(fp, "mov rcx, 0x%x", op_info->rhs);
+    put_line_with_tab(fp, "%s %s [rbp-8], %s    # test target", op_info->mnemonic, size_spec, source);
+    put_line_with_tab(fp, "setc byte ptr [rbp-16]");
+    put_line_with_tab(fp, "mov %s, %s [rbp-8]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, op_info->result);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    generate_test_case_bit_test_assert_carry(fp, op_info);
+}
+
+
+void generate_all_test_case_bit_test(FILE *fp, BitTestOperationInfo (*make_test_data)(uintmax_t, uint8_t))
+{
+    // <mnemonic> reg, imm and <mnemonic> reg, reg
+    for(size_t i = 0; i < REG_LIST_SIZE; i++)
+    {
+        const RegisterInfo *reg_info = &reg_list[i];
+        size_t size = reg_info->size;
+        if((size > sizeof(uint8_t)) && (reg_info->index != REGISTER_INDEX_ECX))
+        {
+            uint8_t bit_list[] = {0, 1, convert_size_to_bit(size) - 1};
+            for(size_t k = 0; k < sizeof(bit_list) / sizeof(bit_list[0]); k++)
+            {
+                char source[8];
+                BitTestOperationInfo op_info = make_test_data(get_test_pattern(size), bit_list[k]);
+                snprintf(source, sizeof(source), "0x%x", bit_list[k]);
+                generate_test_case_bit_test_reg(fp, &op_info, reg_info, source);
+                put_line(fp, "");
+                generate_test_case_bit_test_reg(fp, &op_info, reg_info, get_register_by_index_and_size(REGISTER_INDEX_ECX, size));
+                put_line(fp, "");
+            }
+        }
+    }
+
+    // <mnemonic> mem, imm and <mnemonic> mem, reg
+    for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+    {
+        size_t size = imm_list[j].size;
+        if(size > sizeof(uint8_t))
+        {
+            uint8_t bit_list[] = {0, 1, convert_size_to_bit(size) - 1};
+            for(size_t k = 0; k < sizeof(bit_list) / sizeof(bit_list[0]); k++)
+            {
+                char source[8];
+                BitTestOperationInfo op_info = make_test_data(get_test_pattern(size), bit_list[k]);
+                snprintf(source, sizeof(source), "0x%x", bit_list[k]);
+                generate_test_case_bit_test_mem(fp, &op_info, size, source);
+                put_line(fp, "");
+                generate_test_case_bit_test_mem(fp, &op_info, size, get_register_by_index_and_size(REGISTER_INDEX_ECX, size));
+                put_line(fp, "");
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_BIT_TEST_COMMON_H
+#define TEST_BIT_TEST_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct BitTestOperationInfo BitTestOperationInfo;
+
+struct BitTestOperationInfo
+{
+    const char *mnemonic;
+    uintmax_t lhs;
+    uint8_t rhs;
+    uintmax_t result;
+    uint8_t carry;
+};
+
+void generate_all_test_case_bit_test(FILE *fp, BitTestOperationInfo (*make_test_data)(uintmax_t, uint8_t));
+
+#endif /* TEST_BIT_TEST_COMMON_H */
@@ -0,0 +1,342 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+typedef enum
+{
+    BMI_FORM_RVM, // <mnemonic> reg, reg, r/m
+    BMI_FORM_RMV, // <mnemonic> reg, r/m, reg
+    BMI_FORM_RMI, // <mnemonic> reg, r/m, imm8
+    BMI_FORM_VM,  // <mnemonic> reg, r/m
+} BmiOperationForm;
+
+typedef struct BmiInfo BmiInfo;
+
+struct BmiInfo
+{
+    const char *mnemonic;
+    BmiOperationForm form;
+    uintmax_t (*operate)(uintmax_t, uintmax_t, size_t);
+    uintmax_t src1;
+    uintmax_t src2;
+};
+
+
+static uintmax_t get_mask(size_t size)
+{
+    return (size < sizeof(uintmax_t)) ? (((uintmax_t)1 << convert_size_to_bit(size)) - 1) : UINTMAX_MAX;
+}
+
+
+static uintmax_t operate_andn(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    return ~src1 & src2;
+}
+
+
+static uintmax_t operate_bextr(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    size_t start = src2 & 0xff;
+    size_t length = (src2 >> 8) & 0xff;
+    uintmax_t extracted = (start < convert_size_to_bit(size)) ? (src1 >> start) : 0;
+    return (length < convert_size_to_bit(size)) ? (extracted & (((uintmax_t)1 << length) - 1)) : extracted;
+}
+
+
+static uintmax_t operate_blsi(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    return src1 & -src1;
+}
+
+
+static uintmax_t operate_blsmsk(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    return src1 ^ (src1 - 1);
+}
+
+
+static uintmax_t operate_blsr(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    return src1 & (src1 - 1);
+}
+
+
+static uintmax_t operate_bzhi(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    size_t index = src2 & 0xff;
+    return (index < convert_size_to_bit(size)) ? (src1 & (((uintmax_t)1 << index) - 1)) : src1;
+}
+
+
+static uintmax_t operate_pdep(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    uintmax_t result = 0;
+    size_t k = 0;
+    for(size_t i = 0; i < convert_size_to_bit(size); i++)
+    {
+        if((src2 >> i) & 1)
+        {
+            result |= ((src1 >> k) & 1) << i;
+            k++;
+        }
+    }
+
+    return result;
+}
+
+
+static uintmax_t operate_pext(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    uintmax_t result = 0;
+    size_t k = 0;
+    for(size_t i = 0; i < convert_size_to_bit(size); i++)
+    {
+        if((src2 >> i) & 1)
+        {
+            result |= ((src1 >> i) & 1) << k;
+            k++;
+        }
+    }
+
+    return result;
+}
+
+
+static uintmax_t operate_rorx(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    size_t bit = convert_size_to_bit(size);
+    size_t count = src2 & (bit - 1);
+    return (count == 0) ? src1 : ((src1 >> count) | (src1 << (bit - count)));
+}
+
+
+static uintmax_t operate_sarx(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    size_t bit = convert_size_to_bit(size);
+    size_t count = src2 & (bit - 1);
+    uintmax_t sign = ((src1 >> (bit - 1)) & 1) ? ~(get_mask(size) >> count) : 0;
+    return (src1 >> count) | sign;
+}
+
+
+static uintmax_t operate_shlx(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    return src1 << (src2 & (convert_size_to_bit(size) - 1));
+}
+
+
+static uintmax_t operate_shrx(uintmax_t src1, uintmax_t src2, size_t size)
+{
+    return src1 >> (src2 & (convert_size_to_bit(size) - 1));
+}
+
+
+static const BmiInfo bmi_info_list[] =
+{
+    {"andn",   BMI_FORM_RVM, operate_andn,   0x0123456789abcdef, 0xfedcba9876543210},
+    {"andn",   BMI_FORM_RVM, operate_andn,   0x00000000000000ff, 0x0000000000001234},
+    {"bextr",  BMI_FORM_RMV, operate_bextr,  0x0123456789abcdef, 0x0000000000000804},
+    {"bextr",  BMI_FORM_RMV, operate_bextr,  0xfedcba9876543210, 0x0000000000001010},
+    {"bextr",  BMI_FORM_RMV, operate_bextr,  0xfedcba9876543210, 0x0000000000004000},
+    {"blsi",   BMI_FORM_VM,  operate_blsi,   0x0123456789abcdef, 0x0000000000000000},
+    {"blsi",   BMI_FORM_VM,  operate_blsi,   0xfedcba9876543210, 0x0000000000000000},
+    {"blsmsk", BMI_FORM_VM,  operate_blsmsk, 0x0123456789abcdef, 0x0000000000000000},
+    {"blsmsk", BMI_FORM_VM,  operate_blsmsk, 0xfedcba9876543210, 0x0000000000000000},
+    {"blsr",   BMI_FORM_VM,  operate_blsr,   0x0123456789abcdef, 0x0000000000000000},
+    {"blsr",   BMI_FORM_VM,  operate_blsr,   0xfedcba9876543210, 0x0000000000000000},
+    {"bzhi",   BMI_FORM_RMV, operate_bzhi,   0xfedcba9876543210, 0x0000000000000000},
+    {"bzhi",   BMI_FORM_RMV, operate_bzhi,   0xfedcba9876543210, 0x000000000000000c},
+    {"bzhi",   BMI_FORM_RMV, operate_bzhi,   0xfedcba9876543210, 0x000000000000001f},
+    {"pdep",   BMI_FORM_RVM, operate_pdep,   0x0123456789abcdef, 0xf0f0f0f0f0f0f0f0},
+    {"pdep",   BMI_FORM_RVM, operate_pdep,   0x0000000000001234, 0x5555555555555555},
+    {"pext",   BMI_FORM_RVM, operate_pext,   0x0123456789abcdef, 0xf0f0f0f0f0f0f0f0},
+    {"pext",   BMI_FORM_RVM, operate_pext,   0xfedcba9876543210, 0x5555555500005555},
+    {"rorx",   BMI_FORM_RMI, operate_rorx,   0x0123456789abcdef, 0x0000000000000004},
+    {"rorx",   BMI_FORM_RMI, operate_rorx,   0xfedcba9876543210, 0x000000000000001f},
+    {"sarx",   BMI_FORM_RMV, operate_sarx,   0xfedcba9876543210, 0x0000000000000004},
+    {"sarx",   BMI_FORM_RMV, operate_sarx,   0x0123456789abcdef, 0x0000000000000011},
+    {"shlx",   BMI_FORM_RMV, operate_shlx,   0x0123456789abcdef, 0x0000000000000004},
+    {"shlx",   BMI_FORM_RMV, operate_shlx,   0xfedcba9876543210, 0x0000000000000011},
+    {"shrx",   BMI_FORM_RMV, operate_shrx,   0xfedcba9876543210, 0x0000000000000004},
+    {"shrx",   BMI_FORM_RMV, operate_shrx,   0x0123456789abcdef, 0x0000000000000011},
+};
+static const size_t BMI_INFO_LIST_SIZE = sizeof(bmi_info_list) / sizeof(bmi_info_list[0]);
+
+
+static void generate_test_case_bmi_reg(FILE *fp, const BmiInfo *bmi_info, size_t size, size_t index)
+{
+    const RegisterInfo *dst_info = &reg_list[16 * convert_size_to_index(size) + index];
+    const RegisterInfo *src1_info = &reg_list[16 * convert_size_to_index(size) + (index + 1) % 16];
+    const RegisterInfo *src2_info = &reg_list[16 * convert_size_to_index(size) + (index + 2) % 16];
+    size_t index_list[] = {dst_info->index, src1_info->index, src2_info->index};
+    uintmax_t src1 = bmi_info->src1 & get_mask(size);
+    uintmax_t src2 = bmi_info->src2 & get_mask(size);
+    uintmax_t result = bmi_info->operate(src1, src2, size) & get_mask(size);
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+
+    const char *work_reg = generate_save_register(fp, index_list, sizeof(index_list) / sizeof(index_list[0]));
+    put_line_with_tab(fp, "mov %s, 0x%llx", src1_info->name, src1);
+    put_line_with_tab(fp, "mov %s, 0x%llx", src2_info->name, src2);
+    switch(bmi_info->form)
+    {
+    case BMI_FORM_RMI:
+        put_line_with_tab(fp, "%s %s, %s, 0x%llx    # test target", bmi_info->mnemonic, dst_info->name, src1_info->name, src2);
+        break;
+
+    case BMI_FORM_VM:
+        put_line_with_tab(fp, "%s %s, %s    # test target", bmi_info->mnemonic, dst_info->name, src1_info->name);
+        break;
+
+    case BMI_FORM_RVM:
+    case BMI_FORM_RMV:
+    default:
+        put_line_with_tab(fp, "%s %s, %s, %s    # test target", bmi_info->mnemonic, dst_info->name, src1_info->name, src2_info->name);
+        break;
+    }
+    put_line_with_tab(fp, "mov %s, %s", arg2, dst_info->name);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, result);
+    generate_restore_register(fp, work_reg);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_test_case_bmi_mem(FILE *fp, const BmiInfo *bmi_info, size_t size)
+{
+    uintmax_t src1 = bmi_info->src1 & get_mask(size);
+    uintmax_t src2 = bmi_info->src2 & get_mask(size);
+    uintmax_t result = bmi_info->operate(src1, src2, size) & get_mask(size);
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *reg1 = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+    const char *reg2 = get_register_by_index_and_size(REGISTER_INDEX_R9D, size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg1, src1);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg2, src2);
+    switch(bmi_info->form)
+    {
+    case BMI_FORM_RVM:
+        put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg2);
+        put_line_with_tab(fp, "%s %s, %s, %s [rbp-8]    # test target", bmi_info->mnemonic, arg2, reg1, size_spec);
+        break;
+
+    case BMI_FORM_RMI:
+        put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg1);
+        put_line_with_tab(fp, "%s %s, %s [rbp-8], 0x%llx    # test target", bmi_info->mnemonic, arg2, size_spec, src2);
+        break;
+
+    case BMI_FORM_VM:
+        put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg1);
+        put_line_with_tab(fp, "%s %s, %s [rbp-8]    # test target", bmi_info->mnemonic, arg2, size_spec);
+        break;
+
+    case BMI_FORM_RMV:
+    default:
+        put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg1);
+        put_line_with_tab(fp, "%s %s, %s [rbp-8], %s    # test target", bmi_info->mnemonic, arg2, size_spec, reg2);
+        break;
+    }
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, result);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static uintmax_t multiply_high(uintmax_t lhs, uintmax_t rhs, size_t size)
+{
+    if(size < sizeof(uintmax_t))
+    {
+        return (lhs * rhs) >> convert_size_to_bit(size);
+    }
+
+    // compute upper half of 128-bit product from 32-bit halves
+    uintmax_t lhs_low = lhs & UINT32_MAX;
+    uintmax_t lhs_high = lhs >> 32;
+    uintmax_t rhs_low = rhs & UINT32_MAX;
+    uintmax_t rhs_high = rhs >> 32;
+    uintmax_t middle1 = lhs_high * rhs_low + ((lhs_low * rhs_low) >> 32);
+    uintmax_t middle2 = lhs_low * rhs_high + (middle1 & UINT32_MAX);
+    return lhs_high * rhs_high + (middle1 >> 32) + (middle2 >> 32);
+}
+
+
+static void generate_test_case_mulx(FILE *fp, uintmax_t lhs, uintmax_t rhs, size_t size, bool memory)
+{
+    uintmax_t low = (lhs * rhs) & get_mask(size);
+    uintmax_t high = multiply_high(lhs, rhs, size);
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *reg_high = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+    const char *reg_low = get_register_by_index_and_size(REGISTER_INDEX_R9D, size);
+    const char *reg_source = get_register_by_index_and_size(REGISTER_INDEX_R10D, size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", get_register_by_index_and_size(REGISTER_INDEX_EDX, size), lhs);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg_source, rhs);
+    put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg_source);
+    if(memory)
+    {
+        put_line_with_tab(fp, "mulx %s, %s, %s [rbp-8]    # test target", reg_high, reg_low, size_spec);
+    }
+    else
+    {
+        put_line_with_tab(fp, "mulx %s, %s, %s    # test target", reg_high, reg_low, reg_source);
+    }
+    put_line_with_tab(fp, "mov %s, %s", arg2, reg_high);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, high);
+    put_line_with_tab(fp, "mov %s [rbp-16], %s", size_spec, reg_low);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov %s, %s [rbp-16]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, low);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_all_test_case_bmi(FILE *fp)
+{
+    static const size_t size_list[] = {sizeof(uint32_t), sizeof(uint64_t)};
+    static const size_t SIZE_LIST_SIZE = sizeof(size_list) / sizeof(size_list[0]);
+
+    // <mnemonic> reg, reg, reg and similar
+    for(size_t i = 0; i < SIZE_LIST_SIZE; i++)
+    {
+        for(size_t index = 0; index < 16; index++)
+        {
+            for(size_t k = 0; k < BMI_INFO_LIST_SIZE; k++)
+            {
+                generate_test_case_bmi_reg(fp, &bmi_info_list[k], size_list[i], index);
+                put_line(fp, "");
+            }
+        }
+    }
+
+    // <mnemonic> reg, reg, mem and similar
+    for(size_t i = 0; i < SIZE_LIST_SIZE; i++)
+    {
+        for(size_t k = 0; k < BMI_INFO_LIST_SIZE; k++)
+        {
+            generate_test_case_bmi_mem(fp, &bmi_info_list[k], size_list[i]);
+            put_line(fp, "");
+        }
+    }
+
+    // mulx reg, reg, r/m
+    for(size_t i = 0; i < SIZE_LIST_SIZE; i++)
+    {
+        size_t size = size_list[i];
+        uintmax_t lhs = 0x0123456789abcdef & get_mask(size);
+        uintmax_t rhs = 0x7edcba9876543210 & get_mask(size);
+        generate_test_case_mulx(fp, lhs, rhs, size, false);
+        put_line(fp, "");
+        generate_test_case_mulx(fp, lhs, rhs, size, true);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_bmi(void)
+{
+    generate_test("test/test_bmi.s", STACK_ALIGNMENT, generate_all_test_case_bmi);
+}
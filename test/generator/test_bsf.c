@@ -0,0 +1,32 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_scan_common.h"
+
+
+static uintmax_t operate_bsf(uintmax_t source, size_t size)
+{
+    uintmax_t index = 0;
+    while(((source >> index) & 1) == 0)
+    {
+        index++;
+    }
+
+    return index;
+}
+
+
+static void generate_all_test_case_bsf(FILE *fp)
+{
+    static const BitScanOperationTestDataMaker make_test_data_bsf = {"bsf", false, operate_bsf};
+
+    generate_all_test_case_bit_scan(fp, &make_test_data_bsf);
+}
+
+
+void generate_test_bsf(void)
+{
+    generate_test("test/test_bsf.s", STACK_ALIGNMENT, generate_all_test_case_bsf);
+}
@@ -0,0 +1,32 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_scan_common.h"
+
+
+static uintmax_t operate_bsr(uintmax_t source, size_t size)
+{
+    uintmax_t index = convert_size_to_bit(size) - 1;
+    while(((source >> index) & 1) == 0)
+    {
+        index--;
+    }
+
+    return index;
+}
+
+
+static void generate_all_test_case_bsr(FILE *fp)
+{
+    static const BitScanOperationTestDataMaker make_test_data_bsr = {"bsr", false, operate_bsr};
+
+    generate_all_test_case_bit_scan(fp, &make_test_data_bsr);
+}
+
+
+void generate_test_bsr(void)
+{
+    generate_test("test/test_bsr.s", STACK_ALIGNMENT, generate_all_test_case_bsr);
+}
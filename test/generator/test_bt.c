@@ -0,0 +1,23 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_test_common.h"
+
+
+static BitTestOperationInfo make_test_data_bt(uintmax_t lhs, uint8_t rhs)
+{
+    return (BitTestOperationInfo){"bt", lhs, rhs, lhs, (lhs >> rhs) & 1};
+}
+
+
+static void generate_all_test_case_bt(FILE *fp)
+{
+    generate_all_test_case_bit_test(fp, make_test_data_bt);
+}
+
+
+void generate_test_bt(void)
+{
+    generate_test("test/test_bt.s", STACK_ALIGNMENT, generate_all_test_case_bt);
+}
@@ -0,0 +1,23 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_test_common.h"
+
+
+static BitTestOperationInfo make_test_data_btr(uintmax_t lhs, uint8_t rhs)
+{
+    return (BitTestOperationInfo){"btr", lhs, rhs, lhs & ~((uintmax_t)1 << rhs), (lhs >> rhs) & 1};
+}
+
+
+static void generate_all_test_case_btr(FILE *fp)
+{
+    generate_all_test_case_bit_test(fp, make_test_data_btr);
+}
+
+
+void generate_test_btr(void)
+{
+    generate_test("test/test_btr.s", STACK_ALIGNMENT, generate_all_test_case_btr);
+}
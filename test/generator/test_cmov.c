@@ -0,0 +1,225 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+typedef struct CmovInfo CmovInfo;
+
+struct CmovInfo
+{
+    const char *mnemonic;
+    intmax_t lhs;
+    intmax_t rhs;
+    bool result;
+};
+
+static const CmovInfo cmov_info_list[] =
+{
+    {"cmova", 0x01, 0x00, true},
+    {"cmova", 0x01, 0x01, false},
+    {"cmova", 0x00, 0x01, false},
+    {"cmova", INT64_MIN, 0x01, true},
+    {"cmovae", 0x01, 0x00, true},
+    {"cmovae", 0x01, 0x01, true},
+    {"cmovae", 0x00, 0x01, false},
+    {"cmovae", INT64_MIN, 0x01, true},
+    {"cmovb", 0x01, 0x00, false},
+    {"cmovb", 0x01, 0x01, false},
+    {"cmovb", 0x00, 0x01, true},
+    {"cmovb", INT64_MIN, 0x01, false},
+    {"cmovbe", 0x01, 0x00, false},
+    {"cmovbe", 0x01, 0x01, true},
+    {"cmovbe", 0x00, 0x01, true},
+    {"cmovbe", INT64_MIN, 0x01, false},
+    {"cmovc", 0x01, 0x00, false},
+    {"cmovc", 0x01, 0x01, false},
+    {"cmovc", 0x00, 0x01, true},
+    {"cmovc", INT64_MIN, 0x01, false},
+    {"cmove", 0x01, 0x00, false},
+    {"cmove", 0x01, 0x01, true},
+    {"cmove", 0x00, 0x01, false},
+    {"cmove", INT64_MIN, 0x01, false},
+    {"cmovg", 0x01, 0x00, true},
+    {"cmovg", 0x01, 0x01, false},
+    {"cmovg", 0x00, 0x01, false},
+    {"cmovg", INT64_MIN, 0x01, false},
+    {"cmovge", 0x01, 0x00, true},
+    {"cmovge", 0x01, 0x01, true},
+    {"cmovge", 0x00, 0x01, false},
+    {"cmovge", INT64_MIN, 0x01, false},
+    {"cmovl", 0x01, 0x00, false},
+    {"cmovl", 0x01, 0x01, false},
+    {"cmovl", 0x00, 0x01, true},
+    {"cmovl", INT64_MIN, 0x01, true},
+    {"cmovle", 0x01, 0x00, false},
+    {"cmovle", 0x01, 0x01, true},
+    {"cmovle", 0x00, 0x01, true},
+    {"cmovle", INT64_MIN, 0x01, true},
+    {"cmovna", 0x01, 0x00, false},
+    {"cmovna", 0x01, 0x01, true},
+    {"cmovna", 0x00, 0x01, true},
+    {"cmovna", INT64_MIN, 0x01, false},
+    {"cmovnae", 0x01, 0x00, false},
+    {"cmovnae", 0x01, 0x01, false},
+    {"cmovnae", 0x00, 0x01, true},
+    {"cmovnae", INT64_MIN, 0x01, false},
+    {"cmovnb", 0x01, 0x00, true},
+    {"cmovnb", 0x01, 0x01, true},
+    {"cmovnb", 0x00, 0x01, false},
+    {"cmovnb", INT64_MIN, 0x01, true},
+    {"cmovnbe", 0x01, 0x00, true},
+    {"cmovnbe", 0x01, 0x01, false},
+    {"cmovnbe", 0x00, 0x01, false},
+    {"cmovnbe", INT64_MIN, 0x01, true},
+    {"cmovnc", 0x01, 0x00, true},
+    {"cmovnc", 0x01, 0x01, true},
+    {"cmovnc", 0x00, 0x01, false},
+    {"cmovnc", INT64_MIN, 0x01, true},
+    {"cmovne", 0x01, 0x00, true},
+    {"cmovne", 0x01, 0x01, false},
+    {"cmovne", 0x00, 0x01, true},
+    {"cmovne", INT64_MIN, 0x01, true},
+    {"cmovng", 0x01, 0x00, false},
+    {"cmovng", 0x01, 0x01, true},
+    {"cmovng", 0x00, 0x01, true},
+    {"cmovng", INT64_MIN, 0x01, true},
+    {"cmovnge", 0x01, 0x00, false},
+    {"cmovnge", 0x01, 0x01, false},
+    {"cmovnge", 0x00, 0x01, true},
+    {"cmovnge", INT64_MIN, 0x01, true},
+    {"cmovnl", 0x01, 0x00, true},
+    {"cmovnl", 0x01, 0x01, true},
+    {"cmovnl", 0x00, 0x01, false},
+    {"cmovnl", INT64_MIN, 0x01, false},
+    {"cmovnle", 0x01, 0x00, true},
+    {"cmovnle", 0x01, 0x01, false},
+    {"cmovnle", 0x00, 0x01, false},
+    {"cmovnle", INT64_MIN, 0x01, false},
+    {"cmovno", 0x01, 0x00, true},
+    {"cmovno", 0x01, 0x01, true},
+    {"cmovno", 0x00, 0x01, true},
+    {"cmovno", INT64_MIN, 0x01, false},
+    {"cmovnp", 0x01, 0x00, true},
+    {"cmovnp", 0x01, 0x01, false},
+    {"cmovnp", 0x00, 0x01, false},
+    {"cmovnp", INT64_MIN, 0x01, false},
+    {"cmovns", 0x01, 0x00, true},
+    {"cmovns", 0x01, 0x01, true},
+    {"cmovns", 0x00, 0x01, false},
+    {"cmovns", INT64_MIN, 0x01, true},
+    {"cmovnz", 0x01, 0x00, true},
+    {"cmovnz", 0x01, 0x01, false},
+    {"cmovnz", 0x00, 0x01, true},
+    {"cmovnz", INT64_MIN, 0x01, true},
+    {"cmovo", 0x01, 0x00, false},
+    {"cmovo", 0x01, 0x01, false},
+    {"cmovo", 0x00, 0x01, false},
+    {"cmovo", INT64_MIN, 0x01, true},
+    {"cmovp", 0x01, 0x00, false},
+    {"cmovp", 0x01, 0x01, true},
+    {"cmovp", 0x00, 0x01, true},
+    {"cmovp", INT64_MIN, 0x01, true},
+    {"cmovpe", 0x01, 0x00, false},
+    {"cmovpe", 0x01, 0x01, true},
+    {"cmovpe", 0x00, 0x01, true},
+    {"cmovpe", INT64_MIN, 0x01, true},
+    {"cmovpo", 0x01, 0x00, true},
+    {"cmovpo", 0x01, 0x01, false},
+    {"cmovpo", 0x00, 0x01, false},
+    {"cmovpo", INT64_MIN, 0x01, false},
+    {"cmovs", 0x01, 0x00, false},
+    {"cmovs", 0x01, 0x01, false},
+    {"cmovs", 0x00, 0x01, true},
+    {"cmovs", INT64_MIN, 0x01, false},
+    {"cmovz", 0x01, 0x00, false},
+    {"cmovz", 0x01, 0x01, true},
+    {"cmovz", 0x00, 0x01, false},
+    {"cmovz", INT64_MIN, 0x01, false},
+};
+static const size_t CMOV_INFO_LIST_SIZE = sizeof(cmov_info_list) / sizeof(cmov_info_list[0]);
+
+
+static void generate_test_case_cmov_reg_reg(FILE *fp, const CmovInfo *cmov_info, const RegisterInfo *reg1_info, const RegisterInfo *reg2_info)
+{
+    static const uintmax_t initial = 1;
+    static const uintmax_t moved = 2;
+    size_t size = reg1_info->size;
+    size_t index_list[] = {reg1_info->index, reg2_info->index};
+    const char *reg1 = reg1_info->name;
+    const char *reg2 = reg2_info->name;
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+
+    const char *work_reg = generate_save_register(fp, index_list, sizeof(index_list) / sizeof(index_list[0]));
+    put_line_with_tab(fp, "mov r8, 0x%llx", cmov_info->lhs);
+    put_line_with_tab(fp, "mov r9, 0x%llx", cmov_info->rhs);
+    put_line_with_tab(fp, "cmp r8, r9");
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg1, initial);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg2, moved);
+    put_line_with_tab(fp, "%s %s, %s    # test target", cmov_info->mnemonic, reg1, reg2);
+    put_line_with_tab(fp, "mov %s, %s", arg2, reg1);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, cmov_info->result ? moved : initial);
+    generate_restore_register(fp, work_reg);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_test_case_cmov_reg_mem(FILE *fp, const CmovInfo *cmov_info, size_t size)
+{
+    static const uintmax_t initial = 1;
+    static const uintmax_t moved = 2;
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov r8, 0x%llx", cmov_info->lhs);
+    put_line_with_tab(fp, "mov r9, 0x%llx", cmov_info->rhs);
+    put_line_with_tab(fp, "cmp r8, r9");
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg2, initial);
+    put_line_with_tab(fp, "mov %s [rbp-8], 0x%llx", size_spec, moved);
+    put_line_with_tab(fp, "%s %s, %s [rbp-8]    # test target", cmov_info->mnemonic, arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, cmov_info->result ? moved : initial);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_all_test_case_cmov(FILE *fp)
+{
+    // <mnemonic> reg, reg
+    for(size_t i = 0; i < REG_LIST_SIZE; i++)
+    {
+        const RegisterInfo *reg1_info = &reg_list[i];
+        if(reg1_info->size > sizeof(uint8_t))
+        {
+            const RegisterInfo *reg2_info = &reg_list[(i % 16 == 15) ? (i - 15) : (i + 1)];
+            for(size_t k = 0; k < CMOV_INFO_LIST_SIZE; k++)
+            {
+                const CmovInfo *cmov_info = &cmov_info_list[k];
+                generate_test_case_cmov_reg_reg(fp, cmov_info, reg1_info, reg2_info);
+                put_line(fp, "");
+            }
+        }
+    }
+
+    // <mnemonic> reg, mem
+    for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+    {
+        size_t size = imm_list[j].size;
+        if(size > sizeof(uint8_t))
+        {
+            for(size_t k = 0; k < CMOV_INFO_LIST_SIZE; k++)
+            {
+                const CmovInfo *cmov_info = &cmov_info_list[k];
+                generate_test_case_cmov_reg_mem(fp, cmov_info, size);
+                put_line(fp, "");
+            }
+        }
+    }
+}
+
+
+void generate_test_cmov(void)
+{
+    generate_test("test/test_cmov.s", STACK_ALIGNMENT, generate_all_test_case_cmov);
+}
@@ -0,0 +1,131 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+
+static uintmax_t get_mask(size_t size)
+{
+    return ((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1;
+}
+
+
+static void generate_test_case_cmpxchg_assert(FILE *fp, size_t size, const char *destination, uintmax_t expected_destination, uintmax_t expected_accumulator, bool equal)
+{
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov %s, %s", arg2, destination);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, expected_destination);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov %s, %s [rbp-24]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, expected_accumulator);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov sil, byte ptr [rbp-16]");
+    put_line_with_tab(fp, "mov dil, 0x%x", equal ? 1 : 0);
+    put_line_with_tab(fp, "call assert_equal_uint8");
+}
+
+
+static void generate_test_case_cmpxchg(FILE *fp, size_t size, uintmax_t destination, uintmax_t accumulator, uintmax_t source, bool memory, bool lock)
+{
+    const char *acc = get_register_by_index_and_size(REGISTER_INDEX_EAX, size);
+    const char *reg_source = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+    const char *reg_destination = get_register_by_index_and_size(REGISTER_INDEX_R9D, size);
+    const char *size_spec = get_size_specifier(size);
+    bool equal = (destination == accumulator);
+    char memory_destination[32];
+    snprintf(memory_destination, sizeof(memory_destination), "%s [rbp-8]", size_spec);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg_destination, destination);
+    put_line_with_tab(fp, "mov %s, 0x%llx", acc, accumulator);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg_source, source);
+    if(memory)
+    {
+        put_line_with_tab(fp, "mov %s, %s", memory_destination, reg_destination);
+        put_line_with_tab(fp, "%scmpxchg %s, %s    # test target", lock ? "lock " : "", memory_destination, reg_source);
+    }
+    else
+    {
+        put_line_with_tab(fp, "cmpxchg %s, %s    # test target", reg_destination, reg_source);
+        put_line_with_tab(fp, "mov %s, %s", memory_destination, reg_destination);
+    }
+    put_line_with_tab(fp, "setz byte ptr [rbp-16]");
+    put_line_with_tab(fp, "mov %s [rbp-24], %s", size_spec, acc);
+    generate_test_case_cmpxchg_assert(fp, size, memory_destination, equal ? source : destination, equal ? accumulator : destination, equal);
+}
+
+
+static void generate_test_case_cmpxchg16b(FILE *fp, uintmax_t low, uintmax_t high, bool equal, bool lock)
+{
+    static const uintmax_t new_low = 0x0123456789abcdef;
+    static const uintmax_t new_high = 0x7edcba9876543210;
+
+    put_line_with_tab(fp, "mov rax, 0x%llx", low);
+    put_line_with_tab(fp, "mov qword ptr [rbp-48], rax");
+    put_line_with_tab(fp, "mov rdx, 0x%llx", high);
+    put_line_with_tab(fp, "mov qword ptr [rbp-40], rdx");
+    if(!equal)
+    {
+        put_line_with_tab(fp, "add rdx, 1");
+    }
+    put_line_with_tab(fp, "mov rbx, 0x%llx", new_low);
+    put_line_with_tab(fp, "mov rcx, 0x%llx", new_high);
+    put_line_with_tab(fp, "%scmpxchg16b xmmword ptr [rbp-48]    # test target", lock ? "lock " : "");
+    put_line_with_tab(fp, "setz byte ptr [rbp-16]");
+    put_line_with_tab(fp, "mov qword ptr [rbp-24], rdx");
+    put_line_with_tab(fp, "mov rsi, qword ptr [rbp-48]");
+    put_line_with_tab(fp, "mov rdi, 0x%llx", equal ? new_low : low);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+    put_line_with_tab(fp, "mov rsi, qword ptr [rbp-40]");
+    put_line_with_tab(fp, "mov rdi, 0x%llx", equal ? new_high : high);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+    put_line_with_tab(fp, "mov rsi, qword ptr [rbp-24]");
+    put_line_with_tab(fp, "mov rdi, 0x%llx", high);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+    put_line_with_tab(fp, "mov sil, byte ptr [rbp-16]");
+    put_line_with_tab(fp, "mov dil, 0x%x", equal ? 1 : 0);
+    put_line_with_tab(fp, "call assert_equal_uint8");
+}
+
+
+static void generate_all_test_case_cmpxchg(FILE *fp)
+{
+    // cmpxchg reg, reg and cmpxchg mem, reg
+    for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+    {
+        size_t size = imm_list[j].size;
+        uintmax_t value = 0x0123456789abcdef & get_mask(size);
+        uintmax_t source = 0x7edcba9876543210 & get_mask(size);
+        for(size_t k = 0; k < 2; k++)
+        {
+            bool memory = (k == 1);
+            generate_test_case_cmpxchg(fp, size, value, value, source, memory, false);
+            put_line(fp, "");
+            generate_test_case_cmpxchg(fp, size, value, value - 1, source, memory, false);
+            put_line(fp, "");
+        }
+        generate_test_case_cmpxchg(fp, size, value, value, source, true, true);
+        put_line(fp, "");
+        generate_test_case_cmpxchg(fp, size, value, value + 1, source, true, true);
+        put_line(fp, "");
+    }
+
+    // cmpxchg16b mem
+    generate_test_case_cmpxchg16b(fp, 0x1122334455667788, 0x1234567812345678, true, false);
+    put_line(fp, "");
+    generate_test_case_cmpxchg16b(fp, 0x1122334455667788, 0x1234567812345678, false, false);
+    put_line(fp, "");
+    generate_test_case_cmpxchg16b(fp, 0x1122334455667788, 0x1234567812345678, true, true);
+    put_line(fp, "");
+    generate_test_case_cmpxchg16b(fp, 0x1122334455667788, 0x1234567812345678, false, true);
+    put_line(fp, "");
+}
+
+
+void generate_test_cmpxchg(void)
+{
+    generate_test("test/test_cmpxchg.s", 3 * STACK_ALIGNMENT, generate_all_test_case_cmpxchg);
+}
@@ -0,0 +1,303 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_common.h"
+
+#define ENCODING_SIZE_MAX    16
+
+typedef struct EncodingVariant EncodingVariant;
+typedef struct InstructionSpec InstructionSpec;
+
+// prefixes of instruction encoding
+enum
+{
+    EP_NONE  = 0x00,
+    EP_66    = 0x01,
+    EP_F2    = 0x02,
+    EP_F3    = 0x04,
+    EP_REX_W = 0x08,
+};
+
+// role of ModR/M byte
+enum
+{
+    MR_0,
+    MR_1,
+    MR_2,
+    MR_3,
+    MR_4,
+    MR_5,
+    MR_6,
+    MR_7,
+    MR_REG,
+    MR_NONE,
+};
+
+struct InstructionSpec
+{
+    const char *mnemonic;
+    size_t operand_number;
+    const char *operand_patterns[2];
+    uint8_t prefixes;
+    uint32_t opecode;
+    uint8_t modrm;
+    size_t imm_size;
+};
+
+struct EncodingVariant
+{
+    size_t reg_index; // index of register in reg field
+    size_t rm_index;  // index of register or base register in r/m field
+    bool rm_memory;   // flag indicating that r/m field specifies memory
+    int32_t disp;     // displacement of memory
+};
+
+#include "test_instruction_table.h"
+
+static const EncodingVariant encoding_variant_list[] =
+{
+    {REGISTER_INDEX_ECX, REGISTER_INDEX_EDX, false, 0},
+    {REGISTER_INDEX_R10D, REGISTER_INDEX_R9D, false, 0},
+    {REGISTER_INDEX_ECX, REGISTER_INDEX_EBP, true, -16},
+    {REGISTER_INDEX_R10D, REGISTER_INDEX_R9D, true, 0x100},
+};
+static const size_t ENCODING_VARIANT_LIST_SIZE = sizeof(encoding_variant_list) / sizeof(encoding_variant_list[0]);
+
+static const uint8_t IMMEDIATE_VALUE = 0x05;
+
+
+static bool is_register_pattern(const char *pattern)
+{
+    return (pattern[0] == 'r') && (pattern[1] != '/');
+}
+
+
+static bool is_memory_pattern(const char *pattern)
+{
+    return pattern[0] == 'm';
+}
+
+
+static bool is_immediate_pattern(const char *pattern)
+{
+    return strncmp(pattern, "imm", strlen("imm")) == 0;
+}
+
+
+static size_t get_pattern_size(const char *pattern)
+{
+    return strtoul(&pattern[strcspn(pattern, "0123456789")], NULL, 10) / 8;
+}
+
+
+static size_t append_byte(uint8_t byte, uint8_t *bytes, size_t size)
+{
+    bytes[size] = byte;
+    return size + 1;
+}
+
+
+static size_t encode_instruction(const InstructionSpec *spec, const EncodingVariant *variant, uint8_t *bytes)
+{
+    size_t size = 0;
+    bool has_rm = false;
+    for(size_t i = 0; i < spec->operand_number; i++)
+    {
+        const char *pattern = spec->operand_patterns[i];
+        has_rm = has_rm || (!is_register_pattern(pattern) && !is_immediate_pattern(pattern));
+    }
+
+    // prefixes
+    if(spec->prefixes & EP_66)
+    {
+        size = append_byte(0x66, bytes, size);
+    }
+    if(spec->prefixes & EP_F2)
+    {
+        size = append_byte(0xf2, bytes, size);
+    }
+    if(spec->prefixes & EP_F3)
+    {
+        size = append_byte(0xf3, bytes, size);
+    }
+    uint8_t rex = (spec->prefixes & EP_REX_W) ? 0x48 : 0x00;
+    if((spec->modrm == MR_REG) && (variant->reg_index >= 8))
+    {
+        rex |= 0x44;
+    }
+    if(has_rm && (variant->rm_index >= 8))
+    {
+        rex |= 0x41;
+    }
+    if(rex != 0x00)
+    {
+        size = append_byte(rex, bytes, size);
+    }
+
+    // opecode
+    for(int shift = 16; shift > 0; shift -= 8)
+    {
+        uint8_t byte = (spec->opecode >> shift) & 0xff;
+        if(byte != 0x00)
+        {
+            size = append_byte(byte, bytes, size);
+        }
+    }
+    size = append_byte(spec->opecode & 0xff, bytes, size);
+
+    // ModR/M byte and displacement
+    if(spec->modrm != MR_NONE)
+    {
+        uint8_t reg = (spec->modrm == MR_REG) ? (variant->reg_index & 0x07) : spec->modrm;
+        uint8_t rm = variant->rm_index & 0x07;
+        if(!variant->rm_memory)
+        {
+            size = append_byte(0xc0 | (reg << 3) | rm, bytes, size);
+        }
+        else if((INT8_MIN <= variant->disp) && (variant->disp <= INT8_MAX))
+        {
+            size = append_byte(0x40 | (reg << 3) | rm, bytes, size);
+            size = append_byte(variant->disp & 0xff, bytes, size);
+        }
+        else
+        {
+            size = append_byte(0x80 | (reg << 3) | rm, bytes, size);
+            for(size_t i = 0; i < sizeof(variant->disp); i++)
+            {
+                size = append_byte((variant->disp >> (8 * i)) & 0xff, bytes, size);
+            }
+        }
+    }
+
+    // immediate
+    for(size_t i = 0; i < spec->imm_size; i++)
+    {
+        size = append_byte((i == 0) ? IMMEDIATE_VALUE : 0x00, bytes, size);
+    }
+
+    return size;
+}
+
+
+static void format_operand(const char *pattern, const EncodingVariant *variant, char *operand)
+{
+    size_t size = get_pattern_size(pattern);
+    if(is_immediate_pattern(pattern))
+    {
+        sprintf(operand, "0x%x", IMMEDIATE_VALUE);
+    }
+    else if(is_register_pattern(pattern))
+    {
+        sprintf(operand, "%s", get_register_by_index_and_size(variant->reg_index, size));
+    }
+    else if(variant->rm_memory)
+    {
+        const char *size_spec = (size == 2 * sizeof(uint64_t)) ? "xmmword ptr" : get_size_specifier(size);
+        const char *base = get_register_by_index_and_size(variant->rm_index, sizeof(uint64_t));
+        sprintf(operand, "%s [%s%+d]", size_spec, base, variant->disp);
+    }
+    else
+    {
+        sprintf(operand, "%s", get_register_by_index_and_size(variant->rm_index, size));
+    }
+}
+
+
+static bool is_applicable_variant(const InstructionSpec *spec, const EncodingVariant *variant)
+{
+    for(size_t i = 0; i < spec->operand_number; i++)
+    {
+        if(is_memory_pattern(spec->operand_patterns[i]) && !variant->rm_memory)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static void generate_test_case_encoding(FILE *fp, size_t id, const InstructionSpec *spec, const EncodingVariant *variant)
+{
+    char operands[2][64] = {"", ""};
+    for(size_t i = 0; i < spec->operand_number; i++)
+    {
+        format_operand(spec->operand_patterns[i], variant, operands[i]);
+    }
+
+    uint8_t bytes[ENCODING_SIZE_MAX];
+    size_t size = encode_instruction(spec, variant, bytes);
+
+    put_line_with_tab(fp, ".data");
+    put_line(fp, "test_encoding_expected_%zu:", id);
+    for(size_t i = 0; i < size; i++)
+    {
+        put_line_with_tab(fp, ".byte 0x%02x", bytes[i]);
+    }
+    put_line_with_tab(fp, ".text");
+
+    // the instruction under test is skipped over since only its encoding is checked
+    put_line_with_tab(fp, "jmp test_encoding_end_%zu", id);
+    put_line(fp, "test_encoding_%zu:", id);
+    switch(spec->operand_number)
+    {
+    case 0:
+        put_line_with_tab(fp, "%s    # test target", spec->mnemonic);
+        break;
+
+    case 1:
+        put_line_with_tab(fp, "%s %s    # test target", spec->mnemonic, operands[0]);
+        break;
+
+    default:
+        put_line_with_tab(fp, "%s %s, %s    # test target", spec->mnemonic, operands[0], operands[1]);
+        break;
+    }
+    put_line(fp, "test_encoding_end_%zu:", id);
+
+    // compare encoding with the expected bytes
+    put_line_with_tab(fp, "lea rsi, qword ptr [rip+test_encoding_%zu]", id);
+    put_line_with_tab(fp, "lea rdi, qword ptr [rip+test_encoding_expected_%zu]", id);
+    put_line_with_tab(fp, "mov rcx, %zu", size);
+    put_line_with_tab(fp, "repe cmpsb");
+    put_line_with_tab(fp, "setz byte ptr [rbp-8]");
+    put_line_with_tab(fp, "lea rsi, qword ptr [rip+test_encoding_end_%zu]", id);
+    put_line_with_tab(fp, "lea rax, qword ptr [rip+test_encoding_%zu]", id);
+    put_line_with_tab(fp, "sub rsi, rax");
+    put_line_with_tab(fp, "mov rdi, %zu", size);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+    put_line_with_tab(fp, "mov sil, byte ptr [rbp-8]");
+    put_line_with_tab(fp, "mov dil, 1");
+    put_line_with_tab(fp, "call assert_equal_uint8");
+}
+
+
+static void generate_all_test_case_encoding(FILE *fp)
+{
+    size_t id = 0;
+    for(size_t i = 0; i < sizeof(instruction_spec_list) / sizeof(instruction_spec_list[0]); i++)
+    {
+        const InstructionSpec *spec = &instruction_spec_list[i];
+        size_t variant_number = (spec->modrm == MR_NONE) ? 1 : ENCODING_VARIANT_LIST_SIZE;
+        for(size_t j = 0; j < variant_number; j++)
+        {
+            const EncodingVariant *variant = &encoding_variant_list[j];
+            if(is_applicable_variant(spec, variant))
+            {
+                generate_test_case_encoding(fp, id, spec, variant);
+                put_line(fp, "");
+                id++;
+            }
+        }
+    }
+}
+
+
+void generate_test_encoding(void)
+{
+    generate_test("test/test_encoding.s", STACK_ALIGNMENT, generate_all_test_case_encoding);
+}
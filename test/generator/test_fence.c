@@ -0,0 +1,34 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+
+static void generate_test_case_fence(FILE *fp, const char *mnemonic, uintmax_t value)
+{
+    put_line_with_tab(fp, "mov rax, 0x%llx", value);
+    put_line_with_tab(fp, "mov qword ptr [rbp-8], rax");
+    put_line_with_tab(fp, "%s    # test target", mnemonic);
+    put_line_with_tab(fp, "mov rsi, qword ptr [rbp-8]");
+    put_line_with_tab(fp, "mov rdi, 0x%llx", value);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+}
+
+
+static void generate_all_test_case_fence(FILE *fp)
+{
+    static const char *mnemonic_list[] = {"lfence", "mfence", "pause", "sfence"};
+    static const size_t MNEMONIC_LIST_SIZE = sizeof(mnemonic_list) / sizeof(mnemonic_list[0]);
+
+    for(size_t i = 0; i < MNEMONIC_LIST_SIZE; i++)
+    {
+        generate_test_case_fence(fp, mnemonic_list[i], 0x0123456789abcdef + i);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_fence(void)
+{
+    generate_test("test/test_fence.s", STACK_ALIGNMENT, generate_all_test_case_fence);
+}
@@ -6,15 +6,31 @@ static void (* const generate_test[])(void) =
 {
     generate_test_add,
     generate_test_and,
+    generate_test_bmi,
+    generate_test_bsf,
+    generate_test_bsr,
+    generate_test_bt,
+    generate_test_btc,
+    generate_test_btr,
+    generate_test_bts,
     generate_test_call,
+    generate_test_cmov,
     generate_test_cmp,
+    generate_test_cmps,
+    generate_test_cmpxchg,
     generate_test_convert,
+    generate_test_encoding,
+    generate_test_fence,
     generate_test_idiv,
     generate_test_imul,
     generate_test_jcc,
     generate_test_jmp,
     generate_test_lea,
+    generate_test_lock,
+    generate_test_lods,
+    generate_test_lzcnt,
     generate_test_mov,
+    generate_test_movs,
     generate_test_movsx,
     generate_test_movzx,
     generate_test_neg,
@@ -22,13 +38,19 @@ static void (* const generate_test[])(void) =
     generate_test_not,
     generate_test_or,
     generate_test_pop,
+    generate_test_popcnt,
     generate_test_push,
     generate_test_sal,
     generate_test_sar,
+    generate_test_scas,
     generate_test_set,
     generate_test_shl,
     generate_test_shr,
+    generate_test_stos,
     generate_test_sub,
+    generate_test_tzcnt,
+    generate_test_xadd,
+    generate_test_xchg,
     generate_test_xor,
 };
 static const size_t GENERATE_TEST_SIZE = sizeof(generate_test) / sizeof(generate_test[0]);
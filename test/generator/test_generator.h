@@ -3,15 +3,31 @@
 
 void generate_test_add(void);
 void generate_test_and(void);
+void generate_test_bmi(void);
+void generate_test_bsf(void);
+void generate_test_bsr(void);
+void generate_test_bt(void);
+void generate_test_btc(void);
+void generate_test_btr(void);
+void generate_test_bts(void);
 void generate_test_call(void);
+void generate_test_cmov(void);
 void generate_test_cmp(void);
+void generate_test_cmps(void);
+void generate_test_cmpxchg(void);
 void generate_test_convert(void);
+void generate_test_encoding(void);
+void generate_test_fence(void);
 void generate_test_idiv(void);
 void generate_test_imul(void);
 void generate_test_jcc(void);
 void generate_test_jmp(void);
 void generate_test_lea(void);
+void generate_test_lock(void);
+void generate_test_lods(void);
+void generate_test_lzcnt(void);
 void generate_test_mov(void);
+void generate_test_movs(void);
 void generate_test_movsx(void);
 void generate_test_movzx(void);
 void generate_test_neg(void);
@@ -19,13 +35,19 @@ void generate_test_nop(void);
 void generate_test_not(void);
 void generate_test_or(void);
 void generate_test_pop(void);
+void generate_test_popcnt(void);
 void generate_test_push(void);
 void generate_test_sal(void);
 void generate_test_sar(void);
+void generate_test_scas(void);
 void generate_test_set(void);
 void generate_test_shl(void);
 void generate_test_shr(void);
+void generate_test_stos(void);
 void generate_test_sub(void);
+void generate_test_tzcnt(void);
+void generate_test_xadd(void);
+void generate_test_xchg(void);
 void generate_test_xor(void);
 
 #endif /* TEST_GENERATOR_H */
@@ -5,6 +5,7 @@
 #include "test_common.h"
 
 typedef struct JccInfo JccInfo;
+typedef struct JcxzInfo JcxzInfo;
 
 struct JccInfo
 {
@@ -14,59 +15,147 @@ struct JccInfo
     bool result;
 };
 
+struct JcxzInfo
+{
+    const char *mnemonic;
+    uintmax_t rcx;
+    bool result;
+};
+
 static const JccInfo jcc_info_list[] =
 {
     {"ja", 0x01, 0x00, true},
     {"ja", 0x01, 0x01, false},
     {"ja", 0x00, 0x01, false},
+    {"ja", INT64_MIN, 0x01, true},
+    {"jae", 0x01, 0x00, true},
+    {"jae", 0x01, 0x01, true},
+    {"jae", 0x00, 0x01, false},
+    {"jae", INT64_MIN, 0x01, true},
     {"jb", 0x01, 0x00, false},
     {"jb", 0x01, 0x01, false},
     {"jb", 0x00, 0x01, true},
+    {"jb", INT64_MIN, 0x01, false},
     {"jbe", 0x01, 0x00, false},
     {"jbe", 0x01, 0x01, true},
     {"jbe", 0x00, 0x01, true},
+    {"jbe", INT64_MIN, 0x01, false},
+    {"jc", 0x01, 0x00, false},
+    {"jc", 0x01, 0x01, false},
+    {"jc", 0x00, 0x01, true},
+    {"jc", INT64_MIN, 0x01, false},
     {"je", 0x01, 0x00, false},
     {"je", 0x01, 0x01, true},
     {"je", 0x00, 0x01, false},
+    {"je", INT64_MIN, 0x01, false},
     {"jg", 0x01, 0x00, true},
     {"jg", 0x01, 0x01, false},
     {"jg", 0x00, 0x01, false},
+    {"jg", INT64_MIN, 0x01, false},
     {"jge", 0x01, 0x00, true},
     {"jge", 0x01, 0x01, true},
     {"jge", 0x00, 0x01, false},
+    {"jge", INT64_MIN, 0x01, false},
     {"jl", 0x01, 0x00, false},
     {"jl", 0x01, 0x01, false},
     {"jl", 0x00, 0x01, true},
+    {"jl", INT64_MIN, 0x01, true},
     {"jle", 0x01, 0x00, false},
     {"jle", 0x01, 0x01, true},
     {"jle", 0x00, 0x01, true},
+    {"jle", INT64_MIN, 0x01, true},
     {"jna", 0x01, 0x00, false},
     {"jna", 0x01, 0x01, true},
     {"jna", 0x00, 0x01, true},
+    {"jna", INT64_MIN, 0x01, false},
     {"jnae", 0x01, 0x00, false},
     {"jnae", 0x01, 0x01, false},
     {"jnae", 0x00, 0x01, true},
+    {"jnae", INT64_MIN, 0x01, false},
+    {"jnb", 0x01, 0x00, true},
+    {"jnb", 0x01, 0x01, true},
+    {"jnb", 0x00, 0x01, false},
+    {"jnb", INT64_MIN, 0x01, true},
     {"jnbe", 0x01, 0x00, true},
     {"jnbe", 0x01, 0x01, false},
     {"jnbe", 0x00, 0x01, false},
+    {"jnbe", INT64_MIN, 0x01, true},
+    {"jnc", 0x01, 0x00, true},
+    {"jnc", 0x01, 0x01, true},
+    {"jnc", 0x00, 0x01, false},
+    {"jnc", INT64_MIN, 0x01, true},
     {"jne", 0x01, 0x00, true},
     {"jne", 0x01, 0x01, false},
     {"jne", 0x00, 0x01, true},
+    {"jne", INT64_MIN, 0x01, true},
     {"jng", 0x01, 0x00, false},
     {"jng", 0x01, 0x01, true},
     {"jng", 0x00, 0x01, true},
+    {"jng", INT64_MIN, 0x01, true},
     {"jnge", 0x01, 0x00, false},
     {"jnge", 0x01, 0x01, false},
     {"jnge", 0x00, 0x01, true},
+    {"jnge", INT64_MIN, 0x01, true},
     {"jnl", 0x01, 0x00, true},
     {"jnl", 0x01, 0x01, true},
     {"jnl", 0x00, 0x01, false},
+    {"jnl", INT64_MIN, 0x01, false},
     {"jnle", 0x01, 0x00, true},
     {"jnle", 0x01, 0x01, false},
     {"jnle", 0x00, 0x01, false},
+    {"jnle", INT64_MIN, 0x01, false},
+    {"jno", 0x01, 0x00, true},
+    {"jno", 0x01, 0x01, true},
+    {"jno", 0x00, 0x01, true},
+    {"jno", INT64_MIN, 0x01, false},
+    {"jnp", 0x01, 0x00, true},
+    {"jnp", 0x01, 0x01, false},
+    {"jnp", 0x00, 0x01, false},
+    {"jnp", INT64_MIN, 0x01, false},
+    {"jns", 0x01, 0x00, true},
+    {"jns", 0x01, 0x01, true},
+    {"jns", 0x00, 0x01, false},
+    {"jns", INT64_MIN, 0x01, true},
+    {"jnz", 0x01, 0x00, true},
+    {"jnz", 0x01, 0x01, false},
+    {"jnz", 0x00, 0x01, true},
+    {"jnz", INT64_MIN, 0x01, true},
+    {"jo", 0x01, 0x00, false},
+    {"jo", 0x01, 0x01, false},
+    {"jo", 0x00, 0x01, false},
+    {"jo", INT64_MIN, 0x01, true},
+    {"jp", 0x01, 0x00, false},
+    {"jp", 0x01, 0x01, true},
+    {"jp", 0x00, 0x01, true},
+    {"jp", INT64_MIN, 0x01, true},
+    {"jpe", 0x01, 0x00, false},
+    {"jpe", 0x01, 0x01, true},
+    {"jpe", 0x00, 0x01, true},
+    {"jpe", INT64_MIN, 0x01, true},
+    {"jpo", 0x01, 0x00, true},
+    {"jpo", 0x01, 0x01, false},
+    {"jpo", 0x00, 0x01, false},
+    {"jpo", INT64_MIN, 0x01, false},
+    {"js", 0x01, 0x00, false},
+    {"js", 0x01, 0x01, false},
+    {"js", 0x00, 0x01, true},
+    {"js", INT64_MIN, 0x01, false},
+    {"jz", 0x01, 0x00, false},
+    {"jz", 0x01, 0x01, true},
+    {"jz", 0x00, 0x01, false},
+    {"jz", INT64_MIN, 0x01, false},
 };
 static const size_t JCC_INFO_LIST_SIZE = sizeof(jcc_info_list) / sizeof(jcc_info_list[0]);
 
+static const JcxzInfo jcxz_info_list[] =
+{
+    {"jecxz", 0x100000000, true},
+    {"jecxz", 0x000000001, false},
+    {"jrcxz", 0x000000000, true},
+    {"jrcxz", 0x100000000, false},
+};
+static const size_t JCXZ_INFO_LIST_SIZE = sizeof(jcxz_info_list) / sizeof(jcxz_info_list[0]);
+
 
 static size_t get_jmp_dest_index(void)
 {
@@ -84,8 +173,8 @@ static void generate_test_case_jcc_rel(FILE *fp, size_t rel_size, const JccInfo
 
     put_line_with_tab(fp, "mov rdi, 0x%llu", expected);
     put_line_with_tab(fp, "mov rsi, 0x%llu", jcc_info->result ? wrong : expected);
-    put_line_with_tab(fp, "mov rax, 0x%llu", jcc_info->lhs);
-    put_line_with_tab(fp, "mov rcx, 0x%llu", jcc_info->rhs);
+    put_line_with_tab(fp, "mov rax, 0x%llx", jcc_info->lhs);
+    put_line_with_tab(fp, "mov rcx, 0x%llx", jcc_info->rhs);
     put_line_with_tab(fp, "cmp rax, rcx");
     put_line_with_tab(fp, "%s jmp_dest_%lu    # test target", jcc_info->mnemonic, index);
     put_line_with_tab(fp, "call assert_equal_uint64");
@@ -103,6 +192,31 @@ static void generate_test_case_jcc_rel(FILE *fp, size_t rel_size, const JccInfo
 }
 
 
+static void generate_test_case_jcxz_rel(FILE *fp, size_t rel_size, const JcxzInfo *jcxz_info)
+{
+    static const uint64_t expected = 1;
+    static const uint64_t wrong = 2;
+    const size_t index = get_jmp_dest_index();
+
+    put_line_with_tab(fp, "mov rdi, 0x%llx", expected);
+    put_line_with_tab(fp, "mov rsi, 0x%llx", jcxz_info->result ? wrong : expected);
+    put_line_with_tab(fp, "mov rcx, 0x%llx", jcxz_info->rcx);
+    put_line_with_tab(fp, "%s jmp_dest_%lu    # test target", jcxz_info->mnemonic, index);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+    put_line_with_tab(fp, "jmp jmp_end_%lu", index);
+    // adjust offset
+    for(size_t i = 0; i < rel_size; i++)
+    {
+        put_line_with_tab(fp, "nop");
+    }
+    put_line(fp, "jmp_dest_%lu:", index);
+    put_line_with_tab(fp, "mov rdi, 0x%llx", expected);
+    put_line_with_tab(fp, "mov rsi, 0x%llx", jcxz_info->result ? expected : wrong);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+    put_line(fp, "jmp_end_%lu:", index);
+}
+
+
 static void generate_all_test_case_jcc(FILE *fp)
 {
     // <mnemonic> rel
@@ -113,6 +227,15 @@ static void generate_all_test_case_jcc(FILE *fp)
         generate_test_case_jcc_rel(fp, rel_size, jcc_info);
         put_line(fp, "");
     }
+
+    // <mnemonic> rel8
+    for(size_t i = 0; i < JCXZ_INFO_LIST_SIZE; i++)
+    {
+        size_t rel_size = 64;
+        const JcxzInfo *jcxz_info = &jcxz_info_list[i];
+        generate_test_case_jcxz_rel(fp, rel_size, jcxz_info);
+        put_line(fp, "");
+    }
 }
 
 
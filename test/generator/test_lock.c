@@ -0,0 +1,163 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+typedef enum
+{
+    LOCK_FORM_MEM,     // lock <mnemonic> mem
+    LOCK_FORM_MEM_IMM, // lock <mnemonic> mem, imm
+    LOCK_FORM_MEM_REG, // lock <mnemonic> mem, reg
+} LockOperationForm;
+
+typedef struct LockInfo LockInfo;
+
+struct LockInfo
+{
+    const char *mnemonic;
+    LockOperationForm form;
+    size_t min_size;
+    uintmax_t (*operate)(uintmax_t, uintmax_t);
+};
+
+
+static uintmax_t operate_add(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs + rhs;
+}
+
+
+static uintmax_t operate_and(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs & rhs;
+}
+
+
+static uintmax_t operate_btc(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs ^ ((uintmax_t)1 << rhs);
+}
+
+
+static uintmax_t operate_btr(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs & ~((uintmax_t)1 << rhs);
+}
+
+
+static uintmax_t operate_bts(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs | ((uintmax_t)1 << rhs);
+}
+
+
+static uintmax_t operate_neg(uintmax_t lhs, uintmax_t rhs)
+{
+    return -lhs;
+}
+
+
+static uintmax_t operate_not(uintmax_t lhs, uintmax_t rhs)
+{
+    return ~lhs;
+}
+
+
+static uintmax_t operate_or(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs | rhs;
+}
+
+
+static uintmax_t operate_sub(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs - rhs;
+}
+
+
+static uintmax_t operate_xor(uintmax_t lhs, uintmax_t rhs)
+{
+    return lhs ^ rhs;
+}
+
+
+static const LockInfo lock_info_list[] =
+{
+    {"add", LOCK_FORM_MEM_IMM, sizeof(uint8_t),  operate_add},
+    {"add", LOCK_FORM_MEM_REG, sizeof(uint8_t),  operate_add},
+    {"and", LOCK_FORM_MEM_IMM, sizeof(uint8_t),  operate_and},
+    {"and", LOCK_FORM_MEM_REG, sizeof(uint8_t),  operate_and},
+    {"btc", LOCK_FORM_MEM_IMM, sizeof(uint16_t), operate_btc},
+    {"btc", LOCK_FORM_MEM_REG, sizeof(uint16_t), operate_btc},
+    {"btr", LOCK_FORM_MEM_IMM, sizeof(uint16_t), operate_btr},
+    {"btr", LOCK_FORM_MEM_REG, sizeof(uint16_t), operate_btr},
+    {"bts", LOCK_FORM_MEM_IMM, sizeof(uint16_t), operate_bts},
+    {"bts", LOCK_FORM_MEM_REG, sizeof(uint16_t), operate_bts},
+    {"neg", LOCK_FORM_MEM,     sizeof(uint8_t),  operate_neg},
+    {"not", LOCK_FORM_MEM,     sizeof(uint8_t),  operate_not},
+    {"or",  LOCK_FORM_MEM_IMM, sizeof(uint8_t),  operate_or},
+    {"or",  LOCK_FORM_MEM_REG, sizeof(uint8_t),  operate_or},
+    {"sub", LOCK_FORM_MEM_IMM, sizeof(uint8_t),  operate_sub},
+    {"sub", LOCK_FORM_MEM_REG, sizeof(uint8_t),  operate_sub},
+    {"xor", LOCK_FORM_MEM_IMM, sizeof(uint8_t),  operate_xor},
+    {"xor", LOCK_FORM_MEM_REG, sizeof(uint8_t),  operate_xor},
+};
+static const size_t LOCK_INFO_LIST_SIZE = sizeof(lock_info_list) / sizeof(lock_info_list[0]);
+
+
+static void generate_test_case_lock(FILE *fp, const LockInfo *lock_info, size_t size)
+{
+    static const uintmax_t rhs = 0x05;
+    uintmax_t mask = ((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1;
+    uintmax_t lhs = 0x0123456789abcdef & mask;
+    const char *reg = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, lhs);
+    put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg);
+    switch(lock_info->form)
+    {
+    case LOCK_FORM_MEM:
+        put_line_with_tab(fp, "lock %s %s [rbp-8]    # test target", lock_info->mnemonic, size_spec);
+        break;
+
+    case LOCK_FORM_MEM_IMM:
+        put_line_with_tab(fp, "lock %s %s [rbp-8], 0x%llx    # test target", lock_info->mnemonic, size_spec, rhs);
+        break;
+
+    case LOCK_FORM_MEM_REG:
+    default:
+        put_line_with_tab(fp, "mov %s, 0x%llx", reg, rhs);
+        put_line_with_tab(fp, "lock %s %s [rbp-8], %s    # test target", lock_info->mnemonic, size_spec, reg);
+        break;
+    }
+    put_line_with_tab(fp, "mov %s, %s [rbp-8]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, lock_info->operate(lhs, rhs) & mask);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_all_test_case_lock(FILE *fp)
+{
+    for(size_t k = 0; k < LOCK_INFO_LIST_SIZE; k++)
+    {
+        const LockInfo *lock_info = &lock_info_list[k];
+        for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+        {
+            size_t size = imm_list[j].size;
+            if(size >= lock_info->min_size)
+            {
+                generate_test_case_lock(fp, lock_info, size);
+                put_line(fp, "");
+            }
+        }
+    }
+}
+
+
+void generate_test_lock(void)
+{
+    generate_test("test/test_lock.s", STACK_ALIGNMENT, generate_all_test_case_lock);
+}
@@ -0,0 +1,43 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_string_common.h"
+
+
+static void generate_test_case_lodsb(FILE *fp, const char *prefix, uintmax_t rcx)
+{
+    uintmax_t rax = 0x0123456789abcdef;
+    StringOperationInfo info;
+    StringOperationResult result;
+    initialize_string_operation(&info, &result, prefix, "lodsb", sizeof(uint8_t), rax, rcx);
+
+    size_t count = (prefix != NULL) ? rcx : 1;
+    if(count > 0)
+    {
+        result.rax = (rax & ~(uintmax_t)0xff) | info.source[count - 1];
+    }
+    result.rsi = count;
+    result.rcx = (prefix != NULL) ? 0 : rcx;
+
+    generate_test_case_string(fp, &info, &result);
+}
+
+
+static void generate_all_test_case_lods(FILE *fp)
+{
+    generate_test_case_lodsb(fp, NULL, 3);
+    put_line(fp, "");
+    generate_test_case_lodsb(fp, "rep", 0);
+    put_line(fp, "");
+    generate_test_case_lodsb(fp, "rep", 3);
+    put_line(fp, "");
+    generate_test_case_lodsb(fp, "rep", STRING_BUFFER_SIZE);
+    put_line(fp, "");
+}
+
+
+void generate_test_lods(void)
+{
+    generate_test("test/test_lods.s", STRING_STACK_SIZE, generate_all_test_case_lods);
+}
@@ -0,0 +1,32 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_scan_common.h"
+
+
+static uintmax_t operate_lzcnt(uintmax_t source, size_t size)
+{
+    uintmax_t count = 0;
+    for(size_t index = convert_size_to_bit(size); (index > 0) && (((source >> (index - 1)) & 1) == 0); index--)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+
+static void generate_all_test_case_lzcnt(FILE *fp)
+{
+    static const BitScanOperationTestDataMaker make_test_data_lzcnt = {"lzcnt", true, operate_lzcnt};
+
+    generate_all_test_case_bit_scan(fp, &make_test_data_lzcnt);
+}
+
+
+void generate_test_lzcnt(void)
+{
+    generate_test("test/test_lzcnt.s", STACK_ALIGNMENT, generate_all_test_case_lzcnt);
+}
@@ -0,0 +1,46 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_common.h"
+#include "test_string_common.h"
+
+
+static void generate_test_case_movs(FILE *fp, const char *prefix, const char *mnemonic, size_t size, uintmax_t rcx)
+{
+    StringOperationInfo info;
+    StringOperationResult result;
+    initialize_string_operation(&info, &result, prefix, mnemonic, size, 0, rcx);
+
+    size_t count = (prefix != NULL) ? rcx : 1;
+    memcpy(result.destination, info.source, count * size);
+    result.rsi = count * size;
+    result.rdi = count * size;
+    result.rcx = (prefix != NULL) ? 0 : rcx;
+
+    generate_test_case_string(fp, &info, &result);
+}
+
+
+static void generate_all_test_case_movs(FILE *fp)
+{
+    const char *mnemonic_list[] = {"movsb", "movsw", "movsd", "movsq"};
+    for(size_t i = 0; i < sizeof(mnemonic_list) / sizeof(mnemonic_list[0]); i++)
+    {
+        size_t size = (size_t)1 << i;
+        generate_test_case_movs(fp, NULL, mnemonic_list[i], size, 3);
+        put_line(fp, "");
+        generate_test_case_movs(fp, "rep", mnemonic_list[i], size, 0);
+        put_line(fp, "");
+        generate_test_case_movs(fp, "rep", mnemonic_list[i], size, 3);
+        put_line(fp, "");
+        generate_test_case_movs(fp, "rep", mnemonic_list[i], size, STRING_BUFFER_SIZE / size);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_movs(void)
+{
+    generate_test("test/test_movs.s", STRING_STACK_SIZE, generate_all_test_case_movs);
+}
@@ -0,0 +1,32 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_scan_common.h"
+
+
+static uintmax_t operate_popcnt(uintmax_t source, size_t size)
+{
+    uintmax_t count = 0;
+    for(size_t index = 0; index < convert_size_to_bit(size); index++)
+    {
+        count += (source >> index) & 1;
+    }
+
+    return count;
+}
+
+
+static void generate_all_test_case_popcnt(FILE *fp)
+{
+    static const BitScanOperationTestDataMaker make_test_data_popcnt = {"popcnt", true, operate_popcnt};
+
+    generate_all_test_case_bit_scan(fp, &make_test_data_popcnt);
+}
+
+
+void generate_test_popcnt(void)
+{
+    generate_test("test/test_popcnt.s", STACK_ALIGNMENT, generate_all_test_case_popcnt);
+}
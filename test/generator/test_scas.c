@@ -0,0 +1,80 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_common.h"
+#include "test_string_common.h"
+
+
+static bool is_repne_prefix(const char *prefix)
+{
+    return (strcmp(prefix, "repne") == 0) || (strcmp(prefix, "repnz") == 0);
+}
+
+
+static void generate_test_case_scasb(FILE *fp, const char *prefix, uintmax_t rcx, uint32_t match_mask)
+{
+    uintmax_t rax = 0x0123456789abcd55;
+    StringOperationInfo info;
+    StringOperationResult result;
+    initialize_string_operation(&info, &result, prefix, "scasb", sizeof(uint8_t), rax, rcx);
+    for(size_t i = 0; i < STRING_BUFFER_SIZE; i++)
+    {
+        if((match_mask >> i) & 1)
+        {
+            info.destination[i] = rax & 0xff;
+            result.destination[i] = rax & 0xff;
+        }
+    }
+
+    size_t count = 0;
+    while((prefix == NULL) || (rcx > 0))
+    {
+        result.zf = (info.destination[count] == (rax & 0xff));
+        count++;
+        if(prefix == NULL)
+        {
+            break;
+        }
+        rcx--;
+        if(result.zf == is_repne_prefix(prefix))
+        {
+            break;
+        }
+    }
+    result.rdi = count;
+    result.rcx = rcx;
+
+    generate_test_case_string(fp, &info, &result);
+}
+
+
+static void generate_all_test_case_scas(FILE *fp)
+{
+    generate_test_case_scasb(fp, NULL, 3, 0x00000001);
+    put_line(fp, "");
+    generate_test_case_scasb(fp, NULL, 3, 0x00000000);
+    put_line(fp, "");
+
+    const char *prefix_list[] = {"rep", "repe", "repne", "repnz", "repz"};
+    for(size_t i = 0; i < sizeof(prefix_list) / sizeof(prefix_list[0]); i++)
+    {
+        generate_test_case_scasb(fp, prefix_list[i], 0, 0x00000000);
+        put_line(fp, "");
+        generate_test_case_scasb(fp, prefix_list[i], STRING_BUFFER_SIZE, 0x00000020);
+        put_line(fp, "");
+        generate_test_case_scasb(fp, prefix_list[i], STRING_BUFFER_SIZE, 0x0000001f);
+        put_line(fp, "");
+        generate_test_case_scasb(fp, prefix_list[i], 8, 0x00000000);
+        put_line(fp, "");
+        generate_test_case_scasb(fp, prefix_list[i], 8, 0x000000ff);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_scas(void)
+{
+    generate_test("test/test_scas.s", STRING_STACK_SIZE, generate_all_test_case_scas);
+}
@@ -18,57 +18,123 @@ static const SetInfo set_info_list[] =
     {"seta", 0x01, 0x00, 0x01},
     {"seta", 0x01, 0x01, 0x00},
     {"seta", 0x00, 0x01, 0x00},
+    {"seta", INT64_MIN, 0x01, 0x01},
     {"setae", 0x01, 0x00, 0x01},
     {"setae", 0x01, 0x01, 0x01},
     {"setae", 0x00, 0x01, 0x00},
+    {"setae", INT64_MIN, 0x01, 0x01},
     {"setb", 0x01, 0x00, 0x00},
     {"setb", 0x01, 0x01, 0x00},
     {"setb", 0x00, 0x01, 0x01},
+    {"setb", INT64_MIN, 0x01, 0x00},
     {"setbe", 0x01, 0x00, 0x00},
     {"setbe", 0x01, 0x01, 0x01},
     {"setbe", 0x00, 0x01, 0x01},
+    {"setbe", INT64_MIN, 0x01, 0x00},
+    {"setc", 0x01, 0x00, 0x00},
+    {"setc", 0x01, 0x01, 0x00},
+    {"setc", 0x00, 0x01, 0x01},
+    {"setc", INT64_MIN, 0x01, 0x00},
     {"sete", 0x01, 0x00, 0x00},
     {"sete", 0x01, 0x01, 0x01},
     {"sete", 0x00, 0x01, 0x00},
+    {"sete", INT64_MIN, 0x01, 0x00},
     {"setg", 0x01, 0x00, 0x01},
     {"setg", 0x01, 0x01, 0x00},
     {"setg", 0x00, 0x01, 0x00},
+    {"setg", INT64_MIN, 0x01, 0x00},
     {"setge", 0x01, 0x00, 0x01},
     {"setge", 0x01, 0x01, 0x01},
     {"setge", 0x00, 0x01, 0x00},
+    {"setge", INT64_MIN, 0x01, 0x00},
     {"setl", 0x01, 0x00, 0x00},
     {"setl", 0x01, 0x01, 0x00},
     {"setl", 0x00, 0x01, 0x01},
+    {"setl", INT64_MIN, 0x01, 0x01},
     {"setle", 0x01, 0x00, 0x00},
     {"setle", 0x01, 0x01, 0x01},
     {"setle", 0x00, 0x01, 0x01},
+    {"setle", INT64_MIN, 0x01, 0x01},
     {"setna", 0x01, 0x00, 0x00},
     {"setna", 0x01, 0x01, 0x01},
     {"setna", 0x00, 0x01, 0x01},
+    {"setna", INT64_MIN, 0x01, 0x00},
     {"setnae", 0x01, 0x00, 0x00},
     {"setnae", 0x01, 0x01, 0x00},
     {"setnae", 0x00, 0x01, 0x01},
+    {"setnae", INT64_MIN, 0x01, 0x00},
     {"setnb", 0x01, 0x00, 0x01},
     {"setnb", 0x01, 0x01, 0x01},
     {"setnb", 0x00, 0x01, 0x00},
+    {"setnb", INT64_MIN, 0x01, 0x01},
     {"setnbe", 0x01, 0x00, 0x01},
     {"setnbe", 0x01, 0x01, 0x00},
     {"setnbe", 0x00, 0x01, 0x00},
+    {"setnbe", INT64_MIN, 0x01, 0x01},
+    {"setnc", 0x01, 0x00, 0x01},
+    {"setnc", 0x01, 0x01, 0x01},
+    {"setnc", 0x00, 0x01, 0x00},
+    {"setnc", INT64_MIN, 0x01, 0x01},
     {"setne", 0x01, 0x00, 0x01},
     {"setne", 0x01, 0x01, 0x00},
     {"setne", 0x00, 0x01, 0x01},
+    {"setne", INT64_MIN, 0x01, 0x01},
     {"setng", 0x01, 0x00, 0x00},
     {"setng", 0x01, 0x01, 0x01},
     {"setng", 0x00, 0x01, 0x01},
+    {"setng", INT64_MIN, 0x01, 0x01},
     {"setnge", 0x01, 0x00, 0x00},
     {"setnge", 0x01, 0x01, 0x00},
     {"setnge", 0x00, 0x01, 0x01},
+    {"setnge", INT64_MIN, 0x01, 0x01},
     {"setnl", 0x01, 0x00, 0x01},
     {"setnl", 0x01, 0x01, 0x01},
     {"setnl", 0x00, 0x01, 0x00},
+    {"setnl", INT64_MIN, 0x01, 0x00},
     {"setnle", 0x01, 0x00, 0x01},
     {"setnle", 0x01, 0x01, 0x00},
     {"setnle", 0x00, 0x01, 0x00},
+    {"setnle", INT64_MIN, 0x01, 0x00},
+    {"setno", 0x01, 0x00, 0x01},
+    {"setno", 0x01, 0x01, 0x01},
+    {"setno", 0x00, 0x01, 0x01},
+    {"setno", INT64_MIN, 0x01, 0x00},
+    {"setnp", 0x01, 0x00, 0x01},
+    {"setnp", 0x01, 0x01, 0x00},
+    {"setnp", 0x00, 0x01, 0x00},
+    {"setnp", INT64_MIN, 0x01, 0x00},
+    {"setns", 0x01, 0x00, 0x01},
+    {"setns", 0x01, 0x01, 0x01},
+    {"setns", 0x00, 0x01, 0x00},
+    {"setns", INT64_MIN, 0x01, 0x01},
+    {"setnz", 0x01, 0x00, 0x01},
+    {"setnz", 0x01, 0x01, 0x00},
+    {"setnz", 0x00, 0x01, 0x01},
+    {"setnz", INT64_MIN, 0x01, 0x01},
+    {"seto", 0x01, 0x00, 0x00},
+    {"seto", 0x01, 0x01, 0x00},
+    {"seto", 0x00, 0x01, 0x00},
+    {"seto", INT64_MIN, 0x01, 0x01},
+    {"setp", 0x01, 0x00, 0x00},
+    {"setp", 0x01, 0x01, 0x01},
+    {"setp", 0x00, 0x01, 0x01},
+    {"setp", INT64_MIN, 0x01, 0x01},
+    {"setpe", 0x01, 0x00, 0x00},
+    {"setpe", 0x01, 0x01, 0x01},
+    {"setpe", 0x00, 0x01, 0x01},
+    {"setpe", INT64_MIN, 0x01, 0x01},
+    {"setpo", 0x01, 0x00, 0x01},
+    {"setpo", 0x01, 0x01, 0x00},
+    {"setpo", 0x00, 0x01, 0x00},
+    {"setpo", INT64_MIN, 0x01, 0x00},
+    {"sets", 0x01, 0x00, 0x00},
+    {"sets", 0x01, 0x01, 0x00},
+    {"sets", 0x00, 0x01, 0x01},
+    {"sets", INT64_MIN, 0x01, 0x00},
+    {"setz", 0x01, 0x00, 0x00},
+    {"setz", 0x01, 0x01, 0x01},
+    {"setz", 0x00, 0x01, 0x00},
+    {"setz", INT64_MIN, 0x01, 0x00},
 };
 static const size_t SET_INFO_LIST_SIZE = sizeof(set_info_list) / sizeof(set_info_list[0]);
 
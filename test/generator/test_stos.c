@@ -0,0 +1,49 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_common.h"
+#include "test_string_common.h"
+
+
+static void generate_test_case_stos(FILE *fp, const char *prefix, const char *mnemonic, size_t size, uintmax_t rcx)
+{
+    uint64_t rax = 0x0123456789abcdef;
+    StringOperationInfo info;
+    StringOperationResult result;
+    initialize_string_operation(&info, &result, prefix, mnemonic, size, rax, rcx);
+
+    size_t count = (prefix != NULL) ? rcx : 1;
+    for(size_t i = 0; i < count; i++)
+    {
+        memcpy(&result.destination[i * size], &rax, size);
+    }
+    result.rdi = count * size;
+    result.rcx = (prefix != NULL) ? 0 : rcx;
+
+    generate_test_case_string(fp, &info, &result);
+}
+
+
+static void generate_all_test_case_stos(FILE *fp)
+{
+    const char *mnemonic_list[] = {"stosb", "stosw", "stosd", "stosq"};
+    for(size_t i = 0; i < sizeof(mnemonic_list) / sizeof(mnemonic_list[0]); i++)
+    {
+        size_t size = (size_t)1 << i;
+        generate_test_case_stos(fp, NULL, mnemonic_list[i], size, 3);
+        put_line(fp, "");
+        generate_test_case_stos(fp, "rep", mnemonic_list[i], size, 0);
+        put_line(fp, "");
+        generate_test_case_stos(fp, "rep", mnemonic_list[i], size, 3);
+        put_line(fp, "");
+        generate_test_case_stos(fp, "rep", mnemonic_list[i], size, STRING_BUFFER_SIZE / size);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_stos(void)
+{
+    generate_test("test/test_stos.s", STRING_STACK_SIZE, generate_all_test_case_stos);
+}
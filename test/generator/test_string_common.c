@@ -0,0 +1,102 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_common.h"
+#include "test_string_common.h"
+
+// offsets of buffers and saved registers from rbp
+#define OFFSET_DESTINATION    32
+#define OFFSET_SOURCE         64
+#define OFFSET_RAX            72
+#define OFFSET_RCX            80
+#define OFFSET_RSI            88
+#define OFFSET_RDI            96
+#define OFFSET_ZF             104
+
+
+static void generate_fill_buffer(FILE *fp, size_t offset, const uint8_t *buffer)
+{
+    for(size_t i = 0; i < STRING_BUFFER_SIZE; i += sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, &buffer[i], sizeof(value));
+        put_line_with_tab(fp, "mov rax, 0x%llx", value);
+        put_line_with_tab(fp, "mov qword ptr [rbp-%lu], rax", offset - i);
+    }
+}
+
+
+static void generate_assert_value(FILE *fp, size_t offset, uintmax_t expected)
+{
+    put_line_with_tab(fp, "mov rsi, qword ptr [rbp-%lu]", offset);
+    put_line_with_tab(fp, "mov rdi, 0x%llx", expected);
+    put_line_with_tab(fp, "call assert_equal_uint64");
+}
+
+
+void initialize_string_operation(StringOperationInfo *info, StringOperationResult *result, const char *prefix, const char *mnemonic, size_t size, uintmax_t rax, uintmax_t rcx)
+{
+    info->prefix = prefix;
+    info->mnemonic = mnemonic;
+    info->size = size;
+    for(size_t i = 0; i < STRING_BUFFER_SIZE; i++)
+    {
+        info->source[i] = 0x10 + i;
+        info->destination[i] = 0xa0 + i;
+    }
+    info->rax = rax;
+    info->rcx = rcx;
+
+    // initialize result as if the operation did nothing
+    memcpy(result->destination, info->destination, sizeof(result->destination));
+    result->rsi = 0;
+    result->rdi = 0;
+    result->rax = rax;
+    result->rcx = rcx;
+    result->zf = false;
+}
+
+
+void generate_test_case_string(FILE *fp, const StringOperationInfo *info, const StringOperationResult *result)
+{
+    generate_fill_buffer(fp, OFFSET_SOURCE, info->source);
+    generate_fill_buffer(fp, OFFSET_DESTINATION, info->destination);
+    put_line_with_tab(fp, "lea rsi, byte ptr [rbp-%lu]", OFFSET_SOURCE);
+    put_line_with_tab(fp, "lea rdi, byte ptr [rbp-%lu]", OFFSET_DESTINATION);
+    put_line_with_tab(fp, "mov rax, 0x%llx", info->rax);
+    put_line_with_tab(fp, "mov rcx, 0x%llx", info->rcx);
+    put_line_with_tab(fp, "mov r8, 1");
+    put_line_with_tab(fp, "cmp r8, 0");
+    if(info->prefix != NULL)
+    {
+        put_line_with_tab(fp, "%s %s    # test target", info->prefix, info->mnemonic);
+    }
+    else
+    {
+        put_line_with_tab(fp, "%s    # test target", info->mnemonic);
+    }
+
+    // save the state before it is destroyed by assertions
+    put_line_with_tab(fp, "setz byte ptr [rbp-%lu]", OFFSET_ZF);
+    put_line_with_tab(fp, "mov qword ptr [rbp-%lu], rax", OFFSET_RAX);
+    put_line_with_tab(fp, "mov qword ptr [rbp-%lu], rcx", OFFSET_RCX);
+    put_line_with_tab(fp, "sub rsi, rbp");
+    put_line_with_tab(fp, "mov qword ptr [rbp-%lu], rsi", OFFSET_RSI);
+    put_line_with_tab(fp, "sub rdi, rbp");
+    put_line_with_tab(fp, "mov qword ptr [rbp-%lu], rdi", OFFSET_RDI);
+
+    for(size_t i = 0; i < STRING_BUFFER_SIZE; i += sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, &result->destination[i], sizeof(value));
+        generate_assert_value(fp, OFFSET_DESTINATION - i, value);
+    }
+    generate_assert_value(fp, OFFSET_RAX, result->rax);
+    generate_assert_value(fp, OFFSET_RCX, result->rcx);
+    generate_assert_value(fp, OFFSET_RSI, result->rsi - OFFSET_SOURCE);
+    generate_assert_value(fp, OFFSET_RDI, result->rdi - OFFSET_DESTINATION);
+    put_line_with_tab(fp, "mov sil, byte ptr [rbp-%lu]", OFFSET_ZF);
+    put_line_with_tab(fp, "mov dil, 0x%x", result->zf ? 1 : 0);
+    put_line_with_tab(fp, "call assert_equal_uint8");
+}
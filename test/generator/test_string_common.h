@@ -0,0 +1,39 @@
+#ifndef TEST_STRING_COMMON_H
+#define TEST_STRING_COMMON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define STRING_BUFFER_SIZE    32
+#define STRING_STACK_SIZE     112
+
+typedef struct StringOperationInfo StringOperationInfo;
+typedef struct StringOperationResult StringOperationResult;
+
+struct StringOperationInfo
+{
+    const char *prefix;                      // instruction prefix, or NULL if not prefixed
+    const char *mnemonic;                    // mnemonic
+    size_t size;                             // size of element
+    uint8_t source[STRING_BUFFER_SIZE];      // buffer pointed by rsi
+    uint8_t destination[STRING_BUFFER_SIZE]; // buffer pointed by rdi
+    uintmax_t rax;                           // initial value of rax
+    uintmax_t rcx;                           // initial value of rcx
+};
+
+struct StringOperationResult
+{
+    uint8_t destination[STRING_BUFFER_SIZE]; // buffer pointed by rdi
+    size_t rsi;                              // number of bytes rsi is advanced
+    size_t rdi;                              // number of bytes rdi is advanced
+    uintmax_t rax;                           // value of rax
+    uintmax_t rcx;                           // value of rcx
+    bool zf;                                 // zero flag
+};
+
+void initialize_string_operation(StringOperationInfo *info, StringOperationResult *result, const char *prefix, const char *mnemonic, size_t size, uintmax_t rax, uintmax_t rcx);
+void generate_test_case_string(FILE *fp, const StringOperationInfo *info, const StringOperationResult *result);
+
+#endif /* !TEST_STRING_COMMON_H */
@@ -0,0 +1,32 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+#include "test_bit_scan_common.h"
+
+
+static uintmax_t operate_tzcnt(uintmax_t source, size_t size)
+{
+    uintmax_t count = 0;
+    for(size_t index = 0; (index < convert_size_to_bit(size)) && (((source >> index) & 1) == 0); index++)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+
+static void generate_all_test_case_tzcnt(FILE *fp)
+{
+    static const BitScanOperationTestDataMaker make_test_data_tzcnt = {"tzcnt", true, operate_tzcnt};
+
+    generate_all_test_case_bit_scan(fp, &make_test_data_tzcnt);
+}
+
+
+void generate_test_tzcnt(void)
+{
+    generate_test("test/test_tzcnt.s", STACK_ALIGNMENT, generate_all_test_case_tzcnt);
+}
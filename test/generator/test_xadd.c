@@ -0,0 +1,88 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+
+static uintmax_t get_mask(size_t size)
+{
+    return ((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1;
+}
+
+
+static void generate_test_case_xadd_reg_reg(FILE *fp, const RegisterInfo *reg1_info, const RegisterInfo *reg2_info, uintmax_t lhs, uintmax_t rhs)
+{
+    size_t size = reg1_info->size;
+    size_t index_list[] = {reg1_info->index, reg2_info->index};
+    const char *reg1 = reg1_info->name;
+    const char *reg2 = reg2_info->name;
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    const char *work_reg = generate_save_register(fp, index_list, sizeof(index_list) / sizeof(index_list[0]));
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg1, lhs);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg2, rhs);
+    put_line_with_tab(fp, "xadd %s, %s    # test target", reg1, reg2);
+    put_line_with_tab(fp, "mov %s [%s-16], %s", size_spec, work_reg, reg2);
+    put_line_with_tab(fp, "mov %s, %s", arg2, reg1);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, (lhs + rhs) & get_mask(size));
+    generate_restore_register(fp, work_reg);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov %s, %s [rbp-16]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, lhs);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_test_case_xadd_mem_reg(FILE *fp, size_t size, uintmax_t lhs, uintmax_t rhs, bool lock)
+{
+    const char *reg = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, lhs);
+    put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, rhs);
+    put_line_with_tab(fp, "%sxadd %s [rbp-8], %s    # test target", lock ? "lock " : "", size_spec, reg);
+    put_line_with_tab(fp, "mov %s [rbp-16], %s", size_spec, reg);
+    put_line_with_tab(fp, "mov %s, %s [rbp-8]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, (lhs + rhs) & get_mask(size));
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov %s, %s [rbp-16]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, lhs);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_all_test_case_xadd(FILE *fp)
+{
+    // xadd reg, reg
+    for(size_t i = 0; i < REG_LIST_SIZE; i++)
+    {
+        const RegisterInfo *reg1_info = &reg_list[i];
+        const RegisterInfo *reg2_info = &reg_list[(i % 16 == 15) ? (i - 15) : (i + 1)];
+        size_t size = reg1_info->size;
+        generate_test_case_xadd_reg_reg(fp, reg1_info, reg2_info, 0x0123456789abcdef & get_mask(size), 0x11);
+        put_line(fp, "");
+    }
+
+    // xadd mem, reg
+    for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+    {
+        size_t size = imm_list[j].size;
+        uintmax_t lhs = 0x0123456789abcdef & get_mask(size);
+        generate_test_case_xadd_mem_reg(fp, size, lhs, 0x22, false);
+        put_line(fp, "");
+        generate_test_case_xadd_mem_reg(fp, size, lhs, get_mask(size), true);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_xadd(void)
+{
+    generate_test("test/test_xadd.s", STACK_ALIGNMENT, generate_all_test_case_xadd);
+}
@@ -0,0 +1,103 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "test_common.h"
+
+
+static uintmax_t get_value1(size_t size)
+{
+    return 0x0123456789abcdef & (((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1);
+}
+
+
+static uintmax_t get_value2(size_t size)
+{
+    return 0x7edcba9876543210 & (((size < sizeof(uintmax_t)) ? ((uintmax_t)1 << convert_size_to_bit(size)) : 0) - 1);
+}
+
+
+static void generate_test_case_xchg_reg_reg(FILE *fp, const RegisterInfo *reg1_info, const RegisterInfo *reg2_info)
+{
+    size_t size = reg1_info->size;
+    size_t index_list[] = {reg1_info->index, reg2_info->index};
+    const char *reg1 = reg1_info->name;
+    const char *reg2 = reg2_info->name;
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    const char *work_reg = generate_save_register(fp, index_list, sizeof(index_list) / sizeof(index_list[0]));
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg1, get_value1(size));
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg2, get_value2(size));
+    put_line_with_tab(fp, "xchg %s, %s    # test target", reg1, reg2);
+    put_line_with_tab(fp, "mov %s [%s-16], %s", size_spec, work_reg, reg2);
+    put_line_with_tab(fp, "mov %s, %s", arg2, reg1);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, get_value2(size));
+    generate_restore_register(fp, work_reg);
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov %s, %s [rbp-16]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, get_value1(size));
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_test_case_xchg_mem(FILE *fp, size_t size, bool memory_first, bool lock)
+{
+    const char *reg = get_register_by_index_and_size(REGISTER_INDEX_R8D, size);
+    const char *arg1 = get_1st_argument_register(size);
+    const char *arg2 = get_2nd_argument_register(size);
+    const char *size_spec = get_size_specifier(size);
+
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, get_value1(size));
+    put_line_with_tab(fp, "mov %s [rbp-8], %s", size_spec, reg);
+    put_line_with_tab(fp, "mov %s, 0x%llx", reg, get_value2(size));
+    if(memory_first)
+    {
+        put_line_with_tab(fp, "%sxchg %s [rbp-8], %s    # test target", lock ? "lock " : "", size_spec, reg);
+    }
+    else
+    {
+        put_line_with_tab(fp, "%sxchg %s, %s [rbp-8]    # test target", lock ? "lock " : "", reg, size_spec);
+    }
+    put_line_with_tab(fp, "mov %s [rbp-16], %s", size_spec, reg);
+    put_line_with_tab(fp, "mov %s, %s [rbp-8]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, get_value2(size));
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+    put_line_with_tab(fp, "mov %s, %s [rbp-16]", arg2, size_spec);
+    put_line_with_tab(fp, "mov %s, 0x%llx", arg1, get_value1(size));
+    put_line_with_tab(fp, "call assert_equal_uint%ld", convert_size_to_bit(size));
+}
+
+
+static void generate_all_test_case_xchg(FILE *fp)
+{
+    // xchg reg, reg
+    for(size_t i = 0; i < REG_LIST_SIZE; i++)
+    {
+        const RegisterInfo *reg1_info = &reg_list[i];
+        const RegisterInfo *reg2_info = &reg_list[(i % 16 == 15) ? (i - 15) : (i + 1)];
+        generate_test_case_xchg_reg_reg(fp, reg1_info, reg2_info);
+        put_line(fp, "");
+    }
+
+    // xchg mem, reg and xchg reg, mem
+    for(size_t j = 0; j < IMM_LIST_SIZE; j++)
+    {
+        size_t size = imm_list[j].size;
+        generate_test_case_xchg_mem(fp, size, true, false);
+        put_line(fp, "");
+        generate_test_case_xchg_mem(fp, size, false, false);
+        put_line(fp, "");
+        generate_test_case_xchg_mem(fp, size, true, true);
+        put_line(fp, "");
+        generate_test_case_xchg_mem(fp, size, false, true);
+        put_line(fp, "");
+    }
+}
+
+
+void generate_test_xchg(void)
+{
+    generate_test("test/test_xchg.s", STACK_ALIGNMENT, generate_all_test_case_xchg);
+}
@@ -0,0 +1,9 @@
+.intel_syntax noprefix
+.text
+func:
+    ret
+main:
+    call func
+    ret
+.global func
+    nop
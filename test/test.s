@@ -1,4 +1,6 @@
 	.intel_syntax noprefix
+	.file "test.s"
+	.file 1 "test.s"
 
 	.data
 test_data_uint8:
@@ -35,21 +37,38 @@ test_bss_uint64:
 	.text
 # main function
 	.globl main
+	.type main, @function
 main:
+	.cfi_startproc
+	.loc 1 44 1
+	sub rsp, 8
+	.cfi_adjust_cfa_offset 8
+	.loc 1 47 1 prologue_end
 	call test_external_text
 	call test_internal_data
 	call test_external_data
 	call test_internal_bss
 	call test_internal_string_literal
+	call test_named_section
+	call test_thread_local_storage
+	call test_indirect_function
 
+	.loc 1 57 1 is_stmt 0 discriminator 1
 	mov rax, 0
+	.loc 1 59 1 is_stmt 1 epilogue_begin
+	add rsp, 8
+	.cfi_def_cfa_offset 8
 	ret
+	.cfi_endproc
+	.size main, .-main
 
 
 # test access to external text section
 	.global test_external_text
+	.protected test_external_text
 test_external_text:
 	call test_external_function1
+	call test_external_function1@PLT
 
 	mov rax, 0
 	ret
@@ -162,6 +181,11 @@ test_external_data:
 	mov rdi, 63
 	call assert_external_data_uint64
 
+	mov rax, qword ptr [rip+test_external_data_uint64@GOTPCREL]
+	mov rsi, qword ptr [rax]
+	mov rdi, 63
+	call assert_equal_uint64@PLT
+
 	mov rax, 0
 	ret
 
@@ -194,6 +218,172 @@ test_internal_string_literal:
 	mov rax, 0
 	ret
 
+# test access to thread-local storage
+test_thread_local_storage:
+	mov rax, qword ptr fs:0
+	mov rsi, qword ptr [rax+test_tdata_uint64@TPOFF]
+	mov rdi, 0x1234
+	call assert_equal_uint64
+
+	mov rax, qword ptr [rip+test_tdata_uint64@GOTTPOFF]
+	mov rsi, qword ptr fs:[rax]
+	mov rdi, 0x1234
+	call assert_equal_uint64
+
+	mov qword ptr fs:[test_tbss_uint64@TPOFF], 0x5678
+	mov rsi, qword ptr fs:[test_tbss_uint64@TPOFF]
+	mov rdi, 0x5678
+	call assert_equal_uint64
+
+	mov rax, 0
+	ret
+
+# test calls to an indirect function, which is bound to the variant selected by its resolver
+test_indirect_function:
+	mov rdi, 0xf0f0
+	call test_popcount
+	mov rsi, rax
+	mov rdi, 8
+	call assert_equal_uint64
+
+	mov rdi, 0xf0f0
+	call test_popcount_generic
+	mov rsi, rax
+	mov rdi, 8
+	call assert_equal_uint64
+
+	mov rax, 0
+	ret
+
+	.type test_popcount, @gnu_indirect_function
+test_popcount:
+	lea rax, qword ptr [rip+test_popcount_popcnt]
+	ret
+
+	.arch generic64
+test_popcount_generic:
+	mov rax, 0
+test_popcount_generic_loop:
+	cmp rdi, 0
+	je test_popcount_generic_end
+	mov rcx, rdi
+	and rcx, 1
+	add rax, rcx
+	shr rdi, 1
+	jmp test_popcount_generic_loop
+test_popcount_generic_end:
+	ret
+
+	.arch .popcnt
+test_popcount_popcnt:
+	popcnt rax, rdi
+	ret
+	.arch default
+
+# test access to named sections
+test_named_section:
+	mov esi, dword ptr [rip+test_rodata_uint32]
+	mov edi, 0x12345678
+	call assert_equal_uint32
+
+	mov rsi, qword ptr [rip+test_data_rel_ro_pointer_to_rodata_uint32]
+	lea rdi, dword ptr [rip+test_rodata_uint32]
+	call assert_equal_uint64
+
+	mov rsi, qword ptr [rip+test_nobits_uint64]
+	mov rdi, 0
+	call assert_equal_uint64
+
+	call test_text_unlikely
+	mov rsi, rax
+	mov rdi, 0x9abc
+	call assert_equal_uint64
+
+	call test_comdat_function
+	mov rsi, rax
+	mov rdi, 0xdef0
+	call assert_equal_uint64
+
+	mov rsi, qword ptr [rip+test_nobits_initialized_uint64]
+	mov rdi, 0x5678
+	call assert_equal_uint64
+
+	mov rsi, qword ptr [rip+test_rodata_cst8_uint64]
+	mov rdi, 0x123456789abcdef0
+	call assert_equal_uint64
+
+	mov rsi, qword ptr [rip+test_rodata_cst8_duplicated_uint64]
+	mov rdi, 0x123456789abcdef0
+	call assert_equal_uint64
+
+	mov rsi, qword ptr [rip+test_rodata_cst8_uint64_array+8]
+	mov rdi, 0x0fedcba987654321
+	call assert_equal_uint64
+
+	mov rax, 0
+	ret
+
+	.section .rodata.cst8,"aM",@progbits,8
+	.align 8
+test_rodata_cst8_uint64:
+	.quad 0x123456789abcdef0
+test_rodata_cst8_duplicated_uint64:
+	.quad 0x123456789abcdef0
+test_rodata_cst8_uint64_array:
+	.quad 0x123456789abcdef0
+	.quad 0x0fedcba987654321
+
+	.section .rodata
+	.type test_rodata_uint32, @object
+test_rodata_uint32:
+	.long 0x12345678
+	.size test_rodata_uint32, 4
+
+	.pushsection .data.rel.ro,"aw",@progbits
+	.align 8
+test_data_rel_ro_pointer_to_rodata_uint32:
+	.quad test_rodata_uint32
+	.popsection
+
+	.section .init_array
+	.align 8
+	.quad test_constructor
+
+	.section .text.unlikely,"ax",@progbits
+test_constructor:
+	mov qword ptr [rip+test_nobits_initialized_uint64], 0x5678
+	ret
+
+	.internal test_text_unlikely
+test_text_unlikely:
+	mov rax, 0x9abc
+	ret
+
+	.section .text.test_comdat_function,"axG",@progbits,test_comdat_function,comdat
+	.globl test_comdat_function
+	.hidden test_comdat_function
+test_comdat_function:
+	mov rax, 0xdef0
+	ret
+
+	.section .test_nobits,"aw",@nobits
+	.align 8
+test_nobits_uint64:
+	.zero 8
+test_nobits_initialized_uint64:
+	.zero 8
+
+	.section .tdata,"awT",@progbits
+	.align 8
+	.type test_tdata_uint64, @object
+test_tdata_uint64:
+	.quad 0x1234
+
+	.section .tbss,"awT",@nobits
+	.align 8
+test_tbss_uint64:
+	.zero 8
+
 .data
 test_data_uint8_array:
 	.byte 0x81
@@ -13,10 +13,11 @@ test()
     # set arguments
     source=$1
     expected=$2
+    options=${@:3}
 
     # assemble the source code
     object=${source%.*}_${POSTFIX}.o
-    $ASM $source -c -o $object
+    $ASM $source $options -c -o $object
 
     # link the object file with the standard library
     external='test_utility.c external_text.c external_data.c'
@@ -35,19 +36,117 @@ test()
 }
 
 
+# function to execute a test case of analysis of basic blocks
+test_analysis()
+{
+    # set arguments
+    source=$1
+    expected=$2
+
+    # analyze the source code and compare the report with the expected one
+    echo $source...
+    if $ASM $source --analyze | diff $expected -; then
+        echo passed
+    else
+        echo report of analysis differs from $expected
+    fi
+}
+
+
+# function to execute a test case searching the object file dumped by readelf for a pattern
+test_readelf()
+{
+    # set arguments
+    source=$1
+    pattern=$2
+    readelf_options=$3
+    options=${@:4}
+
+    # assemble the source code and search the dump of the object file
+    object=${source%.*}_${POSTFIX}.o
+    $ASM $source $options -c -o $object
+    echo $source $readelf_options...
+    if readelf $readelf_options $object | grep -q "$pattern"; then
+        echo passed
+    else
+        echo "'$pattern'" is not found in readelf $readelf_options
+    fi
+}
+
+
+# function to execute a test case linking the object file with ld for an emulation if ld supports it
+test_link()
+{
+    # set arguments
+    source=$1
+    emulation=$2
+    options=${@:3}
+
+    # assemble the source code and link the object file without the standard library
+    object=${source%.*}_${POSTFIX}.o
+    binary=${source%.*}_${POSTFIX}_bin
+    $ASM $source $options -c -o $object
+    echo $binary -m $emulation...
+    if ! ld -V | grep -q "^ *$emulation$"; then
+        echo skipped since ld does not support $emulation
+    elif ld -m $emulation $object -o $binary; then
+        echo passed
+    else
+        echo failed to link $object
+    fi
+}
+
+
+# function to execute a test case expecting an error
+test_error()
+{
+    # set arguments
+    source=$1
+    expected=$2
+    options=${@:3}
+
+    # assemble the source code and compare the error message with the expected one
+    object=${source%.*}_${POSTFIX}.o
+    echo $source...
+    if ! $ASM $source $options -c -o $object 2>&1 >/dev/null | diff $expected -; then
+        echo error message differs from $expected
+    elif [ -e $object ]; then
+        echo $object is made despite the error
+    else
+        echo passed
+    fi
+}
+
+
 # execute tests
 test test.s 0
 test test_add.s 0
 test test_and.s 0
+test test_bmi.s 0
+test test_bsf.s 0
+test test_bsr.s 0
+test test_bt.s 0
+test test_btc.s 0
+test test_btr.s 0
+test test_bts.s 0
 test test_call.s 0
+test test_cmov.s 0
 test test_cmp.s 0
+test test_cmps.s 0
+test test_cmpxchg.s 0
 test test_convert.s 0
+test test_encoding.s 0
+test test_fence.s 0
 test test_idiv.s 0
 test test_imul.s 0
 test test_jcc.s 0
 test test_jmp.s 0
 test test_lea.s 0
+test test_lock.s 0
+test test_lods.s 0
+test test_lzcnt.s 0
 test test_mov.s 0
+test test_movs.s 0
 test test_movsx.s 0
 test test_movzx.s 0
 test test_neg.s 0
@@ -55,14 +154,111 @@ test test_nop.s 0
 test test_not.s 0
 test test_or.s 0
 test test_pop.s 0
+test test_popcnt.s 0
 test test_push.s 0
 test test_sal.s 0
 test test_sar.s 0
+test test_scas.s 0
 test test_set.s 0
 test test_shl.s 0
 test test_shr.s 0
+test test_stos.s 0
 test test_sub.s 0
+test test_tzcnt.s 0
+test test_xadd.s 0
+test test_xchg.s 0
 test test_xor.s 0
 
+# execute tests with alignment of branches
+test test.s 0 -malign-branch-boundary=32 -malign-branch=jcc+fused+jmp+call+ret+indirect
+test test_call.s 0 -malign-branch-boundary=32 -malign-branch=call+indirect
+test test_jcc.s 0 -malign-branch-boundary=32 -malign-branch=jcc+fused+jmp
+test test_jmp.s 0 -mbranches-within-32B-boundaries
+
+# execute tests in one-pass mode
+test test.s 0 --one-pass
+test test_call.s 0 --one-pass
+test test_jcc.s 0 --one-pass -malign-branch-boundary=32 -malign-branch=jcc+fused+jmp
+test test_jmp.s 0 --one-pass
+
+# execute tests with sections dedicated to global labels
+test test.s 0 --function-sections --data-sections
+test test_call.s 0 --function-sections
+test test_jmp.s 0 --one-pass --function-sections --data-sections
+
+# execute tests with ISA level given explicitly
+test test.s 0 --isa-level-needed=baseline
+
+# execute tests of line number information in .debug_line section
+test_readelf test.s "DWARF Version: *5$" --debug-dump=rawline
+test_readelf test.s "^test.s  *44  *0  *x$" --debug-dump=decodedline
+test_readelf test.s "^test.s  *47  *0x4  *x$" --debug-dump=decodedline
+test_readelf test.s "^test.s  *57  *0x2c *$" --debug-dump=decodedline
+test_readelf test.s "^test.s  *59  *0x33  *x$" --debug-dump=decodedline
+test_readelf test.s "Set prologue_end to true" --debug-dump=rawline
+test_readelf test.s "Set is_stmt to 0" --debug-dump=rawline
+test_readelf test.s "Set epilogue_begin to true" --debug-dump=rawline
+
+# execute tests of line number information in one-pass mode
+test_readelf test.s "DWARF Version: *5$" --debug-dump=rawline --one-pass
+test_readelf test.s "^test.s  *44  *0  *x$" --debug-dump=decodedline --one-pass
+test_readelf test.s "^test.s  *47  *0x4  *x$" --debug-dump=decodedline --one-pass
+test_readelf test.s "^test.s  *57  *0x2c *$" --debug-dump=decodedline --one-pass
+test_readelf test.s "^test.s  *59  *0x33  *x$" --debug-dump=decodedline --one-pass
+test_readelf test.s "Set prologue_end to true" --debug-dump=rawline --one-pass
+test_readelf test.s "Set is_stmt to 0" --debug-dump=rawline --one-pass
+test_readelf test.s "Set epilogue_begin to true" --debug-dump=rawline --one-pass
+
+# execute tests of call frame information in .eh_frame section
+test_readelf test.s "CIE$" -wf
+test_readelf test.s "DW_CFA_def_cfa: r7 (rsp) ofs 8$" -wf
+test_readelf test.s "FDE cie=00000000 pc=0000000000000000\.\.0000000000000038$" -wf
+test_readelf test.s "DW_CFA_advance_loc: 4 to 0000000000000004$" -wf
+test_readelf test.s "DW_CFA_def_cfa_offset: 16$" -wf
+test_readelf test.s "DW_CFA_advance_loc: 51 to 0000000000000037$" -wf
+test_readelf test.s "DW_CFA_def_cfa_offset: 8$" -wf
+
+# execute tests of attributes of sections
+test_readelf test.s "\.init_array  *INIT_ARRAY  *[0-9a-f]*  *[0-9a-f]*  *[0-9a-f]*  *08  WA " -SW
+test_readelf test.s "\.rodata\.cst8  *PROGBITS  *[0-9a-f]*  *[0-9a-f]*  *[0-9a-f]*  *08  *AM " -SW
+
+# execute tests of types and sizes of symbols
+test_readelf test.s " 56 FUNC  *GLOBAL DEFAULT  *[0-9]* main$" -sW
+test_readelf test.s " 4 OBJECT  *LOCAL  DEFAULT  *[0-9]* test_rodata_uint32$" -sW
+test_readelf test.s " 0 IFUNC  *LOCAL  DEFAULT  *[0-9]* test_popcount$" -sW
+test_readelf test.s " 0 TLS  *LOCAL  DEFAULT  *[0-9]* test_tdata_uint64$" -sW
+test_readelf test.s " 56 FUNC  *GLOBAL DEFAULT  *[0-9]* main$" -sW --one-pass
+test_readelf test.s " 4 OBJECT  *LOCAL  DEFAULT  *[0-9]* test_rodata_uint32$" -sW --one-pass
+
+# execute tests of visibility of symbols
+test_readelf test.s "NOTYPE  *GLOBAL PROTECTED  *[0-9]* test_external_text$" -sW
+test_readelf test.s "NOTYPE  *GLOBAL HIDDEN  *[0-9]* test_comdat_function$" -sW
+test_readelf test.s "NOTYPE  *LOCAL  INTERNAL  *[0-9]* test_text_unlikely$" -sW
+test_readelf visibility.s "NOTYPE  *GLOBAL HIDDEN  *UND test_hidden_undefined$" -sW
+test_readelf visibility.s "NOTYPE  *GLOBAL INTERNAL  *UND test_internal_undefined$" -sW
+test_readelf visibility.s "NOTYPE  *GLOBAL PROTECTED  *UND test_protected_undefined$" -sW
+test_readelf visibility.s "NOTYPE  *GLOBAL PROTECTED  *UND test_protected_referred$" -sW
+test_readelf visibility.s "NOTYPE  *GLOBAL HIDDEN  *UND test_hidden_undefined$" -sW --one-pass
+test_readelf visibility.s "NOTYPE  *GLOBAL INTERNAL  *UND test_internal_undefined$" -sW --one-pass
+test_readelf visibility.s "NOTYPE  *GLOBAL PROTECTED  *UND test_protected_undefined$" -sW --one-pass
+
+# execute tests of ISA levels recorded in .note.gnu.property section
+test_readelf test.s "x86 ISA needed: x86-64-baseline$" -n
+test_readelf test.s "x86 ISA used: x86-64-baseline, x86-64-v2$" -n
+test_readelf test_popcnt.s "x86 ISA needed: x86-64-baseline, x86-64-v2$" -n
+
+# execute tests of x32 ABI
+test_readelf x32.s "Class: *ELF32$" -h --x32
+test_readelf x32.s "R_X86_64_PC32 .* \.data - 4$" -r --x32
+test_readelf x32.s "R_X86_64_32 .* \.data + 4$" -r --x32
+test_readelf x32.s "\.init_array  *INIT_ARRAY  *[0-9a-f]*  *[0-9a-f]*  *[0-9a-f]*  *04  WA " -SW --x32
+test_link x32.s elf32_x86_64 --x32
+
+# execute tests of analysis
+test_analysis analysis.s analysis.txt
+
+# execute tests of errors
+test_error late_global.s late_global.txt --one-pass
+
 # restore the directory
 popd > /dev/null
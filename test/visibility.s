@@ -0,0 +1,10 @@
+	.intel_syntax noprefix
+
+	.hidden test_hidden_undefined
+	.internal test_internal_undefined
+	.protected test_protected_undefined, test_protected_referred
+
+	.text
+test_visibility:
+	call test_protected_referred
+	ret
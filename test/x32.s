@@ -0,0 +1,23 @@
+	.intel_syntax noprefix
+	.file "x32.s"
+
+	.text
+	.globl _start
+	.type _start, @function
+_start:
+	mov eax, dword ptr [rip+test_data_pointer_to_data_uint32]
+	mov eax, dword ptr [rax]
+	ret
+	.size _start, .-_start
+
+	.section .init_array
+	.align 4
+	.long _start
+
+	.data
+	.align 4
+test_data_pointer_to_data_uint32:
+	.long test_data_uint32
+test_data_uint32:
+	.long 0x12345678
+	.align 4
@@ -0,0 +1,503 @@
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LINE_SIZE_MAX       256
+#define FIELD_SIZE_MAX      32
+#define OPERAND_NUMBER_MAX  2
+#define ENTRY_NUMBER_MAX    1024
+
+typedef struct ConditionCodeInfo ConditionCodeInfo;
+typedef struct OperandPatternInfo OperandPatternInfo;
+typedef struct SpecEntry SpecEntry;
+
+// structure for mapping from suffix of mnemonic to condition code
+struct ConditionCodeInfo
+{
+    const char *suffix; // suffix of mnemonic
+    uint8_t code;       // condition code
+};
+
+// structure for mapping from operand pattern in the specification to its name in the table
+struct OperandPatternInfo
+{
+    const char *pattern; // operand pattern in the specification
+    const char *name;    // name of operand pattern in the table
+};
+
+// structure for an entry of the specification
+struct SpecEntry
+{
+    char mnemonic[FIELD_SIZE_MAX];                          // name of mnemonic
+    size_t operand_number;                                  // number of operands
+    const OperandPatternInfo *operands[OPERAND_NUMBER_MAX]; // operand patterns
+    char prefixes[FIELD_SIZE_MAX];                          // prefixes in the table
+    uint32_t opecode;                                       // opecode
+    int opecode_digits;                                     // number of hexadecimal digits of opecode
+    char modrm[FIELD_SIZE_MAX];                             // role of ModR/M byte in the table
+    size_t imm_size;                                        // size of immediate
+    size_t order;                                           // order of appearance in the specification
+};
+
+static void report_error(size_t line_number, const char *message, const char *field);
+static const OperandPatternInfo *parse_operand_pattern(size_t line_number, const char *pattern);
+static void parse_operands(size_t line_number, const char *operands, SpecEntry *entry);
+static void parse_prefixes(size_t line_number, const char *prefixes, SpecEntry *entry);
+static void parse_modrm(size_t line_number, const char *modrm, SpecEntry *entry);
+static void parse_immediate(size_t line_number, const char *immediate, SpecEntry *entry);
+static void add_entry(const SpecEntry *entry);
+static void parse_line(size_t line_number, const char *line);
+static void read_spec(const char *spec_file);
+static int compare_entries(const void *lhs, const void *rhs);
+static void output_encoder_table(const char *spec_file, FILE *fp);
+static void output_test_table(const char *spec_file, FILE *fp);
+
+static const ConditionCodeInfo condition_code_info_list[] =
+{
+    {"a",   0x07},
+    {"ae",  0x03},
+    {"b",   0x02},
+    {"be",  0x06},
+    {"c",   0x02},
+    {"e",   0x04},
+    {"g",   0x0f},
+    {"ge",  0x0d},
+    {"l",   0x0c},
+    {"le",  0x0e},
+    {"na",  0x06},
+    {"nae", 0x02},
+    {"nb",  0x03},
+    {"nbe", 0x07},
+    {"nc",  0x03},
+    {"ne",  0x05},
+    {"ng",  0x0e},
+    {"nge", 0x0c},
+    {"nl",  0x0d},
+    {"nle", 0x0f},
+    {"no",  0x01},
+    {"np",  0x0b},
+    {"ns",  0x09},
+    {"nz",  0x05},
+    {"o",   0x00},
+    {"p",   0x0a},
+    {"pe",  0x0a},
+    {"po",  0x0b},
+    {"s",   0x08},
+    {"z",   0x04},
+};
+static const size_t CONDITION_CODE_INFO_LIST_SIZE = sizeof(condition_code_info_list) / sizeof(condition_code_info_list[0]);
+
+static const OperandPatternInfo operand_pattern_info_list[] =
+{
+    {"imm8",  "OPP_IMM8"},
+    {"imm16", "OPP_IMM16"},
+    {"imm32", "OPP_IMM32"},
+    {"m8",    "OPP_M8"},
+    {"m16",   "OPP_M16"},
+    {"m32",   "OPP_M32"},
+    {"m64",   "OPP_M64"},
+    {"m128",  "OPP_M128"},
+    {"r8",    "OPP_R8"},
+    {"r16",   "OPP_R16"},
+    {"r32",   "OPP_R32"},
+    {"r64",   "OPP_R64"},
+    {"r/m8",  "OPP_RM8"},
+    {"r/m16", "OPP_RM16"},
+    {"r/m32", "OPP_RM32"},
+    {"r/m64", "OPP_RM64"},
+};
+static const size_t OPERAND_PATTERN_INFO_LIST_SIZE = sizeof(operand_pattern_info_list) / sizeof(operand_pattern_info_list[0]);
+
+static const char CONDITION_CODE_PLACEHOLDER[] = "<cc>";
+
+static SpecEntry entry_list[ENTRY_NUMBER_MAX]; // list of entries of the specification
+static size_t entry_number = 0;                // number of entries of the specification
+
+
+/*
+report an error in the specification
+*/
+static void report_error(size_t line_number, const char *message, const char *field)
+{
+    fprintf(stderr, "line %zu: %s '%s'\n", line_number, message, field);
+    exit(EXIT_FAILURE);
+}
+
+
+/*
+parse an operand pattern
+*/
+static const OperandPatternInfo *parse_operand_pattern(size_t line_number, const char *pattern)
+{
+    for(size_t i = 0; i < OPERAND_PATTERN_INFO_LIST_SIZE; i++)
+    {
+        if(strcmp(pattern, operand_pattern_info_list[i].pattern) == 0)
+        {
+            return &operand_pattern_info_list[i];
+        }
+    }
+
+    report_error(line_number, "unknown operand pattern", pattern);
+    return NULL;
+}
+
+
+/*
+parse operands field
+*/
+static void parse_operands(size_t line_number, const char *operands, SpecEntry *entry)
+{
+    entry->operand_number = 0;
+    if(strcmp(operands, "-") == 0)
+    {
+        return;
+    }
+
+    char buffer[FIELD_SIZE_MAX];
+    strcpy(buffer, operands);
+    for(char *pattern = strtok(buffer, ","); pattern != NULL; pattern = strtok(NULL, ","))
+    {
+        if(entry->operand_number >= OPERAND_NUMBER_MAX)
+        {
+            report_error(line_number, "too many operands", operands);
+        }
+        entry->operands[entry->operand_number] = parse_operand_pattern(line_number, pattern);
+        entry->operand_number++;
+    }
+}
+
+
+/*
+parse prefixes field
+*/
+static void parse_prefixes(size_t line_number, const char *prefixes, SpecEntry *entry)
+{
+    strcpy(entry->prefixes, "EP_NONE");
+    if(strcmp(prefixes, "-") == 0)
+    {
+        return;
+    }
+
+    char buffer[FIELD_SIZE_MAX];
+    strcpy(buffer, prefixes);
+    entry->prefixes[0] = '\0';
+    for(char *prefix = strtok(buffer, "+"); prefix != NULL; prefix = strtok(NULL, "+"))
+    {
+        const char *name = NULL;
+        if(strcmp(prefix, "66") == 0)
+        {
+            name = "EP_66";
+        }
+        else if(strcmp(prefix, "f2") == 0)
+        {
+            name = "EP_F2";
+        }
+        else if(strcmp(prefix, "f3") == 0)
+        {
+            name = "EP_F3";
+        }
+        else if(strcmp(prefix, "rex.w") == 0)
+        {
+            name = "EP_REX_W";
+        }
+        else
+        {
+            report_error(line_number, "unknown prefix", prefix);
+        }
+
+        if(entry->prefixes[0] != '\0')
+        {
+            strcat(entry->prefixes, " | ");
+        }
+        strcat(entry->prefixes, name);
+    }
+}
+
+
+/*
+parse modrm field
+*/
+static void parse_modrm(size_t line_number, const char *modrm, SpecEntry *entry)
+{
+    if(strcmp(modrm, "-") == 0)
+    {
+        strcpy(entry->modrm, "MR_NONE");
+    }
+    else if(strcmp(modrm, "r") == 0)
+    {
+        strcpy(entry->modrm, "MR_REG");
+    }
+    else if((strlen(modrm) == 2) && (modrm[0] == '/') && ('0' <= modrm[1]) && (modrm[1] <= '7'))
+    {
+        sprintf(entry->modrm, "MR_%c", modrm[1]);
+    }
+    else
+    {
+        report_error(line_number, "invalid role of ModR/M byte", modrm);
+    }
+}
+
+
+/*
+parse immediate field
+*/
+static void parse_immediate(size_t line_number, const char *immediate, SpecEntry *entry)
+{
+    if(strcmp(immediate, "-") == 0)
+    {
+        entry->imm_size = 0;
+    }
+    else if(strcmp(immediate, "ib") == 0)
+    {
+        entry->imm_size = sizeof(uint8_t);
+    }
+    else if(strcmp(immediate, "iw") == 0)
+    {
+        entry->imm_size = sizeof(uint16_t);
+    }
+    else if(strcmp(immediate, "id") == 0)
+    {
+        entry->imm_size = sizeof(uint32_t);
+    }
+    else
+    {
+        report_error(line_number, "invalid size of immediate", immediate);
+    }
+}
+
+
+/*
+add an entry, expanding the placeholder of condition codes
+*/
+static void add_entry(const SpecEntry *entry)
+{
+    const char *placeholder = strstr(entry->mnemonic, CONDITION_CODE_PLACEHOLDER);
+    size_t expansion_number = (placeholder == NULL) ? 1 : CONDITION_CODE_INFO_LIST_SIZE;
+    if(entry_number + expansion_number > ENTRY_NUMBER_MAX)
+    {
+        fprintf(stderr, "too many entries in the specification\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(size_t i = 0; i < expansion_number; i++)
+    {
+        SpecEntry *new_entry = &entry_list[entry_number];
+        *new_entry = *entry;
+        new_entry->order = entry_number;
+        if(placeholder != NULL)
+        {
+            const ConditionCodeInfo *info = &condition_code_info_list[i];
+            size_t prefix_length = placeholder - entry->mnemonic;
+            sprintf(&new_entry->mnemonic[prefix_length], "%s%s", info->suffix, placeholder + strlen(CONDITION_CODE_PLACEHOLDER));
+            new_entry->opecode += info->code;
+        }
+        entry_number++;
+    }
+}
+
+
+/*
+parse a line of the specification
+*/
+static void parse_line(size_t line_number, const char *line)
+{
+    char fields[6][FIELD_SIZE_MAX];
+    char format[LINE_SIZE_MAX];
+    sprintf(format, "%%%ds %%%ds %%%ds %%%ds %%%ds %%%ds", FIELD_SIZE_MAX - 1, FIELD_SIZE_MAX - 1, FIELD_SIZE_MAX - 1, FIELD_SIZE_MAX - 1, FIELD_SIZE_MAX - 1, FIELD_SIZE_MAX - 1);
+    int field_number = sscanf(line, format, fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]);
+    if((field_number <= 0) || (fields[0][0] == '#'))
+    {
+        // skip empty lines and comments
+        return;
+    }
+    else if(field_number != 6)
+    {
+        report_error(line_number, "wrong number of fields in", line);
+    }
+
+    SpecEntry entry;
+    strcpy(entry.mnemonic, fields[0]);
+    parse_operands(line_number, fields[1], &entry);
+    parse_prefixes(line_number, fields[2], &entry);
+    char *end;
+    entry.opecode = strtoul(fields[3], &end, 16);
+    entry.opecode_digits = strlen(fields[3]);
+    if((*end != '\0') || (entry.opecode > 0xffffff))
+    {
+        report_error(line_number, "invalid opecode", fields[3]);
+    }
+    parse_modrm(line_number, fields[4], &entry);
+    parse_immediate(line_number, fields[5], &entry);
+    add_entry(&entry);
+}
+
+
+/*
+read the specification
+*/
+static void read_spec(const char *spec_file)
+{
+    FILE *fp = fopen(spec_file, "r");
+    if(fp == NULL)
+    {
+        fprintf(stderr, "cannot open '%s'\n", spec_file);
+        exit(EXIT_FAILURE);
+    }
+
+    char line[LINE_SIZE_MAX];
+    size_t line_number = 1;
+    while(fgets(line, sizeof(line), fp) != NULL)
+    {
+        parse_line(line_number, line);
+        line_number++;
+    }
+
+    fclose(fp);
+
+    // sort entries by mnemonic so that encodings of a mnemonic are contiguous
+    qsort(entry_list, entry_number, sizeof(entry_list[0]), compare_entries);
+}
+
+
+/*
+compare entries by mnemonic and order of appearance
+*/
+static int compare_entries(const void *lhs, const void *rhs)
+{
+    const SpecEntry *lhs_entry = lhs;
+    const SpecEntry *rhs_entry = rhs;
+    int result = strcmp(lhs_entry->mnemonic, rhs_entry->mnemonic);
+    if(result == 0)
+    {
+        result = (lhs_entry->order > rhs_entry->order) - (lhs_entry->order < rhs_entry->order);
+    }
+
+    return result;
+}
+
+
+/*
+output table for encoder
+*/
+static void output_encoder_table(const char *spec_file, FILE *fp)
+{
+    fprintf(fp, "// generated from %s, do not edit\n\n", spec_file);
+
+    fprintf(fp, "static const InstructionEncoding instruction_encoding_list[] =\n{\n");
+    for(size_t i = 0; i < entry_number; i++)
+    {
+        const SpecEntry *entry = &entry_list[i];
+        char mnemonic[FIELD_SIZE_MAX];
+        for(size_t j = 0; j <= strlen(entry->mnemonic); j++)
+        {
+            mnemonic[j] = toupper(entry->mnemonic[j]);
+        }
+        fprintf(fp, "    {MN_%s, %zu, {%s, %s}, %s, 0x%0*x, %s, %zu},\n",
+            mnemonic,
+            entry->operand_number,
+            (entry->operand_number > 0) ? entry->operands[0]->name : "OPP_NONE",
+            (entry->operand_number > 1) ? entry->operands[1]->name : "OPP_NONE",
+            entry->prefixes,
+            entry->opecode_digits,
+            entry->opecode,
+            entry->modrm,
+            entry->imm_size
+        );
+    }
+    fprintf(fp, "};\n\n");
+
+    fprintf(fp, "static const InstructionEncodingRange instruction_encoding_range_list[] =\n{\n");
+    for(size_t i = 0; i < entry_number;)
+    {
+        size_t start = i;
+        while((i < entry_number) && (strcmp(entry_list[i].mnemonic, entry_list[start].mnemonic) == 0))
+        {
+            i++;
+        }
+
+        char mnemonic[FIELD_SIZE_MAX];
+        for(size_t j = 0; j <= strlen(entry_list[start].mnemonic); j++)
+        {
+            mnemonic[j] = toupper(entry_list[start].mnemonic[j]);
+        }
+        fprintf(fp, "    [MN_%s] = {%zu, %zu},\n", mnemonic, start, i - start);
+    }
+    fprintf(fp, "};\n");
+}
+
+
+/*
+output table for test generator
+*/
+static void output_test_table(const char *spec_file, FILE *fp)
+{
+    fprintf(fp, "// generated from %s, do not edit\n\n", spec_file);
+
+    fprintf(fp, "static const InstructionSpec instruction_spec_list[] =\n{\n");
+    for(size_t i = 0; i < entry_number; i++)
+    {
+        const SpecEntry *entry = &entry_list[i];
+        fprintf(fp, "    {\"%s\", %zu, {\"%s\", \"%s\"}, %s, 0x%0*x, %s, %zu},\n",
+            entry->mnemonic,
+            entry->operand_number,
+            (entry->operand_number > 0) ? entry->operands[0]->pattern : "",
+            (entry->operand_number > 1) ? entry->operands[1]->pattern : "",
+            entry->prefixes,
+            entry->opecode_digits,
+            entry->opecode,
+            entry->modrm,
+            entry->imm_size
+        );
+    }
+    fprintf(fp, "};\n");
+}
+
+
+/*
+main function of generator of instruction tables
+
+usage: generate_instruction_table (encoder | test) <spec-file> <output-file>
+*/
+int main(int argc, char *argv[])
+{
+    if(argc != 4)
+    {
+        fprintf(stderr, "usage: %s (encoder | test) <spec-file> <output-file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *mode = argv[1];
+    const char *spec_file = argv[2];
+    const char *output_file = argv[3];
+    read_spec(spec_file);
+
+    FILE *fp = fopen(output_file, "w");
+    if(fp == NULL)
+    {
+        fprintf(stderr, "cannot open '%s'\n", output_file);
+        return EXIT_FAILURE;
+    }
+
+    if(strcmp(mode, "encoder") == 0)
+    {
+        output_encoder_table(spec_file, fp);
+    }
+    else if(strcmp(mode, "test") == 0)
+    {
+        output_test_table(spec_file, fp);
+    }
+    else
+    {
+        fprintf(stderr, "unknown mode '%s'\n", mode);
+        fclose(fp);
+        remove(output_file);
+        return EXIT_FAILURE;
+    }
+
+    fclose(fp);
+
+    return 0;
+}